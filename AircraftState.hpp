@@ -4,22 +4,41 @@
 
 #include "OeBase.hpp"
 
-struct AircraftState {
+// T 为标量类型: double (默认) 或 float (大规模机队, SIMD 通道数加倍、内存带宽减半)
+template<class T>
+struct AircraftStateT {
     // --- 姿态 ---
-    double roll  = 0.0; // 滚转角 (phi), 弧度
-    double pitch = 0.0; // 俯仰角 (tht), 弧度
-    double yaw   = 0.0; // 偏航角 (psi), 弧度
+    T roll  = T(0); // 滚转角 (phi), 弧度
+    T pitch = T(0); // 俯仰角 (tht), 弧度
+    T yaw   = T(0); // 偏航角 (psi), 弧度
 
     // --- 位置 ---
     // 使用简单的笛卡尔坐标系，而非经纬度
-    oe_base::Vec3d position; // 位置 (x, y, z), 米
+    oe_base::Vec3<T> position; // 位置 (x, y, z), 米
 
     // --- 速度 ---
-    oe_base::Vec3d velocity;      // 世界坐标系速度 (北-东-地), m/s
-    oe_base::Vec3d bodyVelocity;  // 机体坐标系速度 (u,v,w), m/s
+    oe_base::Vec3<T> velocity;      // 世界坐标系速度 (北-东-地), m/s
+    oe_base::Vec3<T> bodyVelocity;  // 机体坐标系速度 (u,v,w), m/s
 
     // --- 角速度 ---
-    oe_base::Vec3d angularVelocity; // 机体坐标系角速度 (p,q,r), rad/s
+    oe_base::Vec3<T> angularVelocity; // 机体坐标系角速度 (p,q,r), rad/s
 };
 
-#endif // AIRCRAFT_STATE_HPP
\ No newline at end of file
+typedef AircraftStateT<double> AircraftState;
+typedef AircraftStateT<float> AircraftStateF;
+
+// 精度转换
+template<class To, class From>
+inline AircraftStateT<To> stateCast(const AircraftStateT<From>& s) {
+    AircraftStateT<To> out;
+    out.roll = To(s.roll);
+    out.pitch = To(s.pitch);
+    out.yaw = To(s.yaw);
+    out.position = oe_base::Vec3<To>(s.position);
+    out.velocity = oe_base::Vec3<To>(s.velocity);
+    out.bodyVelocity = oe_base::Vec3<To>(s.bodyVelocity);
+    out.angularVelocity = oe_base::Vec3<To>(s.angularVelocity);
+    return out;
+}
+
+#endif // AIRCRAFT_STATE_HPP
@@ -0,0 +1,142 @@
+// AirframeProfile.cpp
+#include "AirframeProfile.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+using namespace laero_airframe;
+
+namespace {
+
+const char* const FIELD_NAMES[FIELD_COUNT] = {
+    "phiTau", "thtTau", "psiTau", "headingTau", "altitudeTau", "velocityTau",
+    "hDps", "maxBankD", "aMps", "maxPitchD", "vNps"
+};
+
+std::string trim(const std::string& s) {
+    const size_t first = s.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return std::string();
+    const size_t last = s.find_last_not_of(" \t\r");
+    return s.substr(first, last - first + 1);
+}
+
+bool fail(std::string& error, size_t lineNumber, const std::string& msg) {
+    error = "line " + std::to_string(lineNumber) + ": " + msg;
+    return false;
+}
+
+} // namespace
+
+namespace laero_airframe {
+
+const char* fieldName(size_t f) {
+    return f < FIELD_COUNT ? FIELD_NAMES[f] : "";
+}
+
+double& field(AirframeProfile& p, size_t f) {
+    switch (f) {
+    case FIELD_PHI_TAU: return p.control.phiTau;
+    case FIELD_THT_TAU: return p.control.thtTau;
+    case FIELD_PSI_TAU: return p.control.psiTau;
+    case FIELD_HEADING_TAU: return p.control.headingTau;
+    case FIELD_ALTITUDE_TAU: return p.control.altitudeTau;
+    case FIELD_VELOCITY_TAU: return p.control.velocityTau;
+    case FIELD_H_DPS: return p.limits.hDps;
+    case FIELD_MAX_BANK_D: return p.limits.maxBankD;
+    case FIELD_A_MPS: return p.limits.aMps;
+    case FIELD_MAX_PITCH_D: return p.limits.maxPitchD;
+    case FIELD_V_NPS:
+    default: return p.limits.vNps;
+    }
+}
+
+double field(const AirframeProfile& p, size_t f) {
+    return field(const_cast<AirframeProfile&>(p), f);
+}
+
+} // namespace laero_airframe
+
+bool readAirframeProfiles(std::istream& in, std::vector<AirframeProfile>& out, std::string& error) {
+    out.clear();
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        // --- 节: [机型名] ---
+        if (line.front() == '[') {
+            if (line.back() != ']') return fail(error, lineNumber, "unterminated section header");
+            AirframeProfile profile;
+            profile.name = trim(line.substr(1, line.size() - 2));
+            if (profile.name.empty()) return fail(error, lineNumber, "empty airframe name");
+            if (findAirframe(out, profile.name) != nullptr) return fail(error, lineNumber, "duplicate airframe " + profile.name);
+            out.push_back(profile);
+            continue;
+        }
+
+        // --- 键 = 值 ---
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos) return fail(error, lineNumber, "expected key = value");
+        if (out.empty()) return fail(error, lineNumber, "value outside of an [airframe] section");
+        const std::string key = trim(line.substr(0, eq));
+        const std::string text = trim(line.substr(eq + 1));
+
+        size_t f = 0;
+        while (f < FIELD_COUNT && key != FIELD_NAMES[f]) ++f;
+        if (f == FIELD_COUNT) return fail(error, lineNumber, "unknown key " + key);
+
+        char* end = nullptr;
+        const double value = std::strtod(text.c_str(), &end);
+        if (text.empty() || *end != '\0') return fail(error, lineNumber, "invalid number " + text);
+        if (!(value > 0.0)) return fail(error, lineNumber, key + " must be positive");
+        field(out.back(), f) = value;
+    }
+    return true;
+}
+
+bool loadAirframeProfiles(const std::string& path, std::vector<AirframeProfile>& out, std::string& error) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        error = "could not open " + path;
+        return false;
+    }
+    if (!readAirframeProfiles(in, out, error)) {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+void writeAirframeProfiles(std::ostream& out, const std::vector<AirframeProfile>& profiles) {
+    char line[128];
+    for (size_t k = 0; k < profiles.size(); ++k) {
+        if (k > 0) out << "\n";
+        out << "[" << profiles[k].name << "]\n";
+        for (size_t f = 0; f < FIELD_COUNT; ++f) {
+            // 17位有效数字: 读回后逐位相同
+            std::snprintf(line, sizeof(line), "%s = %.17g\n", FIELD_NAMES[f], field(profiles[k], f));
+            out << line;
+        }
+    }
+}
+
+const AirframeProfile* findAirframe(const std::vector<AirframeProfile>& profiles, const std::string& name) {
+    for (const AirframeProfile& p : profiles) {
+        if (p.name == name) return &p;
+    }
+    return nullptr;
+}
+
+void storeAirframe(std::vector<AirframeProfile>& profiles, const AirframeProfile& profile) {
+    for (AirframeProfile& p : profiles) {
+        if (p.name == profile.name) {
+            p = profile;
+            return;
+        }
+    }
+    profiles.push_back(profile);
+}
@@ -0,0 +1,60 @@
+// AirframeProfile.hpp
+#ifndef AIRFRAME_PROFILE_HPP
+#define AIRFRAME_PROFILE_HPP
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "LaeroControlParams.hpp"
+
+// 机型参数: LaeroModel 的控制律时间常数 + 指令性能参数
+// StandaloneLaeroModel 构造时载入 (见 StandaloneLaeroModel(const AirframeProfile&)), AutoTuner 输出调好的机型。
+//
+// 文本文件格式 (每个机型一节, '#' 之后为注释, 缺省的键取默认值):
+//   [fighter]
+//   phiTau = 0.8
+//   maxBankD = 60
+//   ...
+struct AirframeProfile {
+    std::string name = "default";
+    LaeroControlParams control;
+    LaeroCommandLimits limits;
+};
+
+// 按编号访问机型的数值参数 (文件中的键名即字段名)
+namespace laero_airframe {
+
+enum Field {
+    FIELD_PHI_TAU = 0,
+    FIELD_THT_TAU,
+    FIELD_PSI_TAU,
+    FIELD_HEADING_TAU,
+    FIELD_ALTITUDE_TAU,
+    FIELD_VELOCITY_TAU,
+    FIELD_H_DPS,
+    FIELD_MAX_BANK_D,
+    FIELD_A_MPS,
+    FIELD_MAX_PITCH_D,
+    FIELD_V_NPS,
+    FIELD_COUNT
+};
+
+const char* fieldName(size_t field);
+double& field(AirframeProfile& profile, size_t field);
+double field(const AirframeProfile& profile, size_t field);
+
+} // namespace laero_airframe
+
+// --- 文件读写; 失败时返回 false, error 为原因 (含行号) ---
+bool readAirframeProfiles(std::istream& in, std::vector<AirframeProfile>& out, std::string& error);
+bool loadAirframeProfiles(const std::string& path, std::vector<AirframeProfile>& out, std::string& error);
+void writeAirframeProfiles(std::ostream& out, const std::vector<AirframeProfile>& profiles);
+
+// 按名称查找 (没有时返回 nullptr)
+const AirframeProfile* findAirframe(const std::vector<AirframeProfile>& profiles, const std::string& name);
+// 替换同名机型, 没有时追加到末尾
+void storeAirframe(std::vector<AirframeProfile>& profiles, const AirframeProfile& profile);
+
+#endif // AIRFRAME_PROFILE_HPP
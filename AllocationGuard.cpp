@@ -0,0 +1,105 @@
+// AllocationGuard.cpp
+// 替换全局 operator new/delete (链接本文件即生效)
+#include "AllocationGuard.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> g_allocCount{0};
+std::atomic<uint64_t> g_allocBytes{0};
+std::atomic<uint64_t> g_trapped{0};
+std::atomic<int> g_trapMode{laero_alloc::ALLOC_TRAP_ABORT};
+
+// 当前线程的禁止分配嵌套深度 (平凡类型, operator new 中访问不会触发 TLS 初始化)
+thread_local unsigned t_noAllocDepth = 0;
+
+void onAllocate(std::size_t size) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (t_noAllocDepth == 0) return;
+
+    g_trapped.fetch_add(1, std::memory_order_relaxed);
+    if (g_trapMode.load(std::memory_order_relaxed) == laero_alloc::ALLOC_TRAP_ABORT) {
+        // 不能再分配内存: 格式化到栈上的缓冲区, 直接写 stderr (无缓冲)
+        char message[128];
+        std::snprintf(message, sizeof(message),
+                      "AllocationGuard: heap allocation of %zu bytes inside a no-allocation scope\n", size);
+        std::fputs(message, stderr);
+        std::abort();
+    }
+}
+
+void* allocate(std::size_t size) {
+    onAllocate(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    onAllocate(size);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    // aligned_alloc 要求大小是对齐的整数倍
+    const std::size_t rounded = (size + align - 1) / align * align;
+    if (void* p = std::aligned_alloc(align, rounded ? rounded : align)) return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+// ==============================================================
+// 全局分配函数
+// 替换函数不内联, 否则 GCC 会把 new/free 配对误报为 -Wmismatched-new-delete
+// nothrow 版本的默认实现调用这里的函数, 不需要替换
+// ==============================================================
+__attribute__((noinline)) void* operator new(std::size_t size) { return allocate(size); }
+__attribute__((noinline)) void* operator new[](std::size_t size) { return allocate(size); }
+__attribute__((noinline)) void* operator new(std::size_t size, std::align_val_t a) { return allocateAligned(size, a); }
+__attribute__((noinline)) void* operator new[](std::size_t size, std::align_val_t a) { return allocateAligned(size, a); }
+
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete[](void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace laero_alloc {
+
+void setTrapMode(TrapMode mode) {
+    g_trapMode.store(mode, std::memory_order_relaxed);
+}
+
+TrapMode trapMode() {
+    return static_cast<TrapMode>(g_trapMode.load(std::memory_order_relaxed));
+}
+
+uint64_t allocationCount() {
+    return g_allocCount.load(std::memory_order_relaxed);
+}
+
+uint64_t allocatedBytes() {
+    return g_allocBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t trappedCount() {
+    return g_trapped.load(std::memory_order_relaxed);
+}
+
+void enterNoAllocation() {
+    ++t_noAllocDepth;
+}
+
+void leaveNoAllocation() {
+    --t_noAllocDepth;
+}
+
+bool inNoAllocation() {
+    return t_noAllocDepth > 0;
+}
+
+} // namespace laero_alloc
@@ -0,0 +1,61 @@
+// AllocationGuard.hpp
+#ifndef ALLOCATION_GUARD_HPP
+#define ALLOCATION_GUARD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// 堆分配计数与步进循环内的分配陷阱 (调试用)
+//
+// 链接 AllocationGuard.cpp 即替换全局 operator new/delete: 统计所有线程的分配次数和字节数,
+// 并在 NoAllocationScope 作用域内 (按线程) 拦截分配。不链接时这里的函数都不存在。
+//
+// 定义 LAERO_TRAP_ALLOCATIONS 编译时, LAERO_NO_ALLOC_SCOPE() 在作用域内禁止堆分配,
+// 否则展开为空语句。模型库中的禁止分配区间即稳态步进循环:
+//   TrackingLoop::step 与 runTrackingScenario 的每一步 (含 sink: 写日志、发布、统计)
+//   RealTimeRunner 的每一步
+//   FleetScheduler::stepFrame 与各线程执行的任务块
+// 场景的轨迹、机队状态和日志缓冲区都应在进入循环前分配好 (见 ScenarioArena.hpp)。
+namespace laero_alloc {
+
+// 禁止分配区间内发生分配时的处理
+enum TrapMode {
+    ALLOC_TRAP_ABORT = 0,   // 向 stderr 输出分配大小后 abort (在调试器中停在分配处), 默认
+    ALLOC_TRAP_RECORD       // 只计数, 运行结束后用 trappedCount() 检查
+};
+
+void setTrapMode(TrapMode mode);
+TrapMode trapMode();
+
+// --- 统计 (所有线程, 自程序启动) ---
+uint64_t allocationCount();
+uint64_t allocatedBytes();
+// 禁止分配区间内发生的分配次数
+uint64_t trappedCount();
+
+// --- 禁止分配区间 (只对当前线程生效, 可以嵌套) ---
+void enterNoAllocation();
+void leaveNoAllocation();
+bool inNoAllocation();
+
+class NoAllocationScope {
+public:
+    NoAllocationScope() { enterNoAllocation(); }
+    ~NoAllocationScope() { leaveNoAllocation(); }
+
+    NoAllocationScope(const NoAllocationScope&) = delete;
+    NoAllocationScope& operator=(const NoAllocationScope&) = delete;
+};
+
+} // namespace laero_alloc
+
+#ifdef LAERO_TRAP_ALLOCATIONS
+#define LAERO_ALLOC_CONCAT_INNER(a, b) a##b
+#define LAERO_ALLOC_CONCAT(a, b) LAERO_ALLOC_CONCAT_INNER(a, b)
+#define LAERO_NO_ALLOC_SCOPE() \
+    const laero_alloc::NoAllocationScope LAERO_ALLOC_CONCAT(laeroNoAllocScope_, __LINE__)
+#else
+#define LAERO_NO_ALLOC_SCOPE() ((void)0)
+#endif
+
+#endif // ALLOCATION_GUARD_HPP
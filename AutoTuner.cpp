@@ -0,0 +1,204 @@
+// AutoTuner.cpp
+#include "AutoTuner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include "FleetScheduler.hpp"
+
+using namespace laero_airframe;
+
+namespace {
+
+SweepCase sweepCaseFor(const AirframeProfile& p) {
+    SweepCase c;
+    c.maxBankD = p.limits.maxBankD;
+    c.hDps = p.limits.hDps;
+    c.maxPitchD = p.limits.maxPitchD;
+    c.aMps = p.limits.aMps;
+    c.vNps = p.limits.vNps;
+    c.control = p.control;
+    return c;
+}
+
+// 反射到 [0,1]: 越过边界的部分折回 (周期2的三角波)
+double reflectUnit(double x) {
+    double t = std::fabs(std::fmod(x, 2.0));
+    if (t > 1.0) t = 2.0 - t;
+    return t;
+}
+
+} // namespace
+
+TuneSpec::TuneSpec() {
+    range[FIELD_PHI_TAU] = SweepRange(0.2, 5.0);
+    range[FIELD_THT_TAU] = SweepRange(0.2, 5.0);
+    range[FIELD_HEADING_TAU] = SweepRange(0.2, 5.0);
+    range[FIELD_ALTITUDE_TAU] = SweepRange(0.5, 10.0);
+    range[FIELD_VELOCITY_TAU] = SweepRange(0.2, 5.0);
+    range[FIELD_MAX_BANK_D] = SweepRange(15.0, 60.0);
+    range[FIELD_MAX_PITCH_D] = SweepRange(5.0, 30.0);
+    range[FIELD_V_NPS] = SweepRange(1.0, 15.0);
+}
+
+double trackingCost(const TrackingStats& stats, const TuneObjective& objective) {
+    return objective.distWeight * stats.dist.rms() + objective.altWeight * stats.alt.rms()
+         + objective.hdgWeight * stats.hdg.rms() + objective.velWeight * stats.vel.rms();
+}
+
+void evaluateAirframes(const std::vector<AirframeProfile>& candidates, const std::vector<TrajectorySpan>& trajectories,
+                       const TuneObjective& objective, FleetScheduler& scheduler, std::vector<double>& costs, double dt) {
+    const size_t trajectoryCount = trajectories.size();
+    const size_t runs = candidates.size() * trajectoryCount;
+    std::vector<double> runCosts(runs, 0.0);
+
+    // 每项一整段仿真
+    scheduler.parallelFor(runs, 1, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            const SweepResult result = runSweepCase(trajectories[r % trajectoryCount],
+                                                    sweepCaseFor(candidates[r / trajectoryCount]), dt);
+            runCosts[r] = trackingCost(result.stats, objective);
+        }
+    });
+
+    // 按固定顺序求平均, 结果与线程数无关
+    costs.assign(candidates.size(), 0.0);
+    for (size_t r = 0; r < runs; ++r) costs[r / trajectoryCount] += runCosts[r];
+    for (double& c : costs) c /= static_cast<double>(std::max<size_t>(trajectoryCount, 1));
+}
+
+TuneResult tuneAirframe(const std::vector<TrajectorySpan>& trajectories, const TuneSpec& spec, FleetScheduler& scheduler,
+                        const std::function<void(const TuneGeneration&)>& progress) {
+    TuneResult result;
+    result.best = spec.start;
+
+    // --- 参与整定的参数 ---
+    std::vector<size_t> dims;
+    for (size_t f = 0; f < FIELD_COUNT; ++f) {
+        if (spec.range[f].max > spec.range[f].min) dims.push_back(f);
+    }
+    const size_t n = dims.size();
+
+    std::vector<AirframeProfile> batch(1, spec.start);
+    std::vector<double> costs;
+    if (n == 0 || trajectories.empty() || spec.maxGenerations == 0) {
+        evaluateAirframes(batch, trajectories, spec.objective, scheduler, costs, spec.dt);
+        result.startCost = result.bestCost = costs[0];
+        result.evaluations = 1;
+        return result;
+    }
+
+    // --- 策略参数 (Hansen 的默认值; 可分离版本的协方差学习率乘以 (n+2)/3) ---
+    const double dn = static_cast<double>(n);
+    const size_t lambda = spec.populationSize > 0 ? std::max<size_t>(spec.populationSize, 2)
+                                                  : 4 + static_cast<size_t>(std::floor(3.0 * std::log(dn)));
+    const size_t mu = lambda / 2;
+    std::vector<double> weights(mu);
+    for (size_t i = 0; i < mu; ++i) weights[i] = std::log(mu + 0.5) - std::log(i + 1.0);
+    const double weightSum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    double weightSq = 0.0;
+    for (double& w : weights) {
+        w /= weightSum;
+        weightSq += w * w;
+    }
+    const double mueff = 1.0 / weightSq;
+
+    const double cs = (mueff + 2.0) / (dn + mueff + 5.0);
+    const double ds = 1.0 + 2.0 * std::max(0.0, std::sqrt((mueff - 1.0) / (dn + 1.0)) - 1.0) + cs;
+    const double cc = (4.0 + mueff / dn) / (dn + 4.0 + 2.0 * mueff / dn);
+    const double c1 = std::min(1.0, (dn + 2.0) / 3.0 * 2.0 / ((dn + 1.3) * (dn + 1.3) + mueff));
+    const double cmu = std::min(1.0 - c1, (dn + 2.0) / 3.0 * 2.0 * (mueff - 2.0 + 1.0 / mueff) / ((dn + 2.0) * (dn + 2.0) + mueff));
+    const double chiN = std::sqrt(dn) * (1.0 - 1.0 / (4.0 * dn) + 1.0 / (21.0 * dn * dn));
+
+    // --- 状态 (归一化坐标) ---
+    std::vector<double> mean(n), diagC(n, 1.0), diagD(n, 1.0), ps(n, 0.0), pc(n, 0.0), oldMean(n);
+    for (size_t j = 0; j < n; ++j) {
+        const SweepRange& r = spec.range[dims[j]];
+        mean[j] = std::min(1.0, std::max(0.0, (field(spec.start, dims[j]) - r.min) / (r.max - r.min)));
+    }
+    double sigma = spec.initialStep;
+
+    std::mt19937_64 rng(spec.seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::vector<std::vector<double>> x(lambda, std::vector<double>(n));
+    std::vector<size_t> order(lambda);
+    result.bestCost = 0.0;
+
+    for (unsigned gen = 0; gen < spec.maxGenerations; ++gen) {
+        // --- 采样 (越界反射) 并组成一批; 第一代附带起点 ---
+        batch.assign(lambda, spec.start);
+        for (size_t k = 0; k < lambda; ++k) {
+            for (size_t j = 0; j < n; ++j) {
+                x[k][j] = reflectUnit(mean[j] + sigma * diagD[j] * normal(rng));
+                const SweepRange& r = spec.range[dims[j]];
+                field(batch[k], dims[j]) = r.min + x[k][j] * (r.max - r.min);
+            }
+        }
+        if (gen == 0) batch.push_back(spec.start);
+        evaluateAirframes(batch, trajectories, spec.objective, scheduler, costs, spec.dt);
+        result.evaluations += batch.size();
+
+        if (gen == 0) {
+            result.startCost = result.bestCost = costs[lambda];
+        }
+
+        for (size_t k = 0; k < lambda; ++k) order[k] = k;
+        std::stable_sort(order.begin(), order.end(), [&costs](size_t a, size_t b) { return costs[a] < costs[b]; });
+        if (costs[order[0]] < result.bestCost) {
+            result.bestCost = costs[order[0]];
+            result.best = batch[order[0]];
+        }
+
+        // --- 均值 ---
+        oldMean = mean;
+        for (size_t j = 0; j < n; ++j) {
+            double m = 0.0;
+            for (size_t i = 0; i < mu; ++i) m += weights[i] * x[order[i]][j];
+            mean[j] = m;
+        }
+
+        // --- 进化路径 ---
+        double psNorm = 0.0;
+        for (size_t j = 0; j < n; ++j) {
+            const double yw = (mean[j] - oldMean[j]) / sigma;
+            ps[j] = (1.0 - cs) * ps[j] + std::sqrt(cs * (2.0 - cs) * mueff) * yw / diagD[j];
+            psNorm += ps[j] * ps[j];
+        }
+        psNorm = std::sqrt(psNorm);
+        const double psDecay = 1.0 - std::pow(1.0 - cs, 2.0 * (gen + 1));
+        const double hsig = (psNorm / std::sqrt(psDecay) < (1.4 + 2.0 / (dn + 1.0)) * chiN) ? 1.0 : 0.0;
+
+        // --- 对角协方差 ---
+        double maxD = 0.0;
+        for (size_t j = 0; j < n; ++j) {
+            const double yw = (mean[j] - oldMean[j]) / sigma;
+            pc[j] = (1.0 - cc) * pc[j] + hsig * std::sqrt(cc * (2.0 - cc) * mueff) * yw;
+            double rankMu = 0.0;
+            for (size_t i = 0; i < mu; ++i) {
+                const double y = (x[order[i]][j] - oldMean[j]) / sigma;
+                rankMu += weights[i] * y * y;
+            }
+            diagC[j] = (1.0 - c1 - cmu) * diagC[j]
+                     + c1 * (pc[j] * pc[j] + (1.0 - hsig) * cc * (2.0 - cc) * diagC[j])
+                     + cmu * rankMu;
+            diagD[j] = std::sqrt(diagC[j]);
+            maxD = std::max(maxD, diagD[j]);
+        }
+
+        // --- 步长 (归一化坐标中不超过整个区间) ---
+        sigma *= std::exp((cs / ds) * (psNorm / chiN - 1.0));
+        sigma = std::min(sigma, 1.0 / maxD);
+
+        TuneGeneration g;
+        g.generation = gen;
+        g.bestCost = costs[order[0]];
+        g.meanCost = std::accumulate(costs.begin(), costs.begin() + lambda, 0.0) / static_cast<double>(lambda);
+        g.bestSoFarCost = result.bestCost;
+        g.sigma = sigma * maxD;
+        result.history.push_back(g);
+        if (progress) progress(g);
+
+        if (g.sigma < spec.tolerance) break;
+    }
+    return result;
+}
@@ -0,0 +1,80 @@
+// AutoTuner.hpp
+#ifndef AUTO_TUNER_HPP
+#define AUTO_TUNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "AirframeProfile.hpp"
+#include "SweepRunner.hpp"
+#include "TrackingStats.hpp"
+#include "Trajectory.hpp"
+
+class FleetScheduler;
+
+// 机型参数自动整定 (可分离 CMA-ES, 即对角协方差的 CMA-ES)
+//
+// 在机型参数 (控制律时间常数、最大坡度、最大俯仰角、加速度等) 的取值区间内, 搜索使一组期望轨迹的
+// 跟踪误差最小的参数。每一代的 λ 个候选参数 × K 条轨迹作为一批 (λ·K 次 runSweepCase,
+// 与 SweepRunner 的仿真循环和误差定义相同) 由 FleetScheduler 并行运行。
+// 搜索在归一化坐标 [0,1]^n 中进行, 越界的采样点按边界反射; 随机数只由 seed 决定, 结果与线程数无关。
+
+// 跟踪误差 → 代价: 各项 RMS 的加权和 (默认 1度航向误差相当于10米位置误差)
+struct TuneObjective {
+    double distWeight = 1.0;    // 位置误差 RMS (米)
+    double altWeight = 1.0;     // 高度误差 RMS (米)
+    double hdgWeight = 10.0;    // 航向误差 RMS (度)
+    double velWeight = 1.0;     // 速度误差 RMS (节)
+};
+
+double trackingCost(const TrackingStats& stats, const TuneObjective& objective);
+
+struct TuneSpec {
+    // 起点 (也是不参与整定的参数的取值); 结果沿用其名称
+    AirframeProfile start;
+
+    // 各参数的取值区间 (按 laero_airframe::Field 编号); min >= max 的参数不参与整定
+    // 默认整定 phiTau/thtTau/headingTau/altitudeTau/velocityTau、maxBankD、maxPitchD、vNps;
+    // psiTau (跟踪时不经过 flyPsi)、hDps、aMps 保持起点的值
+    SweepRange range[laero_airframe::FIELD_COUNT];
+
+    unsigned populationSize = 0;    // 每代候选数 λ; 0 为 4 + 3·ln(n)
+    unsigned maxGenerations = 60;
+    double initialStep = 0.25;      // 归一化坐标中的初始步长 σ0
+    double tolerance = 1e-3;        // 归一化坐标中的步长 σ·max(D) 小于此值时停止
+    uint64_t seed = 1;
+    double dt = 1.0 / 60.0;
+    TuneObjective objective;
+
+    TuneSpec();
+};
+
+// 每一代的摘要
+struct TuneGeneration {
+    unsigned generation = 0;
+    double bestCost = 0.0;      // 本代最优
+    double meanCost = 0.0;      // 本代平均
+    double bestSoFarCost = 0.0; // 到本代为止的最优
+    double sigma = 0.0;         // 更新后的步长 σ·max(D)
+};
+
+struct TuneResult {
+    AirframeProfile best;
+    double bestCost = 0.0;
+    double startCost = 0.0;
+    size_t evaluations = 0;     // 候选参数个数 (每个跑全部轨迹)
+    std::vector<TuneGeneration> history;
+};
+
+// 一批候选参数各自跑全部轨迹, costs[c] 为第c个候选在各条轨迹上代价的平均值
+// 全部 candidates.size() × trajectories.size() 次仿真一起交给 scheduler
+void evaluateAirframes(const std::vector<AirframeProfile>& candidates, const std::vector<TrajectorySpan>& trajectories,
+                       const TuneObjective& objective, FleetScheduler& scheduler, std::vector<double>& costs,
+                       double dt = 1.0 / 60.0);
+
+// 整定; progress 不为空时每代结束后调用一次
+TuneResult tuneAirframe(const std::vector<TrajectorySpan>& trajectories, const TuneSpec& spec, FleetScheduler& scheduler,
+                        const std::function<void(const TuneGeneration&)>& progress = nullptr);
+
+#endif // AUTO_TUNER_HPP
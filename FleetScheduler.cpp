@@ -0,0 +1,108 @@
+// FleetScheduler.cpp
+#include "FleetScheduler.hpp"
+#include <algorithm>
+
+FleetScheduler::FleetScheduler(unsigned threadCount) {
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+    m_threadCount = threadCount;
+
+    m_queues.reset(new WorkQueue[m_threadCount]);
+    LAERO_PROFILE_REGISTER_THREAD();    // 调用线程; 计时统计表在首次登记时分配, 不能留到禁止分配的任务块中
+
+    // 调用线程作为0号线程参与计算, 只需另外创建 threadCount-1 个线程
+    for (unsigned id = 1; id < m_threadCount; ++id) {
+        m_threads.emplace_back(&FleetScheduler::workerLoop, this, id);
+    }
+}
+
+FleetScheduler::~FleetScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_startCv.notify_all();
+    for (std::thread& t : m_threads) {
+        t.join();
+    }
+}
+
+void FleetScheduler::run(size_t count, size_t chunkSize, const ChunkBody& body) {
+    if (count == 0) return;
+
+    if (m_threadCount == 1) {
+        for (size_t begin = 0; begin < count; begin += chunkSize) {
+            body(begin, std::min(count, begin + chunkSize));
+        }
+        return;
+    }
+
+    // --- 按块平均分配给各线程 ---
+    const size_t chunks = (count + chunkSize - 1) / chunkSize;
+    for (unsigned id = 0; id < m_threadCount; ++id) {
+        m_queues[id].next.store(chunks * id / m_threadCount, std::memory_order_relaxed);
+        m_queues[id].end = chunks * (id + 1) / m_threadCount;
+    }
+
+    // --- 开始本帧 ---
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_body = &body;
+        m_count = count;
+        m_runChunkSize = chunkSize;
+        m_pending = m_threadCount - 1;
+        ++m_frame;
+    }
+    m_startCv.notify_all();
+
+    runWorker(0);
+
+    // --- 帧屏障: 等待其他线程完成 ---
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCv.wait(lock, [this] { return m_pending == 0; });
+    m_body = nullptr;
+}
+
+void FleetScheduler::workerLoop(unsigned id) {
+    LAERO_PROFILE_REGISTER_THREAD();
+    unsigned long seenFrame = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCv.wait(lock, [this, seenFrame] { return m_stop || m_frame != seenFrame; });
+            if (m_stop) return;
+            seenFrame = m_frame;
+        }
+
+        runWorker(id);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0) {
+            m_doneCv.notify_one();
+        }
+    }
+}
+
+void FleetScheduler::runWorker(unsigned id) {
+    // 先做自己的块
+    while (runChunk(m_queues[id])) {
+    }
+
+    // 再依次从其他线程窃取
+    for (unsigned k = 1; k < m_threadCount; ++k) {
+        WorkQueue& victim = m_queues[(id + k) % m_threadCount];
+        while (runChunk(victim)) {
+        }
+    }
+}
+
+bool FleetScheduler::runChunk(WorkQueue& queue) {
+    const size_t chunk = queue.next.fetch_add(1, std::memory_order_relaxed);
+    if (chunk >= queue.end) return false;
+
+    const size_t begin = chunk * m_runChunkSize;
+    const size_t end = std::min(m_count, begin + m_runChunkSize);
+    LAERO_NO_ALLOC_SCOPE();     // 工作线程上也检查 (禁止分配区间按线程生效)
+    (*m_body)(begin, end);
+    return true;
+}
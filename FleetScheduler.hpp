@@ -0,0 +1,122 @@
+// FleetScheduler.hpp
+#ifndef FLEET_SCHEDULER_HPP
+#define FLEET_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "AllocationGuard.hpp"
+#include "Profiler.hpp"
+
+// 多线程机队调度器
+// 把一帧内的飞机按块(chunk)分给所有线程, 线程做完自己的块后从其他线程窃取剩余块 (work-stealing)。
+// 每次 parallelFor/stepFrame 都是一个帧屏障: 返回时本帧所有飞机均已推进同一个 dt。
+// 每架飞机只被一个线程更新且互不依赖, 结果与线程数无关。
+class FleetScheduler {
+public:
+    // threadCount = 0 时使用 std::thread::hardware_concurrency()
+    explicit FleetScheduler(unsigned threadCount = 0);
+    ~FleetScheduler();
+
+    FleetScheduler(const FleetScheduler&) = delete;
+    FleetScheduler& operator=(const FleetScheduler&) = delete;
+
+    unsigned threadCount() const { return m_threadCount; }
+
+    // 每个任务块包含的飞机数 (默认256); parallelFor 可以单次指定
+    void setChunkSize(size_t n) { m_chunkSize = (n > 0) ? n : 1; }
+    size_t chunkSize() const { return m_chunkSize; }
+
+    // 并行执行 body(begin, end), 覆盖 [0, count); 调用线程也参与计算, 全部完成后返回
+    // body 只在调用期间按引用使用, 不复制 (不经过 std::function, 每帧不分配堆内存)
+    template<class Body>
+    void parallelFor(size_t count, Body&& body) {
+        parallelFor(count, m_chunkSize, std::forward<Body>(body));
+    }
+
+    // 同上, 本次按 chunkSize 分块, 不改变 chunkSize() 的设置
+    // 少量运行时间长的任务 (如每项一整段仿真) 用 1, 让空闲线程及时窃取
+    template<class Body>
+    void parallelFor(size_t count, size_t chunkSize, Body&& body) {
+        typedef typename std::remove_reference<Body>::type BodyType;
+        const ChunkBody chunkBody = {
+            const_cast<void*>(static_cast<const void*>(&body)),
+            [](void* context, size_t begin, size_t end) { (*static_cast<BodyType*>(context))(begin, end); }
+        };
+        run(count, (chunkSize > 0) ? chunkSize : 1, chunkBody);
+    }
+
+    // 推进一帧: 所有飞机调用 update(dt)
+    template<class Model>
+    void stepFrame(std::vector<Model>& models, double dt) {
+        LAERO_PROFILE_SCOPE(PHASE_FRAME);
+        LAERO_NO_ALLOC_SCOPE();
+        parallelFor(models.size(), [&models, dt](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                models[i].update(dt);
+            }
+        });
+    }
+
+    // 推进一帧: 先对每架飞机调用 guidance(i, model) 下达指令, 再 update(dt)
+    // guidance 只能访问第i架飞机, 否则结果不再与线程数无关
+    template<class Model, class Guidance>
+    void stepFrame(std::vector<Model>& models, double dt, Guidance&& guidance) {
+        LAERO_PROFILE_SCOPE(PHASE_FRAME);
+        LAERO_NO_ALLOC_SCOPE();
+        parallelFor(models.size(), [&models, dt, &guidance](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                guidance(i, models[i]);
+                models[i].update(dt);
+            }
+        });
+    }
+
+private:
+    // 任务体的非拥有引用
+    struct ChunkBody {
+        void* context;
+        void (*invoke)(void* context, size_t begin, size_t end);
+
+        void operator()(size_t begin, size_t end) const { invoke(context, begin, end); }
+    };
+
+    // 每个线程的块队列 [next, end), 独占一条缓存行避免伪共享
+    struct alignas(64) WorkQueue {
+        std::atomic<size_t> next{0};
+        size_t end = 0;
+    };
+
+    void run(size_t count, size_t chunkSize, const ChunkBody& body);
+    void workerLoop(unsigned id);
+    void runWorker(unsigned id);
+    bool runChunk(WorkQueue& queue);
+
+private:
+    unsigned m_threadCount = 1;
+    size_t m_chunkSize = 256;
+
+    std::vector<std::thread> m_threads;
+    std::unique_ptr<WorkQueue[]> m_queues;
+
+    // 当前帧的任务
+    const ChunkBody* m_body = nullptr;
+    size_t m_count = 0;
+    size_t m_runChunkSize = 1;
+
+    // 帧同步
+    std::mutex m_mutex;
+    std::condition_variable m_startCv;
+    std::condition_variable m_doneCv;
+    unsigned long m_frame = 0;
+    unsigned m_pending = 0;
+    bool m_stop = false;
+};
+
+#endif // FLEET_SCHEDULER_HPP
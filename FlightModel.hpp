@@ -0,0 +1,67 @@
+// FlightModel.hpp
+#ifndef FLIGHT_MODEL_HPP
+#define FLIGHT_MODEL_HPP
+
+#include <type_traits>
+#include <utility>
+#include "AircraftState.hpp"
+
+// 飞行模型的编译期公共接口
+//
+// StandaloneLaeroModel 与 StandaloneRacModel 都提供:
+//   update(dt), setCommandedHeadingD(deg), setCommandedAltitude(m), setCommandedVelocityKts(kts),
+//   getState(), setInitialState(state)
+// IsFlightModel 在编译期检查这组接口 (C++17 下代替 concept), 模板驱动程序和 ModelFleet 据此工作;
+// 两个模型再通过 CRTP 基类 FlightModel<Derived, T> 获得基于该接口的公共辅助函数。全部静态分派, 没有虚函数。
+// T 是模型的标量类型 (double 或 float), 状态类型为 StateType = AircraftStateT<T>。
+
+// 三通道高层指令
+struct FlightCommand {
+    double altitudeM = 0.0;     // 期望高度 (米, 向上为正)
+    double velocityKts = 0.0;   // 期望速度 (节)
+    double headingDeg = 0.0;    // 期望航向 (度)
+};
+
+// --- 接口检查 ---
+template<class M, class = void>
+struct IsFlightModel : std::false_type {};
+
+template<class M>
+struct IsFlightModel<M, std::void_t<
+    typename M::StateType,
+    decltype(std::declval<M&>().update(0.0)),
+    decltype(std::declval<M&>().setCommandedHeadingD(0.0)),
+    decltype(std::declval<M&>().setCommandedAltitude(0.0)),
+    decltype(std::declval<M&>().setCommandedVelocityKts(0.0)),
+    decltype(std::declval<M&>().setInitialState(std::declval<const typename M::StateType&>())),
+    decltype(static_cast<const typename M::StateType&>(std::declval<const M&>().getState()))
+>> : std::true_type {};
+
+// --- CRTP 基类 ---
+template<class Derived, class T = double>
+class FlightModel {
+public:
+    typedef T Scalar;
+    typedef AircraftStateT<T> StateType;
+
+    // 按 main.cpp 的顺序下达三通道指令 (高度、速度、航向), 各模型使用自己的默认性能参数
+    void command(const FlightCommand& cmd) {
+        derived().setCommandedAltitude(cmd.altitudeM);
+        derived().setCommandedVelocityKts(cmd.velocityKts);
+        derived().setCommandedHeadingD(cmd.headingDeg);
+    }
+
+    double altitudeM() const { return -double(state().position.z()); }
+    double headingDeg() const { return oe_base::aepcdDeg(double(state().yaw) * oe_base::angle::R2DCC); }
+    double speedKts() const { return double(state().bodyVelocity.length()) * oe_base::units::MPS2KTS; }
+
+protected:
+    FlightModel() {}
+    ~FlightModel() {}
+
+private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+    const StateType& state() const { return static_cast<const Derived&>(*this).getState(); }
+};
+
+#endif // FLIGHT_MODEL_HPP
@@ -0,0 +1,190 @@
+// Integrator.hpp
+#ifndef INTEGRATOR_HPP
+#define INTEGRATOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// 飞行模型的可选积分方法
+//
+// INTEGRATOR_DEFAULT 是各模型原来的方法 (Laero: 姿态/机体速度二阶Adams-Bashforth, 位置欧拉;
+// Rac: 角速率梯形, 速度/位置欧拉), 结果与原来逐位相同, 精度要求 dt 保持在 1/60 秒左右。
+// 其余方法把模型视为以最后一次指令为输入的闭环常微分方程 y' = f(y), 每个阶段按阶段状态重新计算控制律:
+//   RK4       经典四阶龙格-库塔, 每步4次 f
+//   ABM3      三阶 Adams-Bashforth 预估 + 三阶 Adams-Moulton 校正, 每步2次 f;
+//             历史值不足、步长改变, 或导数相对历史值的外推跳变超过容差 (指令阶跃) 时用 RK4 起步;
+//             指令平滑变化时保留历史值, 每步刷新指令的跟踪驱动也按每步2次 f 运行
+//   ADAPTIVE  RK4 步长加倍 (一个整步对比两个半步) 估计局部误差, update(dt) 内部自动选择子步长,
+//             平稳飞行段子步长可达 maxStep, 机动时缩小; 每个子步约11次 f
+// 模型通过 setIntegrator 选择, ModelFleet / MixedFleet / LodFleet 可整队设置。
+
+enum IntegratorType {
+    INTEGRATOR_DEFAULT = 0,
+    INTEGRATOR_RK4,
+    INTEGRATOR_ABM3,
+    INTEGRATOR_ADAPTIVE
+};
+
+struct IntegratorConfig {
+    IntegratorType type = INTEGRATOR_DEFAULT;
+
+    // ADAPTIVE: 每个子步的局部误差容差 (绝对值); ABM3: 导数跳变 * 步长超过它时重新起步
+    double positionTol = 1.0e-3;    // 米
+    double velocityTol = 1.0e-4;    // 米/秒
+    double angleTol = 1.0e-6;       // 弧度
+    // ADAPTIVE: 子步长范围 (秒); 到达下限后即使超出容差也接受
+    double minStep = 1.0e-3;
+    double maxStep = 1.0;
+};
+
+inline const char* integratorName(IntegratorType type) {
+    switch (type) {
+    case INTEGRATOR_DEFAULT:  return "default";
+    case INTEGRATOR_RK4:      return "rk4";
+    case INTEGRATOR_ABM3:     return "abm3";
+    case INTEGRATOR_ADAPTIVE: return "adaptive";
+    }
+    return "unknown";
+}
+
+// --- 通用积分步 ---
+// 状态向量为 std::array<T, N>; f(y, dy) 计算导数。
+// 各函数都接收起点导数 f0 = f(y0), 由调用方计算 (模型需要它更新角速度和历史值)。
+namespace integrator {
+
+template<class T, size_t N>
+using StateVector = std::array<T, N>;
+
+// y + h * k
+template<class T, size_t N>
+inline StateVector<T, N> axpy(const StateVector<T, N>& y, T h, const StateVector<T, N>& k) {
+    StateVector<T, N> out;
+    for (size_t i = 0; i < N; ++i) out[i] = y[i] + h * k[i];
+    return out;
+}
+
+// 经典RK4, 3次 f
+template<class T, size_t N, class F>
+StateVector<T, N> rk4(const StateVector<T, N>& y0, const StateVector<T, N>& f0, T h, F& f) {
+    const T halfH = T(0.5) * h;
+    StateVector<T, N> k2, k3, k4;
+    f(axpy(y0, halfH, f0), k2);
+    f(axpy(y0, halfH, k2), k3);
+    f(axpy(y0, h, k3), k4);
+
+    StateVector<T, N> y1;
+    const T sixth = h / T(6.0);
+    for (size_t i = 0; i < N; ++i) y1[i] = y0[i] + sixth * (f0[i] + T(2.0) * (k2[i] + k3[i]) + k4[i]);
+    return y1;
+}
+
+// AB3预估 + AM3校正, 1次 f; f1/f2 为前两步起点的导数 (步长均为 h)
+template<class T, size_t N, class F>
+StateVector<T, N> abm3(const StateVector<T, N>& y0, const StateVector<T, N>& f0,
+                       const StateVector<T, N>& f1, const StateVector<T, N>& f2, T h, F& f) {
+    const T c = h / T(12.0);
+    StateVector<T, N> predicted;
+    for (size_t i = 0; i < N; ++i) predicted[i] = y0[i] + c * (T(23.0) * f0[i] - T(16.0) * f1[i] + T(5.0) * f2[i]);
+
+    StateVector<T, N> fp;
+    f(predicted, fp);
+
+    StateVector<T, N> y1;
+    for (size_t i = 0; i < N; ++i) y1[i] = y0[i] + c * (T(5.0) * fp[i] + T(8.0) * f0[i] - f1[i]);
+    return y1;
+}
+
+// 自适应推进 dt 秒: RK4 步长加倍估计误差, 接受时用 Richardson 外推 (五阶)。
+// h 为上次的子步长 (<=0 时取 dt), 返回时更新为建议的下一个子步长; tol 为各分量的误差容差。
+// 返回子步数, evals 累加 f 的调用次数。
+template<class T, size_t N, class F>
+size_t adaptive(StateVector<T, N>& y, const StateVector<T, N>& f0, T dt, T& h,
+                const StateVector<T, N>& tol, T minStep, T maxStep, F& f, size_t& evals) {
+    if (!(h > T(0))) h = dt;
+    StateVector<T, N> fy = f0;
+    T t = T(0);
+    size_t steps = 0;
+
+    while (t < dt) {
+        const T remaining = dt - t;
+        T step = std::min(std::min(h, maxStep), remaining);
+        // 避免留下极短的尾步
+        if (remaining - step < T(1.0e-6) * dt) step = remaining;
+
+        const T halfStep = T(0.5) * step;
+        const StateVector<T, N> full = rk4(y, fy, step, f);
+        const StateVector<T, N> mid = rk4(y, fy, halfStep, f);
+        StateVector<T, N> fm;
+        f(mid, fm);
+        const StateVector<T, N> half = rk4(mid, fm, halfStep, f);
+        evals += 10;
+
+        T err = T(0);
+        for (size_t i = 0; i < N; ++i) err = std::max(err, std::abs(half[i] - full[i]) / (T(15.0) * tol[i]));
+
+        const bool accept = (err <= T(1.0)) || (step <= minStep);
+        // 步长因子: 0.9 * err^(-1/5), 限制在 [0.2, 5]
+        const T factor = (err > T(0)) ? std::min(T(5.0), std::max(T(0.2), T(0.9) * std::pow(err, T(-0.2)))) : T(5.0);
+        const T proposed = step * factor;
+
+        if (accept) {
+            for (size_t i = 0; i < N; ++i) y[i] = half[i] + (half[i] - full[i]) / T(15.0);
+            t = (step == remaining) ? dt : t + step;
+            ++steps;
+            // 尾步被剩余时间截短时不据此缩小步长
+            h = (step < h) ? std::max(h, proposed) : proposed;
+            if (t < dt) {
+                f(y, fy);
+                ++evals;
+            }
+        } else {
+            h = proposed;
+        }
+        h = std::min(std::max(h, minStep), maxStep);
+    }
+    return steps;
+}
+
+// 起点导数与前两步导数的线性外推之差 (乘以步长) 都不超过容差: 历史值与当前指令下的导数连续, 可用于 ABM3
+template<class T, size_t N>
+bool historyContinuous(const StateVector<T, N>& f0, const StateVector<T, N>& f1, const StateVector<T, N>& f2,
+                       const StateVector<T, N>& tol, T h) {
+    for (size_t i = 0; i < N; ++i) {
+        if (!(h * std::abs(f0[i] - (T(2.0) * f1[i] - f2[i])) <= tol[i])) return false;
+    }
+    return true;
+}
+
+// 按 config 推进一步 (config.type 不能是 INTEGRATOR_DEFAULT)。
+// f1/f2 为前两步起点的导数, historyCount/historyDt 记录其中有效的步数 (0..2) 和步长, 由本函数更新;
+// 调用方随后把 f0 移入 f1、f1 移入 f2。adaptiveStep 为 ADAPTIVE 的子步长, tol 为各分量的容差。
+template<class T, size_t N, class F>
+StateVector<T, N> advance(const IntegratorConfig& config, const StateVector<T, N>& y0, const StateVector<T, N>& f0,
+                          const StateVector<T, N>& f1, const StateVector<T, N>& f2, const StateVector<T, N>& tol, T h,
+                          T& historyCount, T& historyDt, T& adaptiveStep, F& f, size_t& evals) {
+    StateVector<T, N> y1 = y0;
+    if (config.type == INTEGRATOR_ADAPTIVE) {
+        adaptive(y1, f0, h, adaptiveStep, tol, T(config.minStep), T(config.maxStep), f, evals);
+        // 子步长不固定, 历史值不能用于 ABM3
+        historyCount = T(0);
+        return y1;
+    }
+
+    if (config.type == INTEGRATOR_ABM3 && historyCount >= T(2) && historyDt == h &&
+        historyContinuous(f0, f1, f2, tol, h)) {
+        y1 = abm3(y0, f0, f1, f2, h, f);
+        evals += 1;
+    } else {
+        y1 = rk4(y0, f0, h, f);
+        evals += 3;
+    }
+    historyCount = (historyDt == h) ? std::min(historyCount + T(1), T(2)) : T(1);
+    historyDt = h;
+    return y1;
+}
+
+} // namespace integrator
+
+#endif // INTEGRATOR_HPP
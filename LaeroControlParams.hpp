@@ -0,0 +1,26 @@
+// LaeroControlParams.hpp
+#ifndef LAERO_CONTROL_PARAMS_HPP
+#define LAERO_CONTROL_PARAMS_HPP
+
+// LaeroModel 控制律的时间常数 (秒)
+// 误差小于 "速率上限 * TAU" 时, 指令速率按误差线性减小, TAU 越大接近目标时越平缓。
+// 默认值即原来写死在控制律中的常数。
+struct LaeroControlParams {
+    double phiTau = 1.0;        // flyPhi 滚转
+    double thtTau = 1.0;        // flyTht 俯仰
+    double psiTau = 1.0;        // flyPsi 偏航
+    double headingTau = 1.0;    // setCommandedHeadingD
+    double altitudeTau = 4.0;   // setCommandedAltitude
+    double velocityTau = 1.0;   // setCommandedVelocityKts
+};
+
+// 指令的性能参数: setCommanded* 省略这些参数时使用的值 (默认值即原来的默认参数)
+struct LaeroCommandLimits {
+    double hDps = 20.0;         // setCommandedHeadingD 转弯速率 (度/秒)
+    double maxBankD = 30.0;     // setCommandedHeadingD 最大坡度 (度)
+    double aMps = 150.0;        // setCommandedAltitude 爬升率 (米/秒)
+    double maxPitchD = 15.0;    // setCommandedAltitude 最大俯仰角 (度)
+    double vNps = 5.0;          // setCommandedVelocityKts 加速度 (节/秒)
+};
+
+#endif // LAERO_CONTROL_PARAMS_HPP
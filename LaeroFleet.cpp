@@ -0,0 +1,322 @@
+// LaeroFleet.cpp
+#include "LaeroFleet.hpp"
+#include "LaeroSimd.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+const double LaeroFleet::NO_COMMAND = -9999.0;
+
+namespace {
+
+// --- 单机控制律 (与 StandaloneLaeroModel::flyPhi/flyTht 相同的计算) ---
+inline double flyPhiRate(double phiCmdDeg, double roll, double TAU, double phiDotCmdDps = 30.0) {
+    double phiCmdRad = phiCmdDeg * oe_base::angle::D2RCC;
+    double phiDotCmdRps = phiDotCmdDps * oe_base::angle::D2RCC;
+
+    double phiErrRad = oe_base::aepcdRad(phiCmdRad - roll);
+
+    double phiErrBrkRad = phiDotCmdRps * TAU;
+
+    double phiDotRps = oe_base::sign(phiErrRad) * phiDotCmdRps;
+    if (std::abs(phiErrRad) < phiErrBrkRad) {
+        phiDotRps = (phiErrRad / phiErrBrkRad) * phiDotCmdRps;
+    }
+    return phiDotRps;
+}
+
+inline double flyThtRate(double thtCmdDeg, double pitch, double TAU, double thtDotCmdDps = 10.0) {
+    double thtCmdRad = thtCmdDeg * oe_base::angle::D2RCC;
+    double thtDotCmdRps = thtDotCmdDps * oe_base::angle::D2RCC;
+
+    double thtErrRad = thtCmdRad - pitch;
+
+    double thtErrBrkRad = thtDotCmdRps * TAU;
+
+    double thtDotRps = oe_base::sign(thtErrRad) * thtDotCmdRps;
+    if (std::abs(thtErrRad) < thtErrBrkRad) {
+        thtDotRps = (thtErrRad / thtErrBrkRad) * thtDotCmdRps;
+    }
+    return thtDotRps;
+}
+
+// 每列都使用同一个 memory_resource (std::array 的元素只能在初始化时指定分配器)
+template<size_t... I>
+std::array<std::pmr::vector<double>, LaeroFleet::FIELD_COUNT> makeColumns(std::pmr::memory_resource* resource,
+                                                                         std::index_sequence<I...>) {
+    return { { ((void)I, std::pmr::vector<double>(resource))... } };
+}
+
+} // namespace
+
+LaeroFleet::LaeroFleet(std::pmr::memory_resource* resource)
+    : m_data(makeColumns(resource, std::make_index_sequence<FIELD_COUNT>())) {
+}
+
+size_t LaeroFleet::addAircraft(const AircraftState& initialState) {
+    const size_t i = m_count;
+    for (int f = 0; f < FIELD_COUNT; ++f) {
+        m_data[f].push_back(0.0);
+    }
+    ++m_count;
+
+    setState(i, initialState);
+
+    m_data[CMD_HDG_D][i] = NO_COMMAND;
+    m_data[CMD_ALT_M][i] = NO_COMMAND;
+    m_data[CMD_VEL_KTS][i] = NO_COMMAND;
+
+    // 性能参数取机队的缺省值, 供批量指令使用
+    m_data[CMD_HDG_DPS][i] = m_limits.hDps;
+    m_data[CMD_MAX_BANK_D][i] = m_limits.maxBankD;
+    m_data[CMD_ALT_MPS][i] = m_limits.aMps;
+    m_data[CMD_MAX_PITCH_D][i] = m_limits.maxPitchD;
+    m_data[CMD_VEL_NPS][i] = m_limits.vNps;
+    return i;
+}
+
+void LaeroFleet::reserve(size_t n) {
+    for (int f = 0; f < FIELD_COUNT; ++f) {
+        m_data[f].reserve(n);
+    }
+}
+
+void LaeroFleet::clear() {
+    for (int f = 0; f < FIELD_COUNT; ++f) {
+        m_data[f].clear();
+    }
+    m_count = 0;
+}
+
+void LaeroFleet::setCommandedHeadingD(size_t i, double degs, double hDps, double maxBankD) {
+    m_data[CMD_HDG_D][i] = degs;
+    m_data[CMD_HDG_DPS][i] = hDps;
+    m_data[CMD_MAX_BANK_D][i] = maxBankD;
+}
+
+void LaeroFleet::setCommandedAltitude(size_t i, double meters, double aMps, double maxPitchD) {
+    m_data[CMD_ALT_M][i] = meters;
+    m_data[CMD_ALT_MPS][i] = aMps;
+    m_data[CMD_MAX_PITCH_D][i] = maxPitchD;
+}
+
+void LaeroFleet::setCommandedVelocityKts(size_t i, double kts, double vNps) {
+    m_data[CMD_VEL_KTS][i] = kts;
+    m_data[CMD_VEL_NPS][i] = vNps;
+}
+
+void LaeroFleet::setCommands(const double* altitudeM, const double* velocityKts, const double* headingDeg) {
+    if (altitudeM != nullptr) std::copy(altitudeM, altitudeM + m_count, column(CMD_ALT_M));
+    if (velocityKts != nullptr) std::copy(velocityKts, velocityKts + m_count, column(CMD_VEL_KTS));
+    if (headingDeg != nullptr) std::copy(headingDeg, headingDeg + m_count, column(CMD_HDG_D));
+}
+
+void LaeroFleet::setCommands(size_t first, size_t count, const FlightCommand* commands) {
+    double* __restrict alt = column(CMD_ALT_M) + first;
+    double* __restrict vel = column(CMD_VEL_KTS) + first;
+    double* __restrict hdg = column(CMD_HDG_D) + first;
+    for (size_t k = 0; k < count; ++k) {
+        alt[k] = commands[k].altitudeM;
+        vel[k] = commands[k].velocityKts;
+        hdg[k] = commands[k].headingDeg;
+    }
+}
+
+void LaeroFleet::setGuidanceDivider(unsigned divider, unsigned phase) {
+    m_guidanceDivider = (divider == 0) ? 1 : divider;
+    m_guidancePhase = phase % m_guidanceDivider;
+}
+
+AircraftState LaeroFleet::getState(size_t i) const {
+    AircraftState s;
+    s.roll  = m_data[ROLL][i];
+    s.pitch = m_data[PITCH][i];
+    s.yaw   = m_data[YAW][i];
+    s.position.set(m_data[POS_X][i], m_data[POS_Y][i], m_data[POS_Z][i]);
+    s.velocity.set(m_data[VEL_N][i], m_data[VEL_E][i], m_data[VEL_D][i]);
+    s.bodyVelocity.set(m_data[BODY_U][i], m_data[BODY_V][i], m_data[BODY_W][i]);
+    s.angularVelocity.set(m_data[P][i], m_data[Q][i], m_data[R][i]);
+    return s;
+}
+
+void LaeroFleet::setState(size_t i, const AircraftState& state) {
+    m_data[ROLL][i]  = state.roll;
+    m_data[PITCH][i] = state.pitch;
+    m_data[YAW][i]   = state.yaw;
+    m_data[POS_X][i] = state.position.x();
+    m_data[POS_Y][i] = state.position.y();
+    m_data[POS_Z][i] = state.position.z();
+    m_data[VEL_N][i] = state.velocity.x();
+    m_data[VEL_E][i] = state.velocity.y();
+    m_data[VEL_D][i] = state.velocity.z();
+    m_data[BODY_U][i] = state.bodyVelocity.x();
+    m_data[BODY_V][i] = state.bodyVelocity.y();
+    m_data[BODY_W][i] = state.bodyVelocity.z();
+    m_data[P][i] = state.angularVelocity.x();
+    m_data[Q][i] = state.angularVelocity.y();
+    m_data[R][i] = state.angularVelocity.z();
+
+    // 同 StandaloneLaeroModel::setInitialState: 内部机体速度u取速度大小
+    m_data[U][i] = state.bodyVelocity.length();
+}
+
+void LaeroFleet::update(const double dt) {
+    if (m_guidancePhase == 0) {
+        LAERO_PROFILE_SCOPE(PHASE_COMMAND);
+        applyAltitudeCommands();
+        applyVelocityCommands();
+        applyHeadingCommands();
+    }
+    if (++m_guidancePhase >= m_guidanceDivider) m_guidancePhase = 0;
+
+    LAERO_PROFILE_SCOPE(PHASE_INTEGRATION);
+    updateModel(dt);
+}
+
+// --- 控制律实现 ---
+void LaeroFleet::applyHeadingCommands() {
+    const double* __restrict cmd = column(CMD_HDG_D);
+    const double* __restrict hDps = column(CMD_HDG_DPS);
+    const double* __restrict maxBank = column(CMD_MAX_BANK_D);
+    const double* __restrict yaw = column(YAW);
+    const double* __restrict roll = column(ROLL);
+    const double* __restrict bu = column(BODY_U);
+    const double* __restrict bv = column(BODY_V);
+    const double* __restrict bw = column(BODY_W);
+    double* __restrict psiDot = column(PSI_DOT);
+    double* __restrict phiDot = column(PHI_DOT);
+
+    const double TAU = m_control.headingTau;
+    for (size_t i = 0; i < m_count; ++i) {
+        if (cmd[i] == NO_COMMAND) continue;
+
+        const double MAX_BANK_RAD = maxBank[i] * oe_base::angle::D2RCC;
+
+        double velMps = std::sqrt(bu[i] * bu[i] + bv[i] * bv[i] + bw[i] * bw[i]);
+        if (velMps < 1.0) velMps = 1.0; // 避免除零
+
+        double hdgDeg = yaw[i] * oe_base::angle::R2DCC;
+        double hdgErrDeg = oe_base::aepcdDeg(cmd[i] - hdgDeg);
+
+        double hdgDotMaxAbsRps = oe_base::ETHGM * std::tan(MAX_BANK_RAD) / velMps;
+        double hdgDotMaxAbsDps = hdgDotMaxAbsRps * oe_base::angle::R2DCC;
+
+        double hdgDotAbsDps = std::min(hDps[i], hdgDotMaxAbsDps);
+
+        double hdgErrBrkAbsDeg = TAU * hdgDotAbsDps;
+        if (std::abs(hdgErrDeg) < hdgErrBrkAbsDeg) {
+            hdgDotAbsDps = std::abs(hdgErrDeg) / TAU;
+        }
+
+        double hdgDotDps = oe_base::sign(hdgErrDeg) * hdgDotAbsDps;
+        psiDot[i] = hdgDotDps * oe_base::angle::D2RCC;
+
+        double phiCmdDeg = std::atan2(psiDot[i] * velMps, oe_base::ETHGM) * oe_base::angle::R2DCC;
+        phiDot[i] = flyPhiRate(phiCmdDeg, roll[i], m_control.phiTau);
+    }
+}
+
+void LaeroFleet::applyAltitudeCommands() {
+    const double* __restrict cmd = column(CMD_ALT_M);
+    const double* __restrict aMps = column(CMD_ALT_MPS);
+    const double* __restrict maxPitch = column(CMD_MAX_PITCH_D);
+    const double* __restrict posZ = column(POS_Z);
+    const double* __restrict pitch = column(PITCH);
+    const double* __restrict bu = column(BODY_U);
+    double* __restrict thtDot = column(THT_DOT);
+
+    const double TAU = m_control.altitudeTau;
+    for (size_t i = 0; i < m_count; ++i) {
+        if (cmd[i] == NO_COMMAND) continue;
+
+        double altMtr = -posZ[i]; // 假设Z轴朝下（NED坐标系）
+        double altErrMtr = cmd[i] - altMtr;
+
+        double altDotCmdMps = aMps[i];
+        double altErrBrkMtr = altDotCmdMps * TAU;
+
+        double altDotMps = oe_base::sign(altErrMtr) * altDotCmdMps;
+        if (std::abs(altErrMtr) < altErrBrkMtr) {
+            altDotMps = altErrMtr * (altDotCmdMps / altErrBrkMtr);
+        }
+
+        double velU = bu[i];
+        if (std::abs(velU) < 1.0) velU = 1.0;
+
+        double thtCmdRad = std::asin(altDotMps / velU);
+        double thtCmdDeg = thtCmdRad * oe_base::angle::R2DCC;
+
+        // 限制最大俯仰角
+        thtCmdDeg = std::max(-maxPitch[i], std::min(maxPitch[i], thtCmdDeg));
+
+        thtDot[i] = flyThtRate(thtCmdDeg, pitch[i], m_control.thtTau);
+    }
+}
+
+void LaeroFleet::applyVelocityCommands() {
+    const double* __restrict cmd = column(CMD_VEL_KTS);
+    const double* __restrict vNps = column(CMD_VEL_NPS);
+    const double* __restrict bu = column(BODY_U);
+    double* __restrict uDot = column(U_DOT);
+
+    const double KTS2MPS = oe_base::units::KTS2MPS;
+    const double TAU = m_control.velocityTau;
+    for (size_t i = 0; i < m_count; ++i) {
+        if (cmd[i] == NO_COMMAND) continue;
+
+        double velCmdMps = cmd[i] * KTS2MPS;
+        double velDotCmdMps2 = vNps[i] * KTS2MPS;
+
+        double velErrMps = velCmdMps - bu[i]; // 只考虑前向速度
+
+        double velErrBrkMps = velDotCmdMps2 * TAU;
+
+        double velDotMps2 = oe_base::sign(velErrMps) * velDotCmdMps2;
+        if (std::abs(velErrMps) < velErrBrkMps) {
+            velDotMps2 = (velErrMps / velErrBrkMps) * velDotCmdMps2;
+        }
+        uDot[i] = velDotMps2;
+    }
+}
+
+void LaeroFleet::updateModel(const double dt) {
+    laero_simd::EomColumns c;
+    c.count = m_count;
+
+    c.phi = column(ROLL);
+    c.tht = column(PITCH);
+    c.psi = column(YAW);
+    c.phiDot = column(PHI_DOT);
+    c.thtDot = column(THT_DOT);
+    c.psiDot = column(PSI_DOT);
+    c.phiDot1 = column(PHI_DOT1);
+    c.thtDot1 = column(THT_DOT1);
+    c.psiDot1 = column(PSI_DOT1);
+
+    c.u = column(U);
+    c.v = column(V);
+    c.w = column(W);
+    c.uDot = column(U_DOT);
+    c.vDot = column(V_DOT);
+    c.wDot = column(W_DOT);
+    c.uDot1 = column(U_DOT1);
+    c.vDot1 = column(V_DOT1);
+    c.wDot1 = column(W_DOT1);
+
+    c.bodyU = column(BODY_U);
+    c.bodyV = column(BODY_V);
+    c.bodyW = column(BODY_W);
+    c.p = column(P);
+    c.q = column(Q);
+    c.r = column(R);
+    c.velN = column(VEL_N);
+    c.velE = column(VEL_E);
+    c.velD = column(VEL_D);
+    c.posX = column(POS_X);
+    c.posY = column(POS_Y);
+    c.posZ = column(POS_Z);
+
+    // 运动方程按CPU支持的最高指令集向量化 (见 LaeroSimd.hpp)
+    laero_simd::eomStep(c, dt);
+}
@@ -0,0 +1,131 @@
+// LaeroFleet.hpp
+#ifndef LAERO_FLEET_HPP
+#define LAERO_FLEET_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+#include "AircraftState.hpp"
+#include "AirframeProfile.hpp"
+#include "FlightModel.hpp"
+#include "LaeroControlParams.hpp"
+
+// 批量LaeroModel引擎 (结构数组, SoA)
+// 每个字段在整个机队上连续存储, 一次 update(dt) 推进全部飞机。
+// 控制律(setCommanded*/flyPhi/flyTht)与运动方程(updateModel)与 StandaloneLaeroModel 逐项一致。
+//
+// 与单机模型的区别: 指令像 RacModel 一样被保存下来, 每次 update 时按当前状态重新计算控制律,
+// 等价于驱动程序在每个仿真步长先调用 setCommanded*() 再调用 update() (即 main.cpp 的用法)。
+// 设置制导分频 (setGuidanceDivider) 后控制律只在每N步计算一次, 其间保持已算出的
+// phiDot/thtDot/psiDot/uDot, 相当于单机模型在两次 setCommanded*() 之间连续 update()。
+//
+// 各列从构造时给出的 memory_resource 分配 (默认为堆)。交给 ScenarioArena 并先 reserve(机队规模) 时,
+// 机队状态全部位于场景内存中 (约 FIELD_COUNT * ScenarioArena::bytesFor<double>(n) 字节), update 不分配内存。
+class LaeroFleet {
+public:
+    // --- 按字段编号的列 ---
+    enum Field {
+        // AircraftState
+        ROLL, PITCH, YAW,
+        POS_X, POS_Y, POS_Z,
+        VEL_N, VEL_E, VEL_D,
+        BODY_U, BODY_V, BODY_W,   // AircraftState::bodyVelocity
+        P, Q, R,                  // 机体角速度 (p, q, r)
+
+        // LaeroModel的内部变量
+        PHI_DOT, THT_DOT, PSI_DOT,
+        U, V, W,
+        U_DOT, V_DOT, W_DOT,
+        PHI_DOT1, THT_DOT1, PSI_DOT1,
+        U_DOT1, V_DOT1, W_DOT1,
+
+        // 指令 (未设置时为 NO_COMMAND)
+        CMD_HDG_D, CMD_HDG_DPS, CMD_MAX_BANK_D,
+        CMD_ALT_M, CMD_ALT_MPS, CMD_MAX_PITCH_D,
+        CMD_VEL_KTS, CMD_VEL_NPS,
+
+        FIELD_COUNT
+    };
+
+    static const double NO_COMMAND;
+
+    explicit LaeroFleet(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    std::pmr::memory_resource* resource() const { return m_data[0].get_allocator().resource(); }
+
+    // --- 机队管理 ---
+    size_t addAircraft(const AircraftState& initialState);
+    void reserve(size_t n);
+    void clear();
+    size_t size() const { return m_count; }
+
+    // --- 指令接口 (同 StandaloneLaeroModel: 省略的性能参数取 getCommandLimits()) ---
+    void setCommandedHeadingD(size_t i, double degs) { setCommandedHeadingD(i, degs, m_limits.hDps, m_limits.maxBankD); }
+    void setCommandedHeadingD(size_t i, double degs, double hDps) { setCommandedHeadingD(i, degs, hDps, m_limits.maxBankD); }
+    void setCommandedHeadingD(size_t i, double degs, double hDps, double maxBankD);
+    void setCommandedAltitude(size_t i, double meters) { setCommandedAltitude(i, meters, m_limits.aMps, m_limits.maxPitchD); }
+    void setCommandedAltitude(size_t i, double meters, double aMps) { setCommandedAltitude(i, meters, aMps, m_limits.maxPitchD); }
+    void setCommandedAltitude(size_t i, double meters, double aMps, double maxPitchD);
+    void setCommandedVelocityKts(size_t i, double kts) { setCommandedVelocityKts(i, kts, m_limits.vNps); }
+    void setCommandedVelocityKts(size_t i, double kts, double vNps);
+
+    // --- 批量指令 (只写期望值, 性能参数保持上次设置的值, 新加入的飞机取 getCommandLimits()) ---
+    // 整个机队的三通道指令, 每个数组长度为 size(); 某个通道传 nullptr 时保持不变
+    void setCommands(const double* altitudeM, const double* velocityKts, const double* headingDeg);
+    // 第 first .. first+count-1 架飞机的指令
+    void setCommands(size_t first, size_t count, const FlightCommand* commands);
+
+    // --- 制导分频: 控制律每 divider 次 update 计算一次 (1 为每步, 默认) ---
+    // phase 为分频计数 (默认0: 下一次 update 立即计算控制律)。两次计算之间下达的指令在下一个制导时刻生效。
+    void setGuidanceDivider(unsigned divider, unsigned phase = 0);
+    unsigned guidanceDivider() const { return m_guidanceDivider; }
+    // 分频计数: 上一个制导时刻以来的 update 次数, 到 divider 归零 (快照保存此值)
+    unsigned guidancePhase() const { return m_guidancePhase; }
+    // 下一次 update 是否计算控制律 (驱动程序可以只在此时采样期望轨迹、下达指令)
+    bool guidanceDue() const { return m_guidancePhase == 0; }
+
+    // --- 控制律时间常数 (整个机队共用) ---
+    void setControlParams(const LaeroControlParams& params) { m_control = params; }
+    const LaeroControlParams& getControlParams() const { return m_control; }
+
+    // --- 指令性能参数的缺省值 (整个机队共用): 之后加入的飞机和省略性能参数的指令使用 ---
+    void setCommandLimits(const LaeroCommandLimits& limits) { m_limits = limits; }
+    const LaeroCommandLimits& getCommandLimits() const { return m_limits; }
+
+    // 机型参数 = 控制律时间常数 + 指令性能参数 (同 StandaloneLaeroModel::setAirframe)
+    void setAirframe(const AirframeProfile& airframe) {
+        m_control = airframe.control;
+        m_limits = airframe.limits;
+    }
+
+    // --- 推进整个机队 ---
+    void update(const double dt);
+
+    // --- 状态访问 ---
+    AircraftState getState(size_t i) const;
+    void setState(size_t i, const AircraftState& state);
+
+    // 直接访问某一列 (长度为 size())
+    const double* column(Field f) const { return m_data[f].data(); }
+    double* column(Field f) { return m_data[f].data(); }
+
+private:
+    // --- 控制律 (整列处理) ---
+    void applyHeadingCommands();
+    void applyAltitudeCommands();
+    void applyVelocityCommands();
+
+    // --- 运动方程 (整列处理) ---
+    void updateModel(const double dt);
+
+private:
+    size_t m_count = 0;
+    LaeroControlParams m_control;
+    LaeroCommandLimits m_limits;
+    unsigned m_guidanceDivider = 1;
+    unsigned m_guidancePhase = 0;
+    std::array<std::pmr::vector<double>, FIELD_COUNT> m_data;
+};
+
+#endif // LAERO_FLEET_HPP
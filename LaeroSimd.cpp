@@ -0,0 +1,284 @@
+// LaeroSimd.cpp
+#include "LaeroSimd.hpp"
+#include "OeBase.hpp"
+#include <cmath>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define LAERO_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace laero_simd {
+
+namespace {
+
+const double HALF_PI = oe_base::PI / 2.0;
+const double EPSILON = 1.0E-10;
+
+// --- sincos 常数 (Cephes sin.c, 与 oe_base::fastSinCos 相同) ---
+typedef oe_base::SinCosConstants<double> SinCosK;
+const double TWO_OVER_PI = SinCosK::TWO_OVER_PI;
+const double PIO2_1 = SinCosK::PIO2_1;
+const double PIO2_2 = SinCosK::PIO2_2;
+const double PIO2_3 = SinCosK::PIO2_3;
+const double (&SINCOF)[6] = SinCosK::SIN;
+const double (&COSCOF)[6] = SinCosK::COS;
+
+SimdLevel& levelRef() {
+    static SimdLevel level = detectLevel();
+    return level;
+}
+
+} // namespace
+
+#ifdef LAERO_SIMD_X86
+
+// ==============================================================
+// SSE2: 每条指令2架飞机
+// ==============================================================
+namespace sse2 {
+#define SIMD_INLINE __attribute__((target("sse2"), always_inline)) static inline
+#define SIMD_TARGET __attribute__((target("sse2"))) static
+
+struct S {
+    typedef __m128d V;
+    typedef __m128d M;
+    static const size_t W = 2;
+
+    SIMD_INLINE V set1(double x) { return _mm_set1_pd(x); }
+    SIMD_INLINE V load(const double* p) { return _mm_loadu_pd(p); }
+    SIMD_INLINE void store(double* p, V a) { _mm_storeu_pd(p, a); }
+    SIMD_INLINE V add(V a, V b) { return _mm_add_pd(a, b); }
+    SIMD_INLINE V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    SIMD_INLINE V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    SIMD_INLINE V neg(V a) { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+    SIMD_INLINE V floor(V a) {
+        // SSE2没有roundpd: 先就近取整 (加减2^52, 与 oe_base::roundNearest 相同, 不经过int32, 不会溢出), 再修正。
+        // |a| >= 2^52 时已是整数 (或 NaN/Inf), 原样返回
+        const V magic = _mm_set1_pd(4503599627370496.0);
+        const V signBit = _mm_set1_pd(-0.0);
+        const V absA = _mm_andnot_pd(signBit, a);
+        V t = _mm_sub_pd(_mm_add_pd(absA, magic), magic);
+        t = _mm_or_pd(t, _mm_and_pd(a, signBit));
+        t = _mm_sub_pd(t, _mm_and_pd(_mm_cmpgt_pd(t, a), _mm_set1_pd(1.0)));
+        return select(_mm_cmplt_pd(absA, magic), t, a);
+    }
+    SIMD_INLINE M gt(V a, V b) { return _mm_cmpgt_pd(a, b); }
+    SIMD_INLINE M lt(V a, V b) { return _mm_cmplt_pd(a, b); }
+    SIMD_INLINE M ge(V a, V b) { return _mm_cmpge_pd(a, b); }
+    SIMD_INLINE M le(V a, V b) { return _mm_cmple_pd(a, b); }
+    SIMD_INLINE M eq(V a, V b) { return _mm_cmpeq_pd(a, b); }
+    SIMD_INLINE M bor(M a, M b) { return _mm_or_pd(a, b); }
+    SIMD_INLINE V select(M m, V a, V b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+};
+
+#include "LaeroSimdKernel.inl"
+
+#undef SIMD_INLINE
+#undef SIMD_TARGET
+} // namespace sse2
+
+// ==============================================================
+// AVX2: 每条指令4架飞机
+// ==============================================================
+namespace avx2 {
+#define SIMD_INLINE __attribute__((target("avx2"), always_inline)) static inline
+#define SIMD_TARGET __attribute__((target("avx2"))) static
+
+struct S {
+    typedef __m256d V;
+    typedef __m256d M;
+    static const size_t W = 4;
+
+    SIMD_INLINE V set1(double x) { return _mm256_set1_pd(x); }
+    SIMD_INLINE V load(const double* p) { return _mm256_loadu_pd(p); }
+    SIMD_INLINE void store(double* p, V a) { _mm256_storeu_pd(p, a); }
+    SIMD_INLINE V add(V a, V b) { return _mm256_add_pd(a, b); }
+    SIMD_INLINE V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    SIMD_INLINE V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    SIMD_INLINE V neg(V a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+    SIMD_INLINE V floor(V a) { return _mm256_floor_pd(a); }
+    SIMD_INLINE M gt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    SIMD_INLINE M lt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    SIMD_INLINE M ge(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+    SIMD_INLINE M le(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    SIMD_INLINE M eq(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    SIMD_INLINE M bor(M a, M b) { return _mm256_or_pd(a, b); }
+    SIMD_INLINE V select(M m, V a, V b) { return _mm256_blendv_pd(b, a, m); }
+};
+
+#include "LaeroSimdKernel.inl"
+
+#undef SIMD_INLINE
+#undef SIMD_TARGET
+} // namespace avx2
+
+// ==============================================================
+// AVX-512: 每条指令8架飞机
+// ==============================================================
+namespace avx512 {
+#define SIMD_INLINE __attribute__((target("avx512f"), always_inline)) static inline
+#define SIMD_TARGET __attribute__((target("avx512f"))) static
+
+struct S {
+    typedef __m512d V;
+    typedef __mmask8 M;
+    static const size_t W = 8;
+
+    SIMD_INLINE V set1(double x) { return _mm512_set1_pd(x); }
+    SIMD_INLINE V load(const double* p) { return _mm512_loadu_pd(p); }
+    SIMD_INLINE void store(double* p, V a) { _mm512_storeu_pd(p, a); }
+    SIMD_INLINE V add(V a, V b) { return _mm512_add_pd(a, b); }
+    SIMD_INLINE V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+    SIMD_INLINE V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+    SIMD_INLINE V neg(V a) { return _mm512_sub_pd(_mm512_set1_pd(-0.0), a); }
+    SIMD_INLINE V floor(V a) { return _mm512_mask_roundscale_pd(a, 0xFF, a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+    SIMD_INLINE M gt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    SIMD_INLINE M lt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    SIMD_INLINE M ge(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+    SIMD_INLINE M le(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+    SIMD_INLINE M eq(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    SIMD_INLINE M bor(M a, M b) { return static_cast<M>(a | b); }
+    SIMD_INLINE V select(M m, V a, V b) { return _mm512_mask_blend_pd(m, b, a); }
+};
+
+#include "LaeroSimdKernel.inl"
+
+#undef SIMD_INLINE
+#undef SIMD_TARGET
+} // namespace avx512
+
+#endif // LAERO_SIMD_X86
+
+// ==============================================================
+// 级别选择
+// ==============================================================
+SimdLevel detectLevel() {
+#ifdef LAERO_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return AVX512;
+    if (__builtin_cpu_supports("avx2")) return AVX2;
+    if (__builtin_cpu_supports("sse2")) return SSE2;
+#endif
+    return SCALAR;
+}
+
+SimdLevel activeLevel() {
+    return levelRef();
+}
+
+void setLevel(SimdLevel level) {
+    const SimdLevel maxLevel = detectLevel();
+    levelRef() = (level > maxLevel) ? maxLevel : level;
+}
+
+const char* levelName(SimdLevel level) {
+    switch (level) {
+    case SSE2:   return "sse2";
+    case AVX2:   return "avx2";
+    case AVX512: return "avx512";
+    default:     return "scalar";
+    }
+}
+
+// ==============================================================
+// 标量参考实现 (与 StandaloneLaeroModel::updateModel 相同)
+// ==============================================================
+void eomStepScalar(const EomColumns& c, double dt, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        // --- 旋转方程 EOM ---
+        double& phi = c.phi[i];
+        double& tht = c.tht[i];
+        double& psi = c.psi[i];
+
+        phi += 0.5 * (3.0 * c.phiDot[i] - c.phiDot1[i]) * dt;
+        phi = oe_base::aepcdRad(phi);
+
+        tht += 0.5 * (3.0 * c.thtDot[i] - c.thtDot1[i]) * dt;
+        if (tht >= HALF_PI) tht = (HALF_PI - EPSILON);
+        if (tht <= -HALF_PI) tht = -(HALF_PI - EPSILON);
+
+        psi += 0.5 * (3.0 * c.psiDot[i] - c.psiDot1[i]) * dt;
+        psi = oe_base::aepcdRad(psi);
+
+        c.phiDot1[i] = c.phiDot[i];
+        c.thtDot1[i] = c.thtDot[i];
+        c.psiDot1[i] = c.psiDot[i];
+
+        double sinPhi = std::sin(phi), cosPhi = std::cos(phi);
+        double sinTht = std::sin(tht), cosTht = std::cos(tht);
+        double sinPsi = std::sin(psi), cosPsi = std::cos(psi);
+
+        double l1 = cosTht * cosPsi;
+        double l2 = cosTht * sinPsi;
+        double l3 = -sinTht;
+        double m1 = sinPhi * sinTht * cosPsi - cosPhi * sinPsi;
+        double m2 = sinPhi * sinTht * sinPsi + cosPhi * cosPsi;
+        double m3 = sinPhi * cosTht;
+        double n1 = cosPhi * sinTht * cosPsi + sinPhi * sinPsi;
+        double n2 = cosPhi * sinTht * sinPsi - sinPhi * cosPsi;
+        double n3 = cosPhi * cosTht;
+
+        c.p[i] = c.phiDot[i] - sinTht * c.psiDot[i];
+        c.q[i] = cosPhi * c.thtDot[i] + cosTht * sinPhi * c.psiDot[i];
+        c.r[i] = -sinPhi * c.thtDot[i] + cosTht * cosPhi * c.psiDot[i];
+
+        // --- 平移方程 EOM ---
+        double& u = c.u[i];
+        double& v = c.v[i];
+        double& w = c.w[i];
+        u += 0.5 * (3.0 * c.uDot[i] - c.uDot1[i]) * dt;
+        v += 0.5 * (3.0 * c.vDot[i] - c.vDot1[i]) * dt;
+        w += 0.5 * (3.0 * c.wDot[i] - c.wDot1[i]) * dt;
+        c.bodyU[i] = u;
+        c.bodyV[i] = v;
+        c.bodyW[i] = w;
+
+        c.uDot1[i] = c.uDot[i];
+        c.vDot1[i] = c.vDot[i];
+        c.wDot1[i] = c.wDot[i];
+
+        c.velN[i] = l1 * u + m1 * v + n1 * w;
+        c.velE[i] = l2 * u + m2 * v + n2 * w;
+        c.velD[i] = l3 * u + m3 * v + n3 * w;
+
+        // 更新位置 (简单的欧拉积分)
+        c.posX[i] += c.velN[i] * dt;
+        c.posY[i] += c.velE[i] * dt;
+        c.posZ[i] += c.velD[i] * dt;
+    }
+}
+
+// ==============================================================
+// 分派
+// ==============================================================
+void eomStep(const EomColumns& c, double dt) {
+    size_t done = 0;
+#ifdef LAERO_SIMD_X86
+    switch (activeLevel()) {
+    case AVX512: done = avx512::eomKernel(c, dt); break;
+    case AVX2:   done = avx2::eomKernel(c, dt); break;
+    case SSE2:   done = sse2::eomKernel(c, dt); break;
+    default: break;
+    }
+#endif
+    eomStepScalar(c, dt, done, c.count);
+}
+
+void sincos(const double* x, double* s, double* c, size_t n) {
+    size_t done = 0;
+#ifdef LAERO_SIMD_X86
+    switch (activeLevel()) {
+    case AVX512: done = avx512::sincosKernel(x, s, c, n); break;
+    case AVX2:   done = avx2::sincosKernel(x, s, c, n); break;
+    case SSE2:   done = sse2::sincosKernel(x, s, c, n); break;
+    default: break;
+    }
+#endif
+    for (size_t i = done; i < n; ++i) {
+        s[i] = std::sin(x[i]);
+        c[i] = std::cos(x[i]);
+    }
+}
+
+} // namespace laero_simd
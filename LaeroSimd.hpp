@@ -0,0 +1,90 @@
+// LaeroSimd.hpp
+#ifndef LAERO_SIMD_HPP
+#define LAERO_SIMD_HPP
+
+#include <cstddef>
+
+// LaeroModel 运动方程 (updateModel) 的向量化内核
+//
+// 一条指令同时处理 2/4/8 架飞机 (SSE2/AVX2/AVX-512, double), 运行时根据CPU选择指令集。
+// 向量路径使用多项式 sincos (Cephes系数, Cody-Waite 区间约简), 标量路径使用 std::sin/std::cos,
+// 与 StandaloneLaeroModel::updateModel 逐位相同。
+//
+// 精度: 对 |x| <= 1.0e4 的输入, 向量 sincos 与 std::sin/std::cos 的绝对误差 <= SINCOS_TOLERANCE。
+// 运动方程的每一步只是在此误差上做乘加, 单步状态与标量路径的相对误差同一量级 (约1e-15);
+// 120秒标准机动后位置差异在 1e-6 米以内。
+// 更大的输入不溢出 (取整不经过int32), 误差随区间约简的舍入增长, 约 2*DBL_EPSILON*|x|; 角度回绕限幅在 [-PI, PI]。
+// Bench --check 对每个指令集级别检查这些上界。
+namespace laero_simd {
+
+const double SINCOS_TOLERANCE = 4.0e-16;
+
+enum SimdLevel {
+    SCALAR = 0,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+// 运动方程所需的全部列 (长度均为 count)
+struct EomColumns {
+    size_t count = 0;
+
+    // 姿态及其Adams-Bashforth历史
+    double* phi = nullptr;
+    double* tht = nullptr;
+    double* psi = nullptr;
+    const double* phiDot = nullptr;
+    const double* thtDot = nullptr;
+    const double* psiDot = nullptr;
+    double* phiDot1 = nullptr;
+    double* thtDot1 = nullptr;
+    double* psiDot1 = nullptr;
+
+    // 机体速度及其Adams-Bashforth历史
+    double* u = nullptr;
+    double* v = nullptr;
+    double* w = nullptr;
+    const double* uDot = nullptr;
+    const double* vDot = nullptr;
+    const double* wDot = nullptr;
+    double* uDot1 = nullptr;
+    double* vDot1 = nullptr;
+    double* wDot1 = nullptr;
+
+    // 输出: AircraftState 对应字段
+    double* bodyU = nullptr;
+    double* bodyV = nullptr;
+    double* bodyW = nullptr;
+    double* p = nullptr;
+    double* q = nullptr;
+    double* r = nullptr;
+    double* velN = nullptr;
+    double* velE = nullptr;
+    double* velD = nullptr;
+    double* posX = nullptr;
+    double* posY = nullptr;
+    double* posZ = nullptr;
+};
+
+// CPU支持的最高级别
+SimdLevel detectLevel();
+
+// 当前使用的级别 (默认 detectLevel()); setLevel 可强制降级, 超出CPU能力时取CPU上限
+SimdLevel activeLevel();
+void setLevel(SimdLevel level);
+
+const char* levelName(SimdLevel level);
+
+// 推进一个步长 (按当前级别分派)
+void eomStep(const EomColumns& c, double dt);
+
+// 标量参考实现, 处理 [begin, end)
+void eomStepScalar(const EomColumns& c, double dt, size_t begin, size_t end);
+
+// 批量 sincos (按当前级别分派)
+void sincos(const double* x, double* s, double* c, size_t n);
+
+} // namespace laero_simd
+
+#endif // LAERO_SIMD_HPP
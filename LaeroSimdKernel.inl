@@ -0,0 +1,143 @@
+// LaeroSimdKernel.inl
+// 与指令集无关的内核主体, 由 LaeroSimd.cpp 在各指令集的 target 区域和命名空间内包含。
+// 包含前须定义 SIMD_INLINE/SIMD_TARGET 函数属性宏和指令集封装 S:
+//   V/M 向量与掩码类型, W 宽度,
+//   set1/load/store/add/sub/mul/neg/floor/gt/lt/ge/le/eq/bor/select
+
+SIMD_INLINE void vsincos(S::V x, S::V& s, S::V& c) {
+    // j = round(x * 2/PI), r = x - j*PI/2 (Cody-Waite三段), |r| <= PI/4
+    const S::V j = S::floor(S::add(S::mul(x, S::set1(TWO_OVER_PI)), S::set1(0.5)));
+    S::V r = S::sub(x, S::mul(j, S::set1(PIO2_1)));
+    r = S::sub(r, S::mul(j, S::set1(PIO2_2)));
+    r = S::sub(r, S::mul(j, S::set1(PIO2_3)));
+
+    const S::V zz = S::mul(r, r);
+
+    S::V ps = S::set1(SINCOF[0]);
+    for (int k = 1; k < 6; ++k) ps = S::add(S::mul(ps, zz), S::set1(SINCOF[k]));
+    const S::V sinr = S::add(r, S::mul(r, S::mul(zz, ps)));
+
+    S::V pc = S::set1(COSCOF[0]);
+    for (int k = 1; k < 6; ++k) pc = S::add(S::mul(pc, zz), S::set1(COSCOF[k]));
+    const S::V cosr = S::add(S::sub(S::set1(1.0), S::mul(zz, S::set1(0.5))), S::mul(S::mul(zz, zz), pc));
+
+    // 象限 q = j mod 4
+    const S::V q = S::sub(j, S::mul(S::set1(4.0), S::floor(S::mul(j, S::set1(0.25)))));
+    const S::M swap = S::bor(S::eq(q, S::set1(1.0)), S::eq(q, S::set1(3.0)));
+    const S::M sinNeg = S::ge(q, S::set1(2.0));
+    const S::M cosNeg = S::bor(S::eq(q, S::set1(1.0)), S::eq(q, S::set1(2.0)));
+
+    const S::V sv = S::select(swap, cosr, sinr);
+    const S::V cv = S::select(swap, sinr, cosr);
+    s = S::select(sinNeg, S::neg(sv), sv);
+    c = S::select(cosNeg, S::neg(cv), cv);
+}
+
+// 与 oe_base::aepcdRad 相同的结果 (单圈回绕时逐位相同), 但无分支
+SIMD_INLINE S::V wrapRad(S::V a) {
+    const S::V pi = S::set1(oe_base::PI);
+    const S::V twoPi = S::set1(2.0 * oe_base::PI);
+    const S::V turns = S::floor(S::mul(S::add(a, pi), S::set1(1.0 / (2.0 * oe_base::PI))));
+    S::V wrapped = S::sub(a, S::mul(twoPi, turns));
+    // 舍入误差可能超出边界 (与 oe_base::wrapPeriod 相同地限幅)
+    wrapped = S::select(S::gt(wrapped, pi), pi, wrapped);
+    wrapped = S::select(S::lt(wrapped, S::neg(pi)), S::neg(pi), wrapped);
+    const S::M outside = S::bor(S::gt(a, pi), S::lt(a, S::neg(pi)));
+    return S::select(outside, wrapped, a);
+}
+
+SIMD_TARGET size_t eomKernel(const laero_simd::EomColumns& c, double dt) {
+    const S::V dtv = S::set1(dt);
+    const S::V half = S::set1(0.5);
+    const S::V three = S::set1(3.0);
+    const S::V thtMax = S::set1(HALF_PI);
+    const S::V thtClampHi = S::set1(HALF_PI - EPSILON);
+    const S::V thtClampLo = S::set1(-(HALF_PI - EPSILON));
+
+    size_t i = 0;
+    for (; i + S::W <= c.count; i += S::W) {
+        // --- 旋转方程 ---
+        const S::V phiDot = S::load(c.phiDot + i);
+        const S::V thtDot = S::load(c.thtDot + i);
+        const S::V psiDot = S::load(c.psiDot + i);
+
+        S::V phi = S::add(S::load(c.phi + i),
+                          S::mul(S::mul(half, S::sub(S::mul(three, phiDot), S::load(c.phiDot1 + i))), dtv));
+        phi = wrapRad(phi);
+
+        S::V tht = S::add(S::load(c.tht + i),
+                          S::mul(S::mul(half, S::sub(S::mul(three, thtDot), S::load(c.thtDot1 + i))), dtv));
+        tht = S::select(S::ge(tht, thtMax), thtClampHi, tht);
+        tht = S::select(S::le(tht, S::neg(thtMax)), thtClampLo, tht);
+
+        S::V psi = S::add(S::load(c.psi + i),
+                          S::mul(S::mul(half, S::sub(S::mul(three, psiDot), S::load(c.psiDot1 + i))), dtv));
+        psi = wrapRad(psi);
+
+        S::store(c.phi + i, phi);
+        S::store(c.tht + i, tht);
+        S::store(c.psi + i, psi);
+        S::store(c.phiDot1 + i, phiDot);
+        S::store(c.thtDot1 + i, thtDot);
+        S::store(c.psiDot1 + i, psiDot);
+
+        S::V sinPhi, cosPhi, sinTht, cosTht, sinPsi, cosPsi;
+        vsincos(phi, sinPhi, cosPhi);
+        vsincos(tht, sinTht, cosTht);
+        vsincos(psi, sinPsi, cosPsi);
+
+        const S::V l1 = S::mul(cosTht, cosPsi);
+        const S::V l2 = S::mul(cosTht, sinPsi);
+        const S::V l3 = S::neg(sinTht);
+        const S::V m1 = S::sub(S::mul(S::mul(sinPhi, sinTht), cosPsi), S::mul(cosPhi, sinPsi));
+        const S::V m2 = S::add(S::mul(S::mul(sinPhi, sinTht), sinPsi), S::mul(cosPhi, cosPsi));
+        const S::V m3 = S::mul(sinPhi, cosTht);
+        const S::V n1 = S::add(S::mul(S::mul(cosPhi, sinTht), cosPsi), S::mul(sinPhi, sinPsi));
+        const S::V n2 = S::sub(S::mul(S::mul(cosPhi, sinTht), sinPsi), S::mul(sinPhi, cosPsi));
+        const S::V n3 = S::mul(cosPhi, cosTht);
+
+        S::store(c.p + i, S::sub(phiDot, S::mul(sinTht, psiDot)));
+        S::store(c.q + i, S::add(S::mul(cosPhi, thtDot), S::mul(S::mul(cosTht, sinPhi), psiDot)));
+        S::store(c.r + i, S::add(S::mul(S::neg(sinPhi), thtDot), S::mul(S::mul(cosTht, cosPhi), psiDot)));
+
+        // --- 平移方程 ---
+        const S::V uDot = S::load(c.uDot + i);
+        const S::V vDot = S::load(c.vDot + i);
+        const S::V wDot = S::load(c.wDot + i);
+        const S::V u = S::add(S::load(c.u + i), S::mul(S::mul(half, S::sub(S::mul(three, uDot), S::load(c.uDot1 + i))), dtv));
+        const S::V v = S::add(S::load(c.v + i), S::mul(S::mul(half, S::sub(S::mul(three, vDot), S::load(c.vDot1 + i))), dtv));
+        const S::V w = S::add(S::load(c.w + i), S::mul(S::mul(half, S::sub(S::mul(three, wDot), S::load(c.wDot1 + i))), dtv));
+        S::store(c.u + i, u);
+        S::store(c.v + i, v);
+        S::store(c.w + i, w);
+        S::store(c.bodyU + i, u);
+        S::store(c.bodyV + i, v);
+        S::store(c.bodyW + i, w);
+        S::store(c.uDot1 + i, uDot);
+        S::store(c.vDot1 + i, vDot);
+        S::store(c.wDot1 + i, wDot);
+
+        const S::V velN = S::add(S::add(S::mul(l1, u), S::mul(m1, v)), S::mul(n1, w));
+        const S::V velE = S::add(S::add(S::mul(l2, u), S::mul(m2, v)), S::mul(n2, w));
+        const S::V velD = S::add(S::add(S::mul(l3, u), S::mul(m3, v)), S::mul(n3, w));
+        S::store(c.velN + i, velN);
+        S::store(c.velE + i, velE);
+        S::store(c.velD + i, velD);
+
+        S::store(c.posX + i, S::add(S::load(c.posX + i), S::mul(velN, dtv)));
+        S::store(c.posY + i, S::add(S::load(c.posY + i), S::mul(velE, dtv)));
+        S::store(c.posZ + i, S::add(S::load(c.posZ + i), S::mul(velD, dtv)));
+    }
+    return i;
+}
+
+SIMD_TARGET size_t sincosKernel(const double* x, double* s, double* c, size_t n) {
+    size_t i = 0;
+    for (; i + S::W <= n; i += S::W) {
+        S::V sv, cv;
+        vsincos(S::load(x + i), sv, cv);
+        S::store(s + i, sv);
+        S::store(c + i, cv);
+    }
+    return i;
+}
@@ -0,0 +1,243 @@
+// LodFleet.cpp
+#include "LodFleet.hpp"
+#include <algorithm>
+#include <cmath>
+
+// ==============================================================
+// 状态交接
+// ==============================================================
+void transferState(const StandaloneLaeroModel& from, StandaloneRacModel& to) {
+    to.setInitialState(from.getState());
+
+    const StandaloneLaeroModel::Internals li = from.getInternals();
+    StandaloneRacModel::Internals ri = to.getInternals();
+    // RacModel 的俯仰/偏航角速率即欧拉角速率, 接续梯形积分
+    ri.qa1 = li.thtDot1;
+    ri.ra1 = li.psiDot1;
+    // 两个模型的"未设置"标记都是 -9999
+    ri.cmdAltitude = li.cmdAltM;
+    ri.cmdHeading = li.cmdHdgD;
+    ri.cmdVelocity = li.cmdVelKts;
+    // 两个模型的导数不对应, ABM3 重新起步
+    ri.historyCount = 0.0;
+    to.setInternals(ri);
+}
+
+void transferState(const StandaloneRacModel& from, StandaloneLaeroModel& to) {
+    const AircraftState& s = from.getState();
+    to.setInitialState(s);
+
+    const StandaloneRacModel::Internals ri = from.getInternals();
+    StandaloneLaeroModel::Internals li = to.getInternals();
+    li.p = s.angularVelocity.x();
+    li.q = s.angularVelocity.y();
+    li.r = s.angularVelocity.z();
+    li.u = s.bodyVelocity.x();
+    li.v = s.bodyVelocity.y();
+    li.w = s.bodyVelocity.z();
+
+    // 欧拉角速率及其AB历史值接续RacModel; RacModel 没有滚转速率和加速度状态, 置零
+    li.phiDot = li.phiDot1 = 0.0;
+    li.thtDot = li.thtDot1 = ri.qa1;
+    li.psiDot = li.psiDot1 = ri.ra1;
+    li.uDot = li.uDot1 = 0.0;
+    li.vDot = li.vDot1 = 0.0;
+    li.wDot = li.wDot1 = 0.0;
+    li.historyCount = 0.0;
+
+    // 指令值接续, 性能参数 (hDps, maxBankD 等) 保留 LaeroModel 自己的设置
+    li.cmdAltM = (ri.cmdAltitude < -9000.0) ? StandaloneLaeroModel::NO_COMMAND : ri.cmdAltitude;
+    li.cmdHdgD = (ri.cmdHeading < -9000.0) ? StandaloneLaeroModel::NO_COMMAND : ri.cmdHeading;
+    li.cmdVelKts = (ri.cmdVelocity < -9000.0) ? StandaloneLaeroModel::NO_COMMAND : ri.cmdVelocity;
+    to.setInternals(li);
+}
+
+// ==============================================================
+// LodFleet
+// ==============================================================
+LodFleet::LodFleet() {
+}
+
+size_t LodFleet::addAircraft(const AircraftState& initialState, LodLevel level) {
+    Entry e;
+    if (level == LOD_HIGH) {
+        e.handle = m_buckets.add<StandaloneLaeroModel>(initialState);
+        configureLaero(m_buckets.bucket<StandaloneLaeroModel>()[e.handle.index]);
+    } else {
+        e.handle = m_buckets.add<StandaloneRacModel>(initialState);
+        configureRac(m_buckets.bucket<StandaloneRacModel>()[e.handle.index]);
+    }
+
+    const size_t id = m_entries.size();
+    m_entries.push_back(e);
+    m_bucketIds[level].push_back(id);
+    return id;
+}
+
+size_t LodFleet::count(LodLevel level) const {
+    return m_bucketIds[level].size();
+}
+
+void LodFleet::setRacPerformanceLimits(double minSpeedKts, double maxG, double speedAtMaxG_Kts, double maxAccel_mps2) {
+    m_racLimitsSet = true;
+    m_racLimits[0] = minSpeedKts;
+    m_racLimits[1] = maxG;
+    m_racLimits[2] = speedAtMaxG_Kts;
+    m_racLimits[3] = maxAccel_mps2;
+}
+
+void LodFleet::setIntegrator(LodLevel level, const IntegratorConfig& config) {
+    m_integrators[level] = config;
+    if (level == LOD_HIGH) {
+        m_buckets.bucket<StandaloneLaeroModel>().setIntegrator(config);
+    } else {
+        m_buckets.bucket<StandaloneRacModel>().setIntegrator(config);
+    }
+}
+
+void LodFleet::configureLaero(StandaloneLaeroModel& m) const {
+    m.setControlParams(m_laeroControl);
+    m.setIntegrator(m_integrators[LOD_HIGH]);
+}
+
+void LodFleet::configureRac(StandaloneRacModel& m) const {
+    if (m_racLimitsSet) m.setPerformanceLimits(m_racLimits[0], m_racLimits[1], m_racLimits[2], m_racLimits[3]);
+    m.setIntegrator(m_integrators[LOD_LOW]);
+}
+
+void LodFleet::command(size_t id, const FlightCommand& cmd) {
+    Entry& e = m_entries[id];
+    e.command = cmd;
+    e.hasCommand = true;
+    m_buckets.command(e.handle, cmd);
+}
+
+const AircraftState& LodFleet::getState(size_t id) const {
+    const Buckets::Handle h = m_entries[id].handle;
+    if (h.bucket == LOD_HIGH) return m_buckets.bucket<StandaloneLaeroModel>()[h.index].getState();
+    return m_buckets.bucket<StandaloneRacModel>()[h.index].getState();
+}
+
+// --- 切换 ---
+bool LodFleet::setLevel(size_t id, LodLevel level) {
+    Entry& e = m_entries[id];
+    const LodLevel oldLevel = static_cast<LodLevel>(e.handle.bucket);
+    if (oldLevel == level) return false;
+
+    ModelFleet<StandaloneLaeroModel>& high = m_buckets.bucket<StandaloneLaeroModel>();
+    ModelFleet<StandaloneRacModel>& low = m_buckets.bucket<StandaloneRacModel>();
+    const size_t oldIndex = e.handle.index;
+
+    // 在目标桶末尾建立新模型并交接状态
+    size_t newIndex = 0;
+    if (level == LOD_LOW) {
+        newIndex = low.add(high[oldIndex].getState());
+        configureRac(low[newIndex]);
+        transferState(high[oldIndex], low[newIndex]);
+        high.removeSwap(oldIndex);
+    } else {
+        newIndex = high.add(low[oldIndex].getState());
+        configureLaero(high[newIndex]);
+        transferState(low[oldIndex], high[newIndex]);
+        low.removeSwap(oldIndex);
+    }
+
+    // 原桶的最后一架移到了 oldIndex
+    std::vector<size_t>& oldIds = m_bucketIds[oldLevel];
+    const size_t movedId = oldIds.back();
+    oldIds[oldIndex] = movedId;
+    m_entries[movedId].handle.index = static_cast<uint32_t>(oldIndex);
+    oldIds.pop_back();
+
+    e.handle.bucket = static_cast<uint32_t>(level);
+    e.handle.index = static_cast<uint32_t>(newIndex);
+    m_bucketIds[level].push_back(id);
+
+    e.lastSwitchTime = m_simTime;
+    ++m_switchCount;
+    return true;
+}
+
+double LodFleet::priority(const Entry& e, const LodPolicy& policy) const {
+    const bool isHigh = (e.handle.bucket == LOD_HIGH);
+    const AircraftState& s = (e.handle.bucket == LOD_HIGH)
+        ? m_buckets.bucket<StandaloneLaeroModel>()[e.handle.index].getState()
+        : m_buckets.bucket<StandaloneRacModel>()[e.handle.index].getState();
+
+    // --- 关注区域 ---
+    double best = -1.0;
+    for (const LodArea& area : policy.areas) {
+        const double radius = area.radius * (isHigh ? 1.0 + policy.hysteresis : 1.0);
+        if (radius <= 0.0) continue;
+        const double d = (s.position - area.center).length();
+        if (d < radius) best = std::max(best, 2.0 - d / radius);
+    }
+    if (best >= 1.0) return best;
+
+    // --- 机动程度: 误差与阈值之比的最大值 ---
+    if (!e.hasCommand) return -1.0;
+    const double scale = isHigh ? 1.0 - policy.hysteresis : 1.0;
+    double activity = 0.0;
+    if (policy.maneuverHeadingDeg > 0.0) {
+        const double hdgErr = oe_base::aepcdDeg(e.command.headingDeg - s.yaw * oe_base::angle::R2DCC);
+        activity = std::max(activity, std::abs(hdgErr) / (policy.maneuverHeadingDeg * scale));
+    }
+    if (policy.maneuverAltitudeM > 0.0) {
+        const double altErr = e.command.altitudeM + s.position.z();
+        activity = std::max(activity, std::abs(altErr) / (policy.maneuverAltitudeM * scale));
+    }
+    if (policy.maneuverVelocityKts > 0.0) {
+        const double velErr = e.command.velocityKts - s.bodyVelocity.length() * oe_base::units::MPS2KTS;
+        activity = std::max(activity, std::abs(velErr) / (policy.maneuverVelocityKts * scale));
+    }
+    if (activity > 1.0) return 1.0 - 1.0 / activity;
+    return -1.0;
+}
+
+size_t LodFleet::applyPolicy(const LodPolicy& policy) {
+    const size_t n = m_entries.size();
+    m_priorities.resize(n);
+    m_order.clear();
+    for (size_t id = 0; id < n; ++id) {
+        m_priorities[id] = priority(m_entries[id], policy);
+        if (m_priorities[id] > 0.0) m_order.push_back(id);
+    }
+
+    // 按优先级从高到低; 超出预算的部分不使用高精度模型
+    std::sort(m_order.begin(), m_order.end(), [this](size_t a, size_t b) {
+        return m_priorities[a] > m_priorities[b];
+    });
+    if (policy.maxHighCount > 0 && m_order.size() > policy.maxHighCount) {
+        for (size_t k = policy.maxHighCount; k < m_order.size(); ++k) m_priorities[m_order[k]] = -1.0;
+        m_order.resize(policy.maxHighCount);
+    }
+
+    size_t switched = 0;
+    // 先降级, 腾出预算
+    for (size_t id = 0; id < n; ++id) {
+        const Entry& e = m_entries[id];
+        if (e.handle.bucket != LOD_HIGH || m_priorities[id] > 0.0) continue;
+        if (m_simTime - e.lastSwitchTime < policy.minDwellSeconds) continue;
+        if (setLevel(id, LOD_LOW)) ++switched;
+    }
+    // 再按优先级升级
+    for (size_t id : m_order) {
+        const Entry& e = m_entries[id];
+        if (e.handle.bucket == LOD_HIGH) continue;
+        if (policy.maxHighCount > 0 && count(LOD_HIGH) >= policy.maxHighCount) break;
+        if (m_simTime - e.lastSwitchTime < policy.minDwellSeconds) continue;
+        if (setLevel(id, LOD_HIGH)) ++switched;
+    }
+    return switched;
+}
+
+// --- 推进 ---
+void LodFleet::update(const double dt) {
+    m_buckets.update(dt);
+    m_simTime += dt;
+}
+
+void LodFleet::update(const double dt, FleetScheduler& scheduler) {
+    m_buckets.update(dt, scheduler);
+    m_simTime += dt;
+}
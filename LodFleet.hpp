@@ -0,0 +1,117 @@
+// LodFleet.hpp
+#ifndef LOD_FLEET_HPP
+#define LOD_FLEET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ModelFleet.hpp"
+#include "StandaloneLaeroModel.hpp"
+#include "StandaloneRacModel.hpp"
+
+// 细节层次 (LOD) 管理: 同一架飞机在运行时于 LaeroModel (高精度) 与 RacModel (低开销) 之间切换
+//
+// 飞机按当前LOD存放在 MixedFleet 的两个桶中, 切换时从一个桶移到另一个桶, 对外编号不变。
+// 切换时交接完整的 AircraftState 和内部变量, 位置、姿态、速度不跳变:
+//   Laero -> Rac: qa1/ra1 取 thtDot/psiDot, 保留最后的指令
+//   Rac -> Laero: u/v/w 取机体速度, thtDot/psiDot 及其AB历史值取 qa1/ra1, 滚转和加速度历史置零
+//   两个方向的 ABM3 历史值都作废 (重新起步); 各层次的积分方法由 setIntegrator 设置
+// 切换策略 LodPolicy 综合关注区域距离、机动程度和高精度飞机数上限 (CPU预算)。
+
+enum LodLevel {
+    LOD_HIGH = 0,   // StandaloneLaeroModel
+    LOD_LOW = 1     // StandaloneRacModel
+};
+
+// 关注区域: 区域内的飞机使用高精度模型
+struct LodArea {
+    oe_base::Vec3d center;
+    double radius = 0.0;    // 米
+};
+
+struct LodPolicy {
+    std::vector<LodArea> areas;
+
+    // 机动判据: 任一误差超过阈值视为机动中, 使用高精度模型 (<=0 表示不使用该判据)
+    double maneuverHeadingDeg = 10.0;
+    double maneuverAltitudeM = 100.0;
+    double maneuverVelocityKts = 20.0;
+
+    // 迟滞: 离开区域的半径为 radius*(1+hysteresis), 退出机动的阈值为 阈值*(1-hysteresis)
+    double hysteresis = 0.2;
+    // 两次切换之间的最短停留时间 (秒), 防止来回抖动
+    double minDwellSeconds = 5.0;
+    // 高精度飞机数上限 (CPU预算); 超出时按优先级 (区域内 > 机动程度) 保留, 0 表示不限
+    size_t maxHighCount = 0;
+};
+
+// --- 状态交接 ---
+void transferState(const StandaloneLaeroModel& from, StandaloneRacModel& to);
+void transferState(const StandaloneRacModel& from, StandaloneLaeroModel& to);
+
+class LodFleet {
+public:
+    LodFleet();
+
+    // --- 机队管理 (编号从0连续分配, 切换LOD后不变) ---
+    size_t addAircraft(const AircraftState& initialState, LodLevel level = LOD_HIGH);
+    size_t size() const { return m_entries.size(); }
+    size_t count(LodLevel level) const;
+
+    // 新建或切换到的模型使用的参数
+    void setLaeroControlParams(const LaeroControlParams& params) { m_laeroControl = params; }
+    void setRacPerformanceLimits(double minSpeedKts, double maxG, double speedAtMaxG_Kts, double maxAccel_mps2);
+    // 该层次的积分方法, 立即用于已有的飞机
+    void setIntegrator(LodLevel level, const IntegratorConfig& config);
+
+    // --- 指令与状态 ---
+    void command(size_t id, const FlightCommand& cmd);
+    const AircraftState& getState(size_t id) const;
+    LodLevel level(size_t id) const { return static_cast<LodLevel>(m_entries[id].handle.bucket); }
+
+    // --- LOD ---
+    // 立即切换 (不检查停留时间); 已是该层次时返回false
+    bool setLevel(size_t id, LodLevel level);
+    // 按策略评估所有飞机并切换, 返回切换次数
+    size_t applyPolicy(const LodPolicy& policy);
+    uint64_t switchCount() const { return m_switchCount; }
+
+    // --- 推进 ---
+    void update(const double dt);
+    void update(const double dt, FleetScheduler& scheduler);
+    double simTime() const { return m_simTime; }
+
+private:
+    typedef MixedFleet<StandaloneLaeroModel, StandaloneRacModel> Buckets;
+
+    struct Entry {
+        Buckets::Handle handle;
+        FlightCommand command;
+        bool hasCommand = false;
+        double lastSwitchTime = -1.0e300;
+    };
+
+    // 策略优先级: <0 不需要高精度; 区域内为 [1,2], 仅机动时为 (0,1)
+    double priority(const Entry& e, const LodPolicy& policy) const;
+    void configureLaero(StandaloneLaeroModel& m) const;
+    void configureRac(StandaloneRacModel& m) const;
+
+private:
+    Buckets m_buckets;
+    std::vector<Entry> m_entries;
+    std::vector<size_t> m_bucketIds[2];     // 桶内序号 -> 飞机编号
+
+    LaeroControlParams m_laeroControl;
+    bool m_racLimitsSet = false;
+    double m_racLimits[4] = { 0.0, 0.0, 0.0, 0.0 };
+    IntegratorConfig m_integrators[2];
+
+    double m_simTime = 0.0;
+    uint64_t m_switchCount = 0;
+
+    // applyPolicy 的工作区
+    std::vector<double> m_priorities;
+    std::vector<size_t> m_order;
+};
+
+#endif // LOD_FLEET_HPP
@@ -0,0 +1,199 @@
+// ModelFleet.hpp
+#ifndef MODEL_FLEET_HPP
+#define MODEL_FLEET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "FlightModel.hpp"
+#include "FleetScheduler.hpp"
+#include "Integrator.hpp"
+
+// 任意飞行模型的机队容器
+//
+// ModelFleet<Model>: 同一种模型连续存放在一个 std::vector 中, 逐个或由 FleetScheduler 并行推进。
+// MixedFleet<Models...>: 每种模型一个 ModelFleet 桶 (std::tuple), 高精度模型和廉价模型共用一个场景;
+// 推进时逐桶处理, 每个桶内是同类型的连续内存和直接调用, 没有虚函数。
+
+template<class Model>
+class ModelFleet {
+    static_assert(IsFlightModel<Model>::value, "Model must provide the FlightModel interface");
+
+public:
+    typedef Model ModelType;
+    typedef typename Model::Scalar Scalar;
+    typedef typename Model::StateType StateType;
+
+    size_t add(const StateType& initialState) {
+        m_models.emplace_back();
+        m_models.back().setInitialState(initialState);
+        return m_models.size() - 1;
+    }
+
+    // 其他精度的初始状态先转换
+    template<class S>
+    size_t add(const AircraftStateT<S>& initialState) {
+        return add(stateCast<Scalar>(initialState));
+    }
+
+    // 删除第i架: 最后一架移到位置i (返回其原序号), 保持存储连续
+    size_t removeSwap(size_t i) {
+        const size_t last = m_models.size() - 1;
+        if (i != last) m_models[i] = m_models[last];
+        m_models.pop_back();
+        return last;
+    }
+
+    void reserve(size_t n) { m_models.reserve(n); }
+    void clear() { m_models.clear(); }
+    size_t size() const { return m_models.size(); }
+
+    Model& operator[](size_t i) { return m_models[i]; }
+    const Model& operator[](size_t i) const { return m_models[i]; }
+
+    std::vector<Model>& models() { return m_models; }
+    const std::vector<Model>& models() const { return m_models; }
+
+    void command(size_t i, const FlightCommand& cmd) { m_models[i].command(cmd); }
+    const StateType& getState(size_t i) const { return m_models[i].getState(); }
+
+    // 批量指令: commands[i] 下达给第i架 (长度为 size())
+    void command(const FlightCommand* commands) {
+        for (size_t i = 0; i < m_models.size(); ++i) m_models[i].command(commands[i]);
+    }
+
+    // 所有飞机的积分方法 (模型须提供 setIntegrator); 之后加入的飞机使用模型默认值
+    void setIntegrator(const IntegratorConfig& config) {
+        for (Model& m : m_models) m.setIntegrator(config);
+    }
+
+    // --- 推进 ---
+    void update(const double dt) {
+        for (Model& m : m_models) m.update(dt);
+    }
+
+    void update(const double dt, FleetScheduler& scheduler) {
+        scheduler.stepFrame(m_models, dt);
+    }
+
+    // 下达批量指令并推进, 每架飞机的指令和积分在同一个块内完成 (只访问一次该飞机的内存)
+    void update(const double dt, const FlightCommand* commands, FleetScheduler& scheduler) {
+        scheduler.stepFrame(m_models, dt, [commands](size_t i, Model& m) { m.command(commands[i]); });
+    }
+
+private:
+    std::vector<Model> m_models;
+};
+
+// --- 混合机队 ---
+template<class... Models>
+class MixedFleet {
+public:
+    // 飞机编号: 所在桶 (模型类型在 Models... 中的序号) + 桶内序号
+    struct Handle {
+        uint32_t bucket = 0;
+        uint32_t index = 0;
+    };
+
+    // 模型类型在 Models... 中的序号
+    template<class Model>
+    static constexpr uint32_t bucketOf() { return indexOf<Model, Models...>(); }
+
+    template<class Model, class S>
+    Handle add(const AircraftStateT<S>& initialState) {
+        Handle h;
+        h.bucket = bucketOf<Model>();
+        h.index = static_cast<uint32_t>(bucket<Model>().add(initialState));
+        return h;
+    }
+
+    template<class Model>
+    ModelFleet<Model>& bucket() { return std::get<ModelFleet<Model>>(m_buckets); }
+    template<class Model>
+    const ModelFleet<Model>& bucket() const { return std::get<ModelFleet<Model>>(m_buckets); }
+
+    size_t size() const {
+        return std::apply([](const ModelFleet<Models>&... b) { return (size_t(0) + ... + b.size()); }, m_buckets);
+    }
+
+    void clear() {
+        std::apply([](ModelFleet<Models>&... b) { (b.clear(), ...); }, m_buckets);
+    }
+
+    void setIntegrator(const IntegratorConfig& config) {
+        std::apply([&config](ModelFleet<Models>&... b) { (b.setIntegrator(config), ...); }, m_buckets);
+    }
+
+    // --- 推进: 逐桶 ---
+    void update(const double dt) {
+        std::apply([dt](ModelFleet<Models>&... b) { (b.update(dt), ...); }, m_buckets);
+    }
+
+    void update(const double dt, FleetScheduler& scheduler) {
+        std::apply([dt, &scheduler](ModelFleet<Models>&... b) { (b.update(dt, scheduler), ...); }, m_buckets);
+    }
+
+    // --- 按编号访问 (运行时按桶号分派到对应类型) ---
+    // f(model) 对每种模型类型都必须能编译 (通常是泛型 lambda)
+    template<class F>
+    void visit(Handle h, F&& f) {
+        visitImpl(h, f, std::index_sequence_for<Models...>());
+    }
+
+    void command(Handle h, const FlightCommand& cmd) {
+        visit(h, [&cmd](auto& m) { m.command(cmd); });
+    }
+
+    // 统一以 double 返回
+    AircraftState getState(Handle h) {
+        AircraftState s;
+        visit(h, [&s](auto& m) { s = stateCast<double>(m.getState()); });
+        return s;
+    }
+
+    // 对每架飞机调用 f(handle, model), 逐桶顺序遍历
+    template<class F>
+    void forEach(F&& f) {
+        forEachImpl(f, std::index_sequence_for<Models...>());
+    }
+
+private:
+    template<class Model, class First, class... Rest>
+    static constexpr uint32_t indexOf() {
+        if constexpr (std::is_same<Model, First>::value) {
+            return 0;
+        } else {
+            static_assert(sizeof...(Rest) > 0, "Model is not part of this MixedFleet");
+            return 1 + indexOf<Model, Rest...>();
+        }
+    }
+
+    template<class F, size_t... I>
+    void visitImpl(Handle h, F& f, std::index_sequence<I...>) {
+        (void)((h.bucket == I ? (f(std::get<I>(m_buckets)[h.index]), true) : false) || ...);
+    }
+
+    template<class F, size_t... I>
+    void forEachImpl(F& f, std::index_sequence<I...>) {
+        (forEachBucket<I>(f), ...);
+    }
+
+    template<size_t I, class F>
+    void forEachBucket(F& f) {
+        auto& b = std::get<I>(m_buckets);
+        Handle h;
+        h.bucket = static_cast<uint32_t>(I);
+        for (size_t i = 0; i < b.size(); ++i) {
+            h.index = static_cast<uint32_t>(i);
+            f(h, b[i]);
+        }
+    }
+
+private:
+    std::tuple<ModelFleet<Models>...> m_buckets;
+};
+
+#endif // MODEL_FLEET_HPP
@@ -4,45 +4,70 @@
 
 #include <cmath>
 #include <algorithm> // For std::max/min if needed
+#include <limits>
 
 namespace oe_base {
 
 // --- 数学常量 ---
-const double PI = 3.14159265358979323846;
-const double ETHGM = 9.80665; // 地球重力加速度 m/s^2
+constexpr double PI = 3.14159265358979323846;
+constexpr double ETHGM = 9.80665; // 地球重力加速度 m/s^2
 
 // --- 角度转换 ---
 namespace angle {
-    const double D2RCC = PI / 180.0; // 度转弧度
-    const double R2DCC = 180.0 / PI; // 弧度转度
+    constexpr double D2RCC = PI / 180.0; // 度转弧度
+    constexpr double R2DCC = 180.0 / PI; // 弧度转度
 }
 
-// --- 简单的三维向量类 ---
-class Vec3d {
+// --- 简单的三维向量类 (T 为 double 或 float) ---
+template<class T>
+class Vec3 {
 public:
-    Vec3d() : v_x(0.0), v_y(0.0), v_z(0.0) {}
-    Vec3d(double x, double y, double z) : v_x(x), v_y(y), v_z(z) {}
+    typedef T Scalar;
+
+    Vec3() : v_x(T(0)), v_y(T(0)), v_z(T(0)) {}
+    Vec3(T x, T y, T z) : v_x(x), v_y(y), v_z(z) {}
 
-    void set(double x, double y, double z) {
+    // 精度转换
+    template<class U>
+    explicit Vec3(const Vec3<U>& o) : v_x(T(o.x())), v_y(T(o.y())), v_z(T(o.z())) {}
+
+    void set(T x, T y, T z) {
         v_x = x; v_y = y; v_z = z;
     }
 
-    double x() const { return v_x; }
-    double y() const { return v_y; }
-    double z() const { return v_z; }
+    T x() const { return v_x; }
+    T y() const { return v_y; }
+    T z() const { return v_z; }
     
-    double length() const {
+    T length() const {
         return std::sqrt(v_x * v_x + v_y * v_y + v_z * v_z);
     }
     
-    double length2() const {
+    T length2() const {
         return v_x * v_x + v_y * v_y + v_z * v_z;
     }
 
+    Vec3 operator+(const Vec3& rhs) const {
+        return Vec3(v_x + rhs.v_x, v_y + rhs.v_y, v_z + rhs.v_z);
+    }
+
+    Vec3 operator-(const Vec3& rhs) const {
+        return Vec3(v_x - rhs.v_x, v_y - rhs.v_y, v_z - rhs.v_z);
+    }
+
 private:
-    double v_x, v_y, v_z;
+    T v_x, v_y, v_z;
 };
 
+typedef Vec3<double> Vec3d;
+typedef Vec3<float> Vec3f;
+
+// --- 单位换算 ---
+namespace units {
+    constexpr double KTS2MPS = 1852.0 / 3600.0; // 节转米/秒
+    constexpr double MPS2KTS = 3600.0 / 1852.0; // 米/秒转节
+}
+
 // --- 工具函数 ---
 template<class T>
 inline T sign(const T& x) {
@@ -51,20 +76,118 @@ inline T sign(const T& x) {
     return T(0);
 }
 
+// 就近取整 (偶数优先), 无分支: 加减 1.5*2^(p-1) 由硬件舍入完成, 不调用 nearbyint。
+// 要求 |x| < 2^51 (float: 2^22), 且不能用 -ffast-math 编译 (会把加减消掉)
+template<class T>
+inline T roundNearest(T x) {
+    const T magic = T(1.5) * T(1ULL << (std::numeric_limits<T>::digits - 1));
+    return (x + magic) - magic;
+}
+
+// 把 angle 减去 period 的整数倍, 落入 [-period/2, period/2]。
+// 固定的乘、减、取整和 min/max, 耗时与输入无关, 循环中可被自动向量化 (-O3)。
+// 区间内的角度原样返回; 只超出一圈时与逐次减 period 的结果逐位相同。
+template<class T>
+inline T wrapPeriod(T angle, T period, T invPeriod) {
+    const T half = period * T(0.5);
+    const T wrapped = angle - roundNearest(angle * invPeriod) * period;
+    // 舍入误差可能超出边界一个ulp
+    return std::min(std::max(wrapped, -half), half);
+}
+
 // 确保角度在 -PI 到 +PI 之间
-inline double aepcdRad(double angle) {
-    while (angle > PI) angle -= (2.0 * PI);
-    while (angle < -PI) angle += (2.0 * PI);
-    return angle;
+template<class T>
+inline T aepcdRad(T angle) {
+    return wrapPeriod(angle, T(2.0 * PI), T(1.0 / (2.0 * PI)));
 }
 
 // 确保角度在 -180 到 +180 之间
-inline double aepcdDeg(double angle) {
-    while (angle > 180.0) angle -= 360.0;
-    while (angle < -180.0) angle += 360.0;
-    return angle;
+template<class T>
+inline T aepcdDeg(T angle) {
+    return wrapPeriod(angle, T(360.0), T(1.0 / 360.0));
+}
+
+// --- 快速 sincos ---
+// 多项式 sincos (Cephes 系数, Cody-Waite 三段区间约简), 运算次数固定、无库函数调用, -O3 下可自动向量化。
+// double 版本与 LaeroSimd 向量路径使用同一组常数。
+// 在 |x| <= MAX_ARG 内与 std::sin/std::cos (float 版本与 double 精度的结果) 的绝对误差 <= TOLERANCE。
+template<class T>
+struct SinCosConstants;
+
+template<>
+struct SinCosConstants<double> {
+    static constexpr int ORDER = 6;
+    static constexpr double TWO_OVER_PI = 2.0 / PI;
+    static constexpr double PIO2_1 = 1.57079625129699707031E0;
+    static constexpr double PIO2_2 = 7.54978941586159635335E-8;
+    static constexpr double PIO2_3 = 5.39030285815811905290E-15;
+    static constexpr double SIN[ORDER] = {
+         1.58962301576546568060E-10,
+        -2.50507477628578072866E-8,
+         2.75573136213857245213E-6,
+        -1.98412698295895385996E-4,
+         8.33333333332211858878E-3,
+        -1.66666666666666307295E-1
+    };
+    static constexpr double COS[ORDER] = {
+        -1.13585365213876817300E-11,
+         2.08757008419747316778E-9,
+        -2.75573141792967388112E-7,
+         2.48015872888517045348E-5,
+        -1.38888888888730564116E-3,
+         4.16666666666665929218E-2
+    };
+    static constexpr double MAX_ARG = 1.0e4;
+    static constexpr double TOLERANCE = 4.0e-16;
+};
+
+template<>
+struct SinCosConstants<float> {
+    static constexpr int ORDER = 3;
+    static constexpr float TWO_OVER_PI = float(2.0 / PI);
+    static constexpr float PIO2_1 = 1.5703125f;
+    static constexpr float PIO2_2 = 4.837512969970703125E-4f;
+    static constexpr float PIO2_3 = 7.54978995489188216E-8f;
+    static constexpr float SIN[ORDER] = {
+        -1.9515295891E-4f,
+         8.3321608736E-3f,
+        -1.6666654611E-1f
+    };
+    static constexpr float COS[ORDER] = {
+         2.443315711809948E-5f,
+        -1.388731625493765E-3f,
+         4.166664568298827E-2f
+    };
+    static constexpr float MAX_ARG = 8192.0f;
+    static constexpr float TOLERANCE = 2.0e-7f;
+};
+
+template<class T>
+inline void fastSinCos(T x, T& s, T& c) {
+    typedef SinCosConstants<T> K;
+
+    // j = round(x * 2/PI), r = x - j*PI/2, |r| <= PI/4
+    const T j = roundNearest(x * K::TWO_OVER_PI);
+    const T r = ((x - j * K::PIO2_1) - j * K::PIO2_2) - j * K::PIO2_3;
+    const T zz = r * r;
+
+    T ps = K::SIN[0];
+    T pc = K::COS[0];
+    for (int k = 1; k < K::ORDER; ++k) {
+        ps = ps * zz + K::SIN[k];
+        pc = pc * zz + K::COS[k];
+    }
+    const T sinr = r + r * (zz * ps);
+    const T cosr = (T(1) - zz * T(0.5)) + (zz * zz) * pc;
+
+    // 象限 q = j mod 4 (补码与运算对负数同样成立)
+    const int q = static_cast<int>(j) & 3;
+    const T sv = (q & 1) ? cosr : sinr;
+    const T cv = (q & 1) ? sinr : cosr;
+    s = (q & 2) ? -sv : sv;
+    c = ((q + 1) & 2) ? -cv : cv;
 }
 
 } // namespace oe_base
 
-#endif // OE_BASE_HPP
\ No newline at end of file
+#endif // OE_BASE_HPP
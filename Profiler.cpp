@@ -0,0 +1,407 @@
+// Profiler.cpp
+#include "Profiler.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LAERO_PROFILE_RDTSC 1
+#endif
+
+namespace laero_profile {
+
+namespace {
+
+// 对数直方图: 值 < 8 单独一档; 否则按最高位 e 分倍程, 每倍程取其后3位细分为8档
+const int SUB_BITS = 3;
+const size_t SUB_COUNT = size_t(1) << SUB_BITS;
+const size_t BUCKET_COUNT = (64 - SUB_BITS + 1) * SUB_COUNT;
+
+// 统计槽: 各阶段的耗时, 之后是各计数器的步数
+const size_t SLOT_COUNT = PHASE_COUNT + COUNTER_COUNT;
+inline size_t counterSlot(Counter counter) { return PHASE_COUNT + static_cast<size_t>(counter); }
+
+size_t bucketIndex(uint64_t v) {
+    if (v < SUB_COUNT) return static_cast<size_t>(v);
+    const int e = 63 - __builtin_clzll(v);
+    const size_t sub = static_cast<size_t>(v >> (e - SUB_BITS)) & (SUB_COUNT - 1);
+    return static_cast<size_t>(e - SUB_BITS + 1) * SUB_COUNT + sub;
+}
+
+// 第k档的下限
+uint64_t bucketLower(size_t k) {
+    if (k < SUB_COUNT) return k;
+    const int e = static_cast<int>(k / SUB_COUNT) + SUB_BITS - 1;
+    return static_cast<uint64_t>(SUB_COUNT + k % SUB_COUNT) << (e - SUB_BITS);
+}
+
+// 第k档的代表值 (该档区间的中点; 只含一个值的档为该值)
+double bucketValue(size_t k) {
+    if (k < SUB_COUNT) return static_cast<double>(k);
+    const int e = static_cast<int>(k / SUB_COUNT) + SUB_BITS - 1;
+    const uint64_t width = uint64_t(1) << (e - SUB_BITS);
+    const double lower = static_cast<double>(bucketLower(k));
+    return (width > 1) ? lower + 0.5 * static_cast<double>(width) : lower;
+}
+
+// 单个线程的统计; 只有所属线程写入 (load+store, 无原子读改写, 包括复位时的清零), 查询线程并发读取
+struct PhaseStats {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> max{0};
+    std::atomic<uint64_t> buckets[BUCKET_COUNT];
+
+    PhaseStats() { clear(); }
+
+    void clear() {
+        count.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint64_t>& b : buckets) b.store(0, std::memory_order_relaxed);
+    }
+};
+
+void bump(std::atomic<uint64_t>& a, uint64_t v) {
+    a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+// reset() 增加复位序号; 线程的 epoch 落后时, 其统计是复位前的, 由所属线程在下一次记录时清零
+std::atomic<uint64_t> g_resetEpoch{0};
+
+struct ThreadStats {
+    PhaseStats slots[SLOT_COUNT];
+    std::atomic<uint64_t> epoch{0};     // 统计所属的复位序号
+
+    // 所属线程调用: 复位请求之后第一次记录前清零
+    PhaseStats& slot(size_t k) {
+        const uint64_t e = g_resetEpoch.load(std::memory_order_acquire);
+        if (epoch.load(std::memory_order_relaxed) != e) {
+            for (PhaseStats& s : slots) s.clear();
+            epoch.store(e, std::memory_order_release);
+        }
+        return slots[k];
+    }
+
+    // 是否属于当前复位序号 (否则视为全零); 查询线程持有锁调用
+    bool current() const {
+        return epoch.load(std::memory_order_acquire) == g_resetEpoch.load(std::memory_order_relaxed);
+    }
+
+    void addTo(uint64_t* count, uint64_t* total, uint64_t* max, uint64_t (*buckets)[BUCKET_COUNT]) const {
+        for (size_t p = 0; p < SLOT_COUNT; ++p) {
+            const PhaseStats& s = slots[p];
+            count[p] += s.count.load(std::memory_order_relaxed);
+            total[p] += s.total.load(std::memory_order_relaxed);
+            const uint64_t m = s.max.load(std::memory_order_relaxed);
+            if (m > max[p]) max[p] = m;
+            for (size_t k = 0; k < BUCKET_COUNT; ++k) {
+                buckets[p][k] += s.buckets[k].load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+// 合并所有线程的统计
+struct Totals {
+    uint64_t count[SLOT_COUNT] = {};
+    uint64_t total[SLOT_COUNT] = {};
+    uint64_t max[SLOT_COUNT] = {};
+    uint64_t buckets[SLOT_COUNT][BUCKET_COUNT] = {};
+};
+
+const size_t LIVE_RESERVE = 256;    // 同时登记的线程数不超过此值时, 登记线程不再分配内存
+
+// 所有线程的统计; 线程退出时其统计并入 retired (只在持有锁时访问, 复位时直接清零)
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadStats*> live;
+    ThreadStats retired;
+    Totals totals;                          // 查询和周期输出的合并结果 (持有锁时使用), 直方图较大, 不放在栈上
+
+    std::atomic<uint64_t> dumpInterval{0};  // ticks, 0 表示关闭
+    std::atomic<uint64_t> nextDump{0};
+    std::ostream* dumpOut = nullptr;
+
+    Registry() { live.reserve(LIVE_RESERVE); }
+};
+
+// 静态存储 (周期输出可能发生在禁止分配区间内); 不析构, 其他线程退出时仍可访问
+Registry& registry() {
+    alignas(Registry) static unsigned char storage[sizeof(Registry)];
+    static Registry* r = new (storage) Registry();
+    return *r;
+}
+
+void mergeInto(ThreadStats& dst, const ThreadStats& src) {
+    if (!src.current()) return;
+    for (size_t p = 0; p < SLOT_COUNT; ++p) {
+        const PhaseStats& s = src.slots[p];
+        PhaseStats& d = dst.slots[p];
+        bump(d.count, s.count.load(std::memory_order_relaxed));
+        bump(d.total, s.total.load(std::memory_order_relaxed));
+        if (s.max.load(std::memory_order_relaxed) > d.max.load(std::memory_order_relaxed)) {
+            d.max.store(s.max.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        for (size_t k = 0; k < BUCKET_COUNT; ++k) {
+            bump(d.buckets[k], s.buckets[k].load(std::memory_order_relaxed));
+        }
+    }
+}
+
+struct ThreadSlot {
+    ThreadStats stats;
+
+    ThreadSlot() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.live.push_back(&stats);
+    }
+
+    ~ThreadSlot() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        mergeInto(r.retired, stats);
+        for (size_t i = 0; i < r.live.size(); ++i) {
+            if (r.live[i] == &stats) {
+                r.live[i] = r.live.back();
+                r.live.pop_back();
+                break;
+            }
+        }
+    }
+};
+
+ThreadStats& threadStats() {
+    thread_local ThreadSlot slot;
+    return slot.stats;
+}
+
+// 每纳秒的 tick 数
+double ticksPerNs() {
+#ifdef LAERO_PROFILE_RDTSC
+    static const double ratio = [] {
+        const auto t0 = std::chrono::steady_clock::now();
+        const uint64_t c0 = __rdtsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const uint64_t c1 = __rdtsc();
+        const auto t1 = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        return (ns > 0.0) ? static_cast<double>(c1 - c0) / ns : 1.0;
+    }();
+    return ratio;
+#else
+    return 1.0;
+#endif
+}
+
+void collectLocked(Registry& r, Totals& t) {
+    t = Totals();
+    r.retired.addTo(t.count, t.total, t.max, t.buckets);
+    for (const ThreadStats* s : r.live) {
+        if (s->current()) s->addTo(t.count, t.total, t.max, t.buckets);
+    }
+}
+
+double percentileTicks(const Totals& t, size_t p, double q) {
+    if (t.count[p] == 0) return 0.0;
+    if (q < 0.0) q = 0.0;
+    if (q > 1.0) q = 1.0;
+    const double rank = q * static_cast<double>(t.count[p]);
+    uint64_t seen = 0;
+    for (size_t k = 0; k < BUCKET_COUNT; ++k) {
+        seen += t.buckets[p][k];
+        if (seen > 0 && static_cast<double>(seen) >= rank) {
+            // 分位数不超过实测最大值
+            const double v = bucketValue(k);
+            return (v < static_cast<double>(t.max[p])) ? v : static_cast<double>(t.max[p]);
+        }
+    }
+    return static_cast<double>(t.max[p]);
+}
+
+PhaseSummary summaryOf(const Totals& t, size_t p) {
+    const double scale = 1.0 / ticksPerNs();
+    PhaseSummary s;
+    s.count = t.count[p];
+    s.totalNs = static_cast<double>(t.total[p]) * scale;
+    s.meanNs = (s.count > 0) ? s.totalNs / static_cast<double>(s.count) : 0.0;
+    s.p50Ns = percentileTicks(t, p, 0.50) * scale;
+    s.p99Ns = percentileTicks(t, p, 0.99) * scale;
+    s.maxNs = static_cast<double>(t.max[p]) * scale;
+    return s;
+}
+
+CountSummary countSummaryOf(const Totals& t, size_t slot) {
+    CountSummary s;
+    s.samples = t.count[slot];
+    s.mean = (s.samples > 0) ? static_cast<double>(t.total[slot]) / static_cast<double>(s.samples) : 0.0;
+    s.p50 = percentileTicks(t, slot, 0.50);
+    s.p99 = percentileTicks(t, slot, 0.99);
+    s.max = t.max[slot];
+    return s;
+}
+
+void dumpLocked(Registry& r, std::ostream& out) {
+    Totals& t = r.totals;
+    collectLocked(r, t);
+
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-18s %12s %14s %10s %10s %10s %12s\n",
+                  "Phase", "Count", "Total(ms)", "Mean(ns)", "p50(ns)", "p99(ns)", "Max(ns)");
+    out << line;
+    for (size_t p = 0; p < PHASE_COUNT; ++p) {
+        const PhaseSummary s = summaryOf(t, p);
+        std::snprintf(line, sizeof(line), "%-18s %12llu %14.3f %10.1f %10.1f %10.1f %12.1f\n",
+                      phaseName(static_cast<Phase>(p)), static_cast<unsigned long long>(s.count),
+                      s.totalNs * 1.0e-6, s.meanNs, s.p50Ns, s.p99Ns, s.maxNs);
+        out << line;
+    }
+    std::snprintf(line, sizeof(line), "%-18s %12s %14s %10s %10s %10s %12s\n",
+                  "Steps", "Samples", "Total", "Mean", "p50", "p99", "Max");
+    out << line;
+    for (size_t c = 0; c < COUNTER_COUNT; ++c) {
+        const size_t slot = counterSlot(static_cast<Counter>(c));
+        if (t.count[slot] == 0) continue;
+        const CountSummary s = countSummaryOf(t, slot);
+        std::snprintf(line, sizeof(line), "%-18s %12llu %14llu %10.2f %10.1f %10.1f %12llu\n",
+                      counterName(static_cast<Counter>(c)), static_cast<unsigned long long>(s.samples),
+                      static_cast<unsigned long long>(t.total[slot]), s.mean, s.p50, s.p99,
+                      static_cast<unsigned long long>(s.max));
+        out << line;
+    }
+    out.flush();
+}
+
+void maybeDump(uint64_t nowTicks) {
+    Registry& r = registry();
+    const uint64_t interval = r.dumpInterval.load(std::memory_order_relaxed);
+    if (interval == 0) return;
+    uint64_t next = r.nextDump.load(std::memory_order_relaxed);
+    if (nowTicks < next) return;
+    // 多个线程同时到期时只有一个输出
+    if (!r.nextDump.compare_exchange_strong(next, nowTicks + interval, std::memory_order_relaxed)) return;
+
+    std::lock_guard<std::mutex> lock(r.mutex);
+    if (r.dumpOut != nullptr) dumpLocked(r, *r.dumpOut);
+}
+
+} // namespace
+
+const char* phaseName(Phase phase) {
+    switch (phase) {
+        case PHASE_COMMAND:           return "Command";
+        case PHASE_INTEGRATION:       return "Integration";
+        case PHASE_TRAJECTORY_LOOKUP: return "TrajectoryLookup";
+        case PHASE_LOGGING:           return "Logging";
+        case PHASE_FRAME:             return "Frame";
+        default:                      return "Unknown";
+    }
+}
+
+const char* counterName(Counter counter) {
+    switch (counter) {
+        case COUNTER_FRAME_STEPS:      return "FrameSteps";
+        case COUNTER_DERIVATIVE_EVALS: return "DerivativeEvals";
+        default:                       return "Unknown";
+    }
+}
+
+uint64_t now() {
+#ifdef LAERO_PROFILE_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+namespace {
+
+void add(PhaseStats& s, uint64_t v) {
+    bump(s.count, 1);
+    bump(s.total, v);
+    if (v > s.max.load(std::memory_order_relaxed)) s.max.store(v, std::memory_order_relaxed);
+    bump(s.buckets[bucketIndex(v)], 1);
+}
+
+} // namespace
+
+void record(Phase phase, uint64_t ticks) {
+    add(threadStats().slot(phase), ticks);
+    if (phase == PHASE_FRAME) maybeDump(now());
+}
+
+void recordCount(Counter counter, uint64_t n) {
+    add(threadStats().slot(counterSlot(counter)), n);
+}
+
+void registerThread() {
+    threadStats();
+}
+
+PhaseSummary summary(Phase phase) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    collectLocked(r, r.totals);
+    return summaryOf(r.totals, phase);
+}
+
+double percentileNs(Phase phase, double q) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    collectLocked(r, r.totals);
+    return percentileTicks(r.totals, phase, q) / ticksPerNs();
+}
+
+CountSummary countSummary(Counter counter) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    collectLocked(r, r.totals);
+    return countSummaryOf(r.totals, counterSlot(counter));
+}
+
+void countHistogram(Counter counter, std::vector<std::pair<uint64_t, uint64_t>>& bins) {
+    bins.clear();
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    collectLocked(r, r.totals);
+    const uint64_t* buckets = r.totals.buckets[counterSlot(counter)];
+    for (size_t k = 0; k < BUCKET_COUNT; ++k) {
+        if (buckets[k] > 0) bins.push_back(std::make_pair(bucketLower(k), buckets[k]));
+    }
+}
+
+void reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    // 其他线程的统计由其自己清零 (它们写入时不加锁, 这里清零会与写入竞争)
+    for (PhaseStats& s : r.retired.slots) s.clear();
+    g_resetEpoch.fetch_add(1, std::memory_order_release);
+}
+
+void dumpSummary(std::ostream& out) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    dumpLocked(r, out);
+}
+
+void setPeriodicDump(double intervalSeconds, std::ostream* out) {
+    Registry& r = registry();
+    uint64_t interval = 0;
+    if (intervalSeconds > 0.0 && out != nullptr) {
+        interval = static_cast<uint64_t>(intervalSeconds * 1.0e9 * ticksPerNs());
+        if (interval == 0) interval = 1;
+    }
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.dumpOut = out;
+    }
+    r.nextDump.store(now() + interval, std::memory_order_relaxed);
+    r.dumpInterval.store(interval, std::memory_order_relaxed);
+}
+
+} // namespace laero_profile
@@ -0,0 +1,120 @@
+// Profiler.hpp
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+// 热路径分阶段计时 (可选)
+//
+// 定义 LAERO_ENABLE_PROFILING 编译时, LAERO_PROFILE_SCOPE(阶段) 在作用域内计时,
+// 否则展开为空语句, 不产生任何代码。模型库中的计时点:
+//   PHASE_COMMAND            setCommanded* 控制律
+//   PHASE_INTEGRATION        update / updateModel 积分
+//   PHASE_TRAJECTORY_LOOKUP  TrajectoryTrack::sample
+//   PHASE_LOGGING            StateLogger::log
+//   PHASE_FRAME              一帧 (FleetScheduler::stepFrame 或驱动程序的仿真循环)
+//
+// 步数计数 LAERO_PROFILE_COUNT(计数器, n) 记录每次的步数, 同样按直方图统计分布:
+//   COUNTER_FRAME_STEPS        RealTimeRunner 每次醒来执行的仿真步数 (1 + 补步)
+//   COUNTER_DERIVATIVE_EVALS   非默认积分方法每次 update 的导数计算次数 (RK4 4, ABM3 2, ADAPTIVE 随子步数变化)
+//
+// x86 上用 RDTSC 计时 (首次使用时按 steady_clock 标定), 其他平台用 steady_clock。
+// 每个线程写自己的统计 (无竞争), 查询时合并所有线程; 耗时按对数直方图 (每倍程8档, 相对误差<=12.5%) 统计分位数。
+// reset() 只增加复位序号, 各线程在下一次记录时清零自己的统计 (查询时忽略尚未清零的线程)。
+// 线程第一次计时时登记 (要分配内存), 所以进入禁止分配区间 (AllocationGuard.hpp) 的线程要先用
+// LAERO_PROFILE_REGISTER_THREAD() 登记: FleetScheduler 的各线程、TrackingLoop 和 RealTimeRunner 的调用线程已登记。
+namespace laero_profile {
+
+enum Phase {
+    PHASE_COMMAND = 0,
+    PHASE_INTEGRATION,
+    PHASE_TRAJECTORY_LOOKUP,
+    PHASE_LOGGING,
+    PHASE_FRAME,
+    PHASE_COUNT
+};
+
+const char* phaseName(Phase phase);
+
+enum Counter {
+    COUNTER_FRAME_STEPS = 0,
+    COUNTER_DERIVATIVE_EVALS,
+    COUNTER_COUNT
+};
+
+const char* counterName(Counter counter);
+
+// 单个阶段的统计结果 (纳秒)
+struct PhaseSummary {
+    uint64_t count = 0;
+    double totalNs = 0.0;
+    double meanNs = 0.0;
+    double p50Ns = 0.0;
+    double p99Ns = 0.0;
+    double maxNs = 0.0;
+};
+
+// 单个计数器的统计结果 (步数)
+struct CountSummary {
+    uint64_t samples = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+    uint64_t max = 0;
+};
+
+// --- 计时 ---
+uint64_t now();                             // 当前时钟读数 (ticks)
+void record(Phase phase, uint64_t ticks);   // 记录一次耗时
+void recordCount(Counter counter, uint64_t n);  // 记录一次步数
+void registerThread();                      // 登记当前线程 (已登记时什么也不做)
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Phase phase) : m_phase(phase), m_start(now()) {}
+    ~ScopedTimer() { record(m_phase, now() - m_start); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Phase m_phase;
+    uint64_t m_start;
+};
+
+// --- 查询 ---
+PhaseSummary summary(Phase phase);
+// 分位数 q (0~1), 纳秒
+double percentileNs(Phase phase, double q);
+CountSummary countSummary(Counter counter);
+// 直方图中非空的档: (该档下限, 次数), 按下限升序; 16 以下每档一个值
+void countHistogram(Counter counter, std::vector<std::pair<uint64_t, uint64_t>>& bins);
+// 清零所有线程的统计 (可以在其他线程计时期间调用)
+void reset();
+
+// 输出各阶段统计表
+void dumpSummary(std::ostream& out);
+
+// 周期输出: 每经过 intervalSeconds 秒, 在下一次 PHASE_FRAME 结束时把统计表写到 out (intervalSeconds<=0 关闭)
+void setPeriodicDump(double intervalSeconds, std::ostream* out);
+
+} // namespace laero_profile
+
+#ifdef LAERO_ENABLE_PROFILING
+#define LAERO_PROFILE_CONCAT_INNER(a, b) a##b
+#define LAERO_PROFILE_CONCAT(a, b) LAERO_PROFILE_CONCAT_INNER(a, b)
+#define LAERO_PROFILE_SCOPE(phase) \
+    const laero_profile::ScopedTimer LAERO_PROFILE_CONCAT(laeroProfileScope_, __LINE__)(laero_profile::phase)
+#define LAERO_PROFILE_COUNT(counter, n) laero_profile::recordCount(laero_profile::counter, (n))
+#define LAERO_PROFILE_REGISTER_THREAD() laero_profile::registerThread()
+#else
+#define LAERO_PROFILE_SCOPE(phase) ((void)0)
+#define LAERO_PROFILE_COUNT(counter, n) ((void)0)
+#define LAERO_PROFILE_REGISTER_THREAD() ((void)0)
+#endif
+
+#endif // PROFILER_HPP
@@ -0,0 +1,186 @@
+// RealTimeRunner.cpp
+#include "RealTimeRunner.hpp"
+#include "AllocationGuard.hpp"
+#include "Profiler.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+namespace {
+
+int64_t monotonicNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// 睡到 deadline - spinNs (绝对时刻, 不受睡眠期间调度延迟的累积影响), 再忙等到 deadline
+void waitUntil(int64_t deadline, int64_t spinNs) {
+    const int64_t wakeAt = deadline - spinNs;
+    if (monotonicNs() < wakeAt) {
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(wakeAt / 1000000000);
+        ts.tv_nsec = static_cast<long>(wakeAt % 1000000000);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) != 0) {
+            // 被信号打断时继续睡
+        }
+    }
+    while (monotonicNs() < deadline) {
+    }
+}
+
+// 切换到 SCHED_FIFO, 结束时恢复
+class ScopedRealtimePriority {
+public:
+    explicit ScopedRealtimePriority(bool enable) {
+        if (!enable) return;
+        if (pthread_getschedparam(pthread_self(), &m_oldPolicy, &m_oldParam) != 0) return;
+        sched_param param;
+        std::memset(&param, 0, sizeof(param));
+        param.sched_priority = (sched_get_priority_min(SCHED_FIFO) + sched_get_priority_max(SCHED_FIFO)) / 2;
+        m_applied = (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0);
+    }
+    ~ScopedRealtimePriority() {
+        if (m_applied) pthread_setschedparam(pthread_self(), m_oldPolicy, &m_oldParam);
+    }
+    bool applied() const { return m_applied; }
+
+private:
+    bool m_applied = false;
+    int m_oldPolicy = SCHED_OTHER;
+    sched_param m_oldParam;
+};
+
+} // namespace
+
+const char* overrunPolicyName(OverrunPolicy policy) {
+    switch (policy) {
+    case OVERRUN_CATCH_UP: return "catchup";
+    case OVERRUN_DROP: return "drop";
+    case OVERRUN_STRETCH: return "stretch";
+    }
+    return "unknown";
+}
+
+bool parseOverrunPolicy(const char* name, OverrunPolicy& policy) {
+    const OverrunPolicy all[] = { OVERRUN_CATCH_UP, OVERRUN_DROP, OVERRUN_STRETCH };
+    for (OverrunPolicy p : all) {
+        if (std::strcmp(name, overrunPolicyName(p)) == 0) {
+            policy = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+RealTimeRunner::RealTimeRunner(const RealTimeConfig& config)
+    : m_config(config) {
+    if (!(m_config.timeScale > 0.0)) m_config.timeScale = 1.0;
+    if (m_config.spinMicros < 0.0) m_config.spinMicros = 0.0;
+}
+
+bool RealTimeRunner::run(double duration, const StepFunction& step) {
+    m_telemetry = FrameTelemetry();
+    m_stop.store(false, std::memory_order_relaxed);
+
+    const double dt = m_config.dt;
+    const int64_t period = std::max<int64_t>(1, std::llround(dt / m_config.timeScale * 1e9));
+    const int64_t spinNs = static_cast<int64_t>(m_config.spinMicros * 1e3);
+    m_telemetry.periodMicros = period / 1e3;
+
+    ScopedRealtimePriority priority(m_config.realtimePriority);
+    m_telemetry.priorityApplied = priority.applied();
+
+    LAERO_PROFILE_REGISTER_THREAD();    // 在禁止分配的步进之前登记计时线程
+
+    FrameTelemetry& t = m_telemetry;
+    int64_t origin = monotonicNs();     // 时间轴原点: 第 frame 帧的截止时刻为 origin + frame * period
+    int64_t frame = 0;
+    double simTime = 0.0;
+    bool done = !(simTime <= duration);
+
+    while (!done) {
+        const int64_t deadline = origin + frame * period;
+        waitUntil(deadline, spinNs);
+        t.jitterMicros.add((monotonicNs() - deadline) / 1e3);
+        ++t.frames;
+
+        unsigned catchUp = 0;
+        for (;;) {
+            // --- 一步 ---
+            const int64_t begin = monotonicNs();
+            bool keepGoing;
+            {
+                LAERO_NO_ALLOC_SCOPE();
+                keepGoing = step(simTime, dt);
+            }
+            const int64_t end = monotonicNs();
+            simTime += dt;
+            ++frame;
+            ++t.steps;
+            t.workMicros.add((end - begin) / 1e3);
+            if (end - begin > period) ++t.overruns;
+
+            if (!keepGoing || m_stop.load(std::memory_order_relaxed) || !(simTime <= duration)) {
+                done = true;
+                break;
+            }
+
+            // --- 是否赶上了下一帧的截止时刻 ---
+            const int64_t next = origin + frame * period;
+            if (end <= next) break;
+            ++t.missedDeadlines;
+            if (m_config.failOnOverrun) {
+                t.failed = true;
+                done = true;
+                break;
+            }
+            if (m_config.policy == OVERRUN_CATCH_UP && catchUp < m_config.maxCatchUpSteps) {
+                ++catchUp;
+                ++t.catchUpSteps;
+                continue;
+            }
+            if (m_config.policy == OVERRUN_DROP) {
+                // 丢弃已经开始的帧: 这些步不执行, 仿真时间照样前进 (逐步累加, 与非实时运行的时刻相同),
+                // 在原时间轴上的下一个截止时刻继续
+                const int64_t missed = (end - next) / period + 1;
+                frame += missed;
+                for (int64_t k = 0; k < missed; ++k) simTime += dt;
+                t.droppedFrames += static_cast<uint64_t>(missed);
+                if (!(simTime <= duration)) done = true;
+            } else {
+                // STRETCH (或补步达到上限): 时间轴整体后移, 下一帧立即开始
+                t.lagSeconds += (end - next) / 1e9;
+                origin += end - next;
+            }
+            break;
+        }
+        LAERO_PROFILE_COUNT(COUNTER_FRAME_STEPS, catchUp + 1);
+    }
+    return !t.failed;
+}
+
+void RealTimeRunner::writeTelemetry(std::ostream& out) const {
+    const FrameTelemetry& t = m_telemetry;
+    char line[256];
+    std::snprintf(line, sizeof(line), "real-time: policy %s, period %.1f us, %llu frames, %llu steps%s%s\n",
+                  overrunPolicyName(m_config.policy), t.periodMicros,
+                  static_cast<unsigned long long>(t.frames), static_cast<unsigned long long>(t.steps),
+                  t.priorityApplied ? ", SCHED_FIFO" : "", t.failed ? ", FAILED (deadline missed)" : "");
+    out << line;
+    std::snprintf(line, sizeof(line), "  work   mean %.1f us, max %.1f us, utilization mean %.1f%% peak %.1f%%\n",
+                  t.workMicros.mean(), t.workMicros.max(), t.meanUtilization() * 100.0, t.peakUtilization() * 100.0);
+    out << line;
+    std::snprintf(line, sizeof(line), "  jitter mean %.1f us, stddev %.1f us, max %.1f us\n",
+                  t.jitterMicros.mean(), t.jitterMicros.stddev(), t.jitterMicros.max());
+    out << line;
+    std::snprintf(line, sizeof(line),
+                  "  overruns %llu, missed deadlines %llu, catch-up steps %llu, dropped frames %llu, lag %.3f s\n",
+                  static_cast<unsigned long long>(t.overruns), static_cast<unsigned long long>(t.missedDeadlines),
+                  static_cast<unsigned long long>(t.catchUpSteps), static_cast<unsigned long long>(t.droppedFrames),
+                  t.lagSeconds);
+    out << line;
+}
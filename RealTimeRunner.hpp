@@ -0,0 +1,91 @@
+// RealTimeRunner.hpp
+#ifndef REAL_TIME_RUNNER_HPP
+#define REAL_TIME_RUNNER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include "TrackingStats.hpp"
+
+// 实时帧调度 (锁定墙钟运行, 用于硬件在环等场合)
+//
+// 第k帧的截止时刻为 t0 + k * 周期 (绝对时刻, CLOCK_MONOTONIC), 睡到截止时刻前 spinMicros 再忙等,
+// 然后调用 step(simTime, dt) 推进一步。周期 = dt / timeScale (timeScale = 1 为实时)。
+// 仿真按固定 dt 推进, simTime 的累加方式与 runTrackingScenario 相同。超时策略:
+//   OVERRUN_CATCH_UP  补步: 醒来时已错过的帧立即连续执行 (每次最多 maxCatchUpSteps 步), 回到原时间轴;
+//                     超过上限仍未追上时按 STRETCH 处理。
+//   OVERRUN_DROP      丢帧: 已错过的帧对应的仿真步不执行, simTime 照样前进 丢帧数 * dt, 下一步在原时间轴的
+//                     下一个截止时刻执行 (仿真时间不落后墙钟, 保持与外部60Hz I/O同相)。
+//   OVERRUN_STRETCH   拉伸: 从超时帧结束时刻重新建立时间轴, 仿真时间比墙钟落后超时的时长。
+// CATCH_UP 和 STRETCH 执行每一步, 仿真结果与非实时运行逐位相同; DROP 发生丢帧时跳过了这些步, 结果不同。
+// failOnOverrun 为 true 时第一次错过截止时刻就停止运行 (硬件在环中错过一帧即为失败)。
+
+enum OverrunPolicy {
+    OVERRUN_CATCH_UP = 0,
+    OVERRUN_DROP,
+    OVERRUN_STRETCH
+};
+
+const char* overrunPolicyName(OverrunPolicy policy);
+// "catchup" / "drop" / "stretch"; 无法识别时返回false
+bool parseOverrunPolicy(const char* name, OverrunPolicy& policy);
+
+struct RealTimeConfig {
+    double dt = 1.0 / 60.0;             // 仿真步长 (秒)
+    double timeScale = 1.0;             // 墙钟速度倍数 (2 为两倍速)
+    OverrunPolicy policy = OVERRUN_CATCH_UP;
+    unsigned maxCatchUpSteps = 4;       // 补步上限 (每次醒来)
+    double spinMicros = 200.0;          // 截止时刻前这段时间忙等而不睡眠, 降低唤醒抖动
+    bool failOnOverrun = false;
+    bool realtimePriority = false;      // 尝试以 SCHED_FIFO 运行 (需要权限, 失败时继续以普通优先级运行)
+};
+
+// 帧预算遥测
+struct FrameTelemetry {
+    uint64_t frames = 0;            // 醒来的次数 (每次醒来执行1步, 补步时更多)
+    uint64_t steps = 0;             // 执行的仿真步数
+    uint64_t overruns = 0;          // 计算时间超过帧周期的步数
+    uint64_t missedDeadlines = 0;   // 醒来时已错过下一帧截止时刻的次数
+    uint64_t catchUpSteps = 0;      // 补步执行的步数
+    uint64_t droppedFrames = 0;     // 丢弃的帧数 (DROP, 即未执行的仿真步数)
+    double lagSeconds = 0.0;        // 仿真时间落后墙钟的累计时长 (STRETCH, 或补步超过上限)
+    double periodMicros = 0.0;      // 帧周期 (墙钟)
+    RunningStats jitterMicros;      // 醒来时刻 - 截止时刻
+    RunningStats workMicros;        // 每步计算时间
+    bool priorityApplied = false;   // 是否成功切换到实时调度
+    bool failed = false;            // failOnOverrun 时是否因超时停止
+
+    // 最大单步计算时间占帧周期的比例
+    double peakUtilization() const { return periodMicros > 0.0 ? workMicros.max() / periodMicros : 0.0; }
+    double meanUtilization() const { return periodMicros > 0.0 ? workMicros.mean() / periodMicros : 0.0; }
+};
+
+class RealTimeRunner {
+public:
+    // step(simTime, dt) 推进一步; 返回 false 时停止
+    typedef std::function<bool(double simTime, double dt)> StepFunction;
+
+    explicit RealTimeRunner(const RealTimeConfig& config = RealTimeConfig());
+
+    const RealTimeConfig& config() const { return m_config; }
+
+    // 从 simTime = 0 运行到 simTime > duration (与 runTrackingScenario 的循环相同);
+    // 正常结束返回 true, failOnOverrun 超时返回 false
+    bool run(double duration, const StepFunction& step);
+
+    // 其他线程 (或 step 内) 请求在当前步之后停止
+    void requestStop() { m_stop.store(true, std::memory_order_relaxed); }
+
+    // 运行中 (在 step 内) 或运行后读取
+    const FrameTelemetry& telemetry() const { return m_telemetry; }
+
+    void writeTelemetry(std::ostream& out) const;
+
+private:
+    RealTimeConfig m_config;
+    FrameTelemetry m_telemetry;
+    std::atomic<bool> m_stop{false};
+};
+
+#endif // REAL_TIME_RUNNER_HPP
@@ -0,0 +1,62 @@
+// ScenarioArena.cpp
+#include "ScenarioArena.hpp"
+#include <algorithm>
+#include <new>
+
+namespace {
+
+const size_t BUFFER_ALIGNMENT = 64;   // 缓存行
+
+size_t alignUp(size_t n, size_t alignment) {
+    return (n + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+ScenarioArena::ScenarioArena(size_t capacity)
+    : m_capacity(capacity) {
+    if (m_capacity > 0) {
+        m_buffer = static_cast<unsigned char*>(::operator new(m_capacity, std::align_val_t(BUFFER_ALIGNMENT)));
+    }
+}
+
+ScenarioArena::~ScenarioArena() {
+    release();
+    if (m_buffer != nullptr) ::operator delete(m_buffer, std::align_val_t(BUFFER_ALIGNMENT));
+}
+
+void ScenarioArena::release() {
+    while (m_overflow != nullptr) {
+        OverflowBlock* next = m_overflow->next;
+        ::operator delete(m_overflow, std::align_val_t(m_overflow->alignment));
+        m_overflow = next;
+    }
+    m_used = 0;
+    m_overflowCount = 0;
+    m_overflowBytes = 0;
+}
+
+void* ScenarioArena::do_allocate(size_t bytes, size_t alignment) {
+    // 缓冲区起点按 BUFFER_ALIGNMENT 对齐, 更大的对齐要求按地址计算
+    const uintptr_t base = reinterpret_cast<uintptr_t>(m_buffer);
+    const size_t offset = alignUp(base + m_used, alignment) - base;
+    if (m_buffer != nullptr && offset <= m_capacity && bytes <= m_capacity - offset) {
+        m_used = offset + bytes;
+        return m_buffer + offset;
+    }
+
+    // 容量不足: 向堆申请, 块前放链表头部
+    const size_t blockAlignment = std::max(alignment, alignof(std::max_align_t));
+    const size_t header = alignUp(sizeof(OverflowBlock), blockAlignment);
+    OverflowBlock* block = static_cast<OverflowBlock*>(::operator new(header + bytes, std::align_val_t(blockAlignment)));
+    block->next = m_overflow;
+    block->alignment = blockAlignment;
+    m_overflow = block;
+    ++m_overflowCount;
+    m_overflowBytes += bytes;
+    return reinterpret_cast<unsigned char*>(block) + header;
+}
+
+void ScenarioArena::do_deallocate(void*, size_t, size_t) {
+    // 单调分配: 只在 release 或析构时统一归还
+}
@@ -0,0 +1,56 @@
+// ScenarioArena.hpp
+#ifndef SCENARIO_ARENA_HPP
+#define SCENARIO_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// 场景内存 (单调分配器)
+//
+// 构造时一次申请 capacity 字节, 之后的分配只移动指针, deallocate 不做任何事, 内存在 release() 或析构时统一归还。
+// 作为 std::pmr::memory_resource 交给轨迹 (createManeuverTrajectory)、机队状态 (LaeroFleet)
+// 和日志缓冲区 (StateLogger), 场景的堆内存在开始仿真前就确定下来, 上限即 capacity。
+// 容量不足时向堆申请并计入 overflowCount() (不失败), 说明场景规模估算偏小; 用 bytesFor 按元素数估算容量。
+// 不是线程安全的: 只应在构造场景时 (单线程) 分配, 步进循环中不再分配。
+class ScenarioArena : public std::pmr::memory_resource {
+public:
+    explicit ScenarioArena(size_t capacity);
+    ~ScenarioArena() override;
+
+    ScenarioArena(const ScenarioArena&) = delete;
+    ScenarioArena& operator=(const ScenarioArena&) = delete;
+
+    size_t capacity() const { return m_capacity; }
+    size_t used() const { return m_used; }              // 已分配字节 (含对齐填充, 不含溢出部分)
+    uint64_t overflowCount() const { return m_overflowCount; }
+    size_t overflowBytes() const { return m_overflowBytes; }
+
+    // 归还全部内存 (容量不变); 调用前所有使用本 arena 的容器都必须已析构
+    void release();
+
+    // n 个 T 所需字节 (含对齐余量), 用于估算容量
+    template<class T>
+    static size_t bytesFor(size_t n) { return n * sizeof(T) + alignof(T); }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    // 溢出块的头部 (链表, release 时逐个归还)
+    struct OverflowBlock {
+        OverflowBlock* next;
+        size_t alignment;
+    };
+
+    unsigned char* m_buffer = nullptr;
+    size_t m_capacity = 0;
+    size_t m_used = 0;
+    OverflowBlock* m_overflow = nullptr;
+    uint64_t m_overflowCount = 0;
+    size_t m_overflowBytes = 0;
+};
+
+#endif // SCENARIO_ARENA_HPP
@@ -0,0 +1,168 @@
+// ScenarioCoroutine.hpp
+#ifndef SCENARIO_COROUTINE_HPP
+#define SCENARIO_COROUTINE_HPP
+
+#include "ScenarioScript.hpp"
+
+// C++20 协程形式的任务脚本 (需要 -std=c++20; 不支持协程的编译器/标准下本文件为空, 只能用 MissionScript)
+//
+//   MissionTask patrol(MissionContext m) {
+//       m.commandAltitude(3000);
+//       co_await m.untilAltitude(3000);
+//       co_await m.delay(30);
+//       for (;;) {
+//           m.commandHeading(m.headingDeg() + 90);
+//           co_await m.untilHeading(m.commandedHeadingDeg());
+//           co_await m.delay(60);
+//       }
+//   }
+//
+//   std::vector<MissionTask> tasks;
+//   tasks.push_back(patrol(MissionContext(director, i)));
+//   tasks.back().start(startTime);
+//
+// 协程的第一个参数必须是 MissionContext (promise 从中取得调度器和飞机序号)。
+// co_await 把唤醒条件登记到 ScenarioDirector (与 MissionScript 的等待相同), 等待期间协程不被恢复。
+// 协程帧在创建时分配一次, 挂起/恢复不分配内存。MissionTask 拥有协程帧: 析构时取消调度器中的任务。
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include "LaeroFleet.hpp"
+#include "OeBase.hpp"
+
+// 协程中的飞机句柄: 下达指令、读取状态、构造等待
+class MissionContext {
+public:
+    MissionContext(ScenarioDirector& director, size_t aircraft)
+        : m_director(&director), m_aircraft(aircraft) {}
+
+    ScenarioDirector& director() const { return *m_director; }
+    size_t aircraft() const { return m_aircraft; }
+    double now() const { return m_director->now(); }
+
+    // --- 指令 (同 MissionScript: 性能参数为 0 (默认) 时取机队的 getCommandLimits()) ---
+    void commandAltitude(double meters, double aMps = 0.0, double maxPitchD = 0.0) const {
+        LaeroFleet& fleet = m_director->fleet();
+        const LaeroCommandLimits& limits = fleet.getCommandLimits();
+        fleet.setCommandedAltitude(m_aircraft, meters, laero_scenario::limitOr(aMps, limits.aMps),
+                                   laero_scenario::limitOr(maxPitchD, limits.maxPitchD));
+    }
+    void commandHeading(double degs, double hDps = 0.0, double maxBankD = 0.0) const {
+        LaeroFleet& fleet = m_director->fleet();
+        const LaeroCommandLimits& limits = fleet.getCommandLimits();
+        fleet.setCommandedHeadingD(m_aircraft, degs, laero_scenario::limitOr(hDps, limits.hDps),
+                                   laero_scenario::limitOr(maxBankD, limits.maxBankD));
+    }
+    void commandVelocity(double kts, double vNps = 0.0) const {
+        LaeroFleet& fleet = m_director->fleet();
+        fleet.setCommandedVelocityKts(m_aircraft, kts, laero_scenario::limitOr(vNps, fleet.getCommandLimits().vNps));
+    }
+    double commandedHeadingDeg() const { return m_director->fleet().column(LaeroFleet::CMD_HDG_D)[m_aircraft]; }
+
+    // --- 当前状态 ---
+    double altitudeM() const { return -m_director->fleet().column(LaeroFleet::POS_Z)[m_aircraft]; }
+    double headingDeg() const {
+        return oe_base::aepcdDeg(m_director->fleet().column(LaeroFleet::YAW)[m_aircraft] * oe_base::angle::R2DCC);
+    }
+
+    // --- 等待 (co_await) ---
+    struct Wait {
+        ScenarioDirector* director;
+        size_t aircraft;
+        uint8_t kind;
+        double target;
+        double tolerance;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<>) const {
+            switch (kind) {
+            case laero_scenario::WAIT_ALTITUDE: director->waitAltitude(aircraft, target, tolerance); break;
+            case laero_scenario::WAIT_HEADING: director->waitHeading(aircraft, target, tolerance); break;
+            case laero_scenario::WAIT_VELOCITY: director->waitVelocity(aircraft, target, tolerance); break;
+            default: director->sleepUntil(aircraft, target); break;
+            }
+        }
+        void await_resume() const noexcept {}
+    };
+
+    Wait delay(double seconds) const { return { m_director, m_aircraft, laero_scenario::WAIT_TIME, now() + seconds, 0.0 }; }
+    Wait untilTime(double time) const { return { m_director, m_aircraft, laero_scenario::WAIT_TIME, time, 0.0 }; }
+    Wait untilAltitude(double meters, double toleranceM = 10.0) const {
+        return { m_director, m_aircraft, laero_scenario::WAIT_ALTITUDE, meters, toleranceM };
+    }
+    Wait untilHeading(double degs, double toleranceDeg = 1.0) const {
+        return { m_director, m_aircraft, laero_scenario::WAIT_HEADING, degs, toleranceDeg };
+    }
+    Wait untilVelocity(double kts, double toleranceKts = 2.0) const {
+        return { m_director, m_aircraft, laero_scenario::WAIT_VELOCITY, kts, toleranceKts };
+    }
+
+private:
+    ScenarioDirector* m_director;
+    size_t m_aircraft;
+};
+
+// 协程任务 (只能移动)
+class MissionTask {
+public:
+    struct promise_type {
+        ScenarioDirector* director = nullptr;
+        size_t aircraft = 0;
+
+        template<class... Args>
+        explicit promise_type(const MissionContext& context, const Args&...)
+            : director(&context.director()), aircraft(context.aircraft()) {}
+
+        MissionTask get_return_object() { return MissionTask(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }   // 由 start 交给调度器后才开始执行
+        std::suspend_always final_suspend() noexcept { return {}; }     // 帧由 MissionTask 释放
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+    typedef std::coroutine_handle<promise_type> Handle;
+
+    MissionTask() = default;
+    MissionTask(MissionTask&& other) noexcept : m_handle(other.m_handle) { other.m_handle = Handle(); }
+    MissionTask& operator=(MissionTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_handle = other.m_handle;
+            other.m_handle = Handle();
+        }
+        return *this;
+    }
+    ~MissionTask() { reset(); }
+
+    // 在 startTime 开始执行 (取消该飞机已有的任务)
+    void start(double startTime = 0.0) {
+        promise_type& p = m_handle.promise();
+        p.director->attach(p.aircraft, resumeHandle, m_handle.address(), startTime);
+    }
+
+    bool done() const { return !m_handle || m_handle.done(); }
+
+private:
+    explicit MissionTask(Handle handle) : m_handle(handle) {}
+
+    void reset() {
+        if (!m_handle) return;
+        promise_type& p = m_handle.promise();
+        // 调度器中该飞机的任务仍是本协程时才取消 (可能已被 assign/attach 替换)
+        if (p.director->context(p.aircraft) == m_handle.address()) p.director->cancel(p.aircraft);
+        m_handle.destroy();
+        m_handle = Handle();
+    }
+
+    static void resumeHandle(ScenarioDirector&, size_t, void* context) {
+        std::coroutine_handle<>::from_address(context).resume();
+    }
+
+private:
+    Handle m_handle;
+};
+
+#endif // __cpp_impl_coroutine
+
+#endif // SCENARIO_COROUTINE_HPP
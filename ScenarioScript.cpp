@@ -0,0 +1,318 @@
+// ScenarioScript.cpp
+#include "ScenarioScript.hpp"
+#include "LaeroFleet.hpp"
+#include "OeBase.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace laero_scenario;
+
+namespace {
+
+const unsigned DEFAULT_POLL_FRAMES = 6;
+const double TIME_EPSILON = 1e-9;   // 帧时刻累加误差
+
+// 定时堆的比较: 唤醒晚的排在后面 (std::*_heap 为最大堆, 取反得到最小堆), 同时刻按飞机序号
+template<class Entry>
+bool wakesLater(const Entry& a, const Entry& b) {
+    return a.time > b.time || (a.time == b.time && a.aircraft > b.aircraft);
+}
+
+// 条件检查用到的状态列 (扫描一个桶期间不变)
+struct StateColumns {
+    const double* posZ;
+    const double* yaw;
+    const double* u;
+    const double* v;
+    const double* w;
+
+    explicit StateColumns(const LaeroFleet& fleet)
+        : posZ(fleet.column(LaeroFleet::POS_Z)), yaw(fleet.column(LaeroFleet::YAW)),
+          u(fleet.column(LaeroFleet::BODY_U)), v(fleet.column(LaeroFleet::BODY_V)), w(fleet.column(LaeroFleet::BODY_W)) {}
+};
+
+inline bool conditionMet(const StateColumns& c, size_t i, uint8_t kind, double target, double tolerance) {
+    switch (kind) {
+    case WAIT_ALTITUDE:
+        return std::fabs(-c.posZ[i] - target) <= tolerance;
+    case WAIT_HEADING:
+        return std::fabs(oe_base::aepcdDeg(c.yaw[i] * oe_base::angle::R2DCC - target)) <= tolerance;
+    case WAIT_VELOCITY:
+        return std::fabs(std::sqrt(c.u[i] * c.u[i] + c.v[i] * c.v[i] + c.w[i] * c.w[i]) * oe_base::units::MPS2KTS - target)
+               <= tolerance;
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+// ==============================================================
+// MissionScript
+// ==============================================================
+MissionScript& MissionScript::push(uint8_t code, double a, double b, double c) {
+    MissionOp op;
+    op.code = code;
+    op.a = a;
+    op.b = b;
+    op.c = c;
+    m_ops.push_back(op);
+    return *this;
+}
+
+MissionScript& MissionScript::commandAltitude(double meters, double aMps, double maxPitchD) {
+    return push(OP_COMMAND_ALTITUDE, meters, aMps, maxPitchD);
+}
+
+MissionScript& MissionScript::commandHeading(double degs, double hDps, double maxBankD) {
+    return push(OP_COMMAND_HEADING, degs, hDps, maxBankD);
+}
+
+MissionScript& MissionScript::commandVelocity(double kts, double vNps) {
+    return push(OP_COMMAND_VELOCITY, kts, vNps);
+}
+
+MissionScript& MissionScript::wait(double seconds) {
+    return push(OP_WAIT_SECONDS, seconds);
+}
+
+MissionScript& MissionScript::waitAltitude(double meters, double toleranceM) {
+    return push(OP_WAIT_ALTITUDE, meters, toleranceM);
+}
+
+MissionScript& MissionScript::waitHeading(double degs, double toleranceDeg) {
+    return push(OP_WAIT_HEADING, degs, toleranceDeg);
+}
+
+MissionScript& MissionScript::waitVelocity(double kts, double toleranceKts) {
+    return push(OP_WAIT_VELOCITY, kts, toleranceKts);
+}
+
+MissionScript& MissionScript::jump(size_t op) {
+    return push(OP_JUMP, static_cast<double>(op));
+}
+
+bool MissionScript::valid() const {
+    for (size_t i = 0; i < m_ops.size(); ++i) {
+        if (m_ops[i].code == OP_WAIT_SECONDS && !(m_ops[i].a > 0.0)) return false;
+        if (m_ops[i].code != OP_JUMP) continue;
+        const size_t target = static_cast<size_t>(m_ops[i].a);
+        if (target >= i) return false;
+        bool waits = false;
+        for (size_t k = target; k < i && !waits; ++k) {
+            waits = m_ops[k].code >= OP_WAIT_SECONDS && m_ops[k].code <= OP_WAIT_VELOCITY;
+        }
+        if (!waits) return false;
+    }
+    return true;
+}
+
+// ==============================================================
+// ScenarioDirector
+// ==============================================================
+ScenarioDirector::ScenarioDirector(LaeroFleet& fleet)
+    : m_fleet(fleet), m_buckets(DEFAULT_POLL_FRAMES) {
+}
+
+void ScenarioDirector::setConditionPollFrames(unsigned frames) {
+    frames = std::max(frames, 1u);
+    std::vector<ConditionEntry> entries;
+    for (const auto& bucket : m_buckets) entries.insert(entries.end(), bucket.begin(), bucket.end());
+    m_buckets.assign(frames, std::vector<ConditionEntry>());
+    for (const ConditionEntry& e : entries) m_buckets[e.aircraft % frames].push_back(e);
+}
+
+void ScenarioDirector::reserve(size_t aircraftCount) {
+    if (m_tasks.size() < aircraftCount) {
+        m_tasks.resize(aircraftCount);
+        m_generations.resize(aircraftCount, 0);
+    }
+    m_timers.reserve(aircraftCount);
+    m_pendingTimers.reserve(aircraftCount);
+    m_pendingConditions.reserve(aircraftCount);
+    m_woken.reserve(aircraftCount);
+    const size_t perBucket = (aircraftCount + m_buckets.size() - 1) / m_buckets.size();
+    for (auto& bucket : m_buckets) bucket.reserve(perBucket);
+}
+
+ScenarioDirector::Task& ScenarioDirector::task(size_t aircraft) {
+    if (aircraft >= m_tasks.size()) {
+        m_tasks.resize(aircraft + 1);
+        m_generations.resize(aircraft + 1, 0);
+    }
+    return m_tasks[aircraft];
+}
+
+bool ScenarioDirector::assign(size_t aircraft, const MissionScript& script, double startTime) {
+    if (!script.valid()) return false;
+    attach(aircraft, runScript, const_cast<MissionScript*>(&script), startTime);
+    return true;
+}
+
+void ScenarioDirector::attach(size_t aircraft, ResumeFunction resume, void* context, double startTime) {
+    cancel(aircraft);
+    Task& t = task(aircraft);
+    t.resume = resume;
+    t.context = context;
+    t.pc = 0;
+    ++m_active;
+    sleepUntil(aircraft, startTime);
+}
+
+void ScenarioDirector::cancel(size_t aircraft) {
+    Task& t = task(aircraft);
+    if (t.resume == nullptr) return;
+
+    // 堆和桶里的条目靠 generation 作废, 在弹出/检查时丢弃
+    if (t.wait == WAIT_TIME) --m_timerWaiting;
+    else if (t.wait != WAIT_NONE) --m_conditionWaiting;
+    ++m_generations[aircraft];
+    t.wait = WAIT_NONE;
+    t.resume = nullptr;
+    t.context = nullptr;
+    --m_active;
+}
+
+void ScenarioDirector::sleepUntil(size_t aircraft, double time) {
+    m_tasks[aircraft].wait = WAIT_TIME;
+    ++m_timerWaiting;
+
+    TimerEntry e;
+    e.time = time;
+    e.aircraft = static_cast<uint32_t>(aircraft);
+    e.generation = ++m_generations[aircraft];
+    // 先放入待定列表: 本次 step 不会弹出它, 避免 wait(0) 之类的循环在一帧内反复唤醒
+    m_pendingTimers.push_back(e);
+}
+
+void ScenarioDirector::waitAltitude(size_t aircraft, double meters, double toleranceM) {
+    waitCondition(aircraft, WAIT_ALTITUDE, meters, toleranceM);
+}
+
+void ScenarioDirector::waitHeading(size_t aircraft, double degs, double toleranceDeg) {
+    waitCondition(aircraft, WAIT_HEADING, degs, toleranceDeg);
+}
+
+void ScenarioDirector::waitVelocity(size_t aircraft, double kts, double toleranceKts) {
+    waitCondition(aircraft, WAIT_VELOCITY, kts, toleranceKts);
+}
+
+void ScenarioDirector::waitCondition(size_t aircraft, uint8_t kind, double target, double tolerance) {
+    m_tasks[aircraft].wait = kind;
+    ++m_conditionWaiting;
+
+    // 先放入待定列表: 本帧正在扫描的桶不会再检查它, 避免条件一直成立的循环在一帧内反复唤醒
+    ConditionEntry e;
+    e.aircraft = static_cast<uint32_t>(aircraft);
+    e.generation = ++m_generations[aircraft];
+    e.kind = kind;
+    e.target = target;
+    e.tolerance = tolerance;
+    m_pendingConditions.push_back(e);
+}
+
+void ScenarioDirector::resume(size_t aircraft) {
+    Task& t = m_tasks[aircraft];
+    t.wait = WAIT_NONE;
+    const uint32_t generation = m_generations[aircraft];
+    ++m_resumes;
+    t.resume(*this, aircraft, t.context);
+
+    // 恢复函数可能登记了其他飞机的任务 (m_tasks 可能重新分配), 重新取引用
+    Task& after = m_tasks[aircraft];
+    if (m_generations[aircraft] == generation && after.wait == WAIT_NONE && after.resume != nullptr) {
+        after.resume = nullptr;
+        after.context = nullptr;
+        --m_active;
+    }
+}
+
+void ScenarioDirector::step(double now) {
+    m_now = now;
+
+    // 上次 step 开始后登记的定时等待放入堆中; 本次 step 中登记的留到下一帧
+    for (const TimerEntry& e : m_pendingTimers) {
+        m_timers.push_back(e);
+        std::push_heap(m_timers.begin(), m_timers.end(), wakesLater<TimerEntry>);
+    }
+    m_pendingTimers.clear();
+
+    // 条件等待: 只检查本帧的桶。先原地压缩 (保持按飞机序号的顺序) 并记下满足条件的飞机, 再逐个恢复,
+    // 扫描循环中不调用恢复函数, 状态列指针和计数器可以留在寄存器中
+    std::vector<ConditionEntry>& bucket = m_buckets[m_frame % m_buckets.size()];
+    const StateColumns columns(m_fleet);
+    const uint32_t* generations = m_generations.data();
+    size_t kept = 0;
+    size_t checks = 0;
+    m_woken.clear();
+    for (size_t k = 0; k < bucket.size(); ++k) {
+        const ConditionEntry& e = bucket[k];
+        if (e.generation != generations[e.aircraft]) continue;     // 已取消
+        ++checks;
+        if (conditionMet(columns, e.aircraft, e.kind, e.target, e.tolerance)) {
+            WokenEntry w;
+            w.aircraft = e.aircraft;
+            w.generation = e.generation;
+            m_woken.push_back(w);
+        } else {
+            bucket[kept++] = e;
+        }
+    }
+    bucket.resize(kept);
+    m_checks += checks;
+    // 已唤醒的任务不再处于条件等待: 之后在本帧被取消时不重复计数
+    for (const WokenEntry& w : m_woken) m_tasks[w.aircraft].wait = WAIT_NONE;
+    m_conditionWaiting -= m_woken.size();
+    for (const WokenEntry& w : m_woken) {
+        if (w.generation != m_generations[w.aircraft]) continue;   // 先恢复的任务取消或重新登记了它
+        resume(w.aircraft);
+    }
+
+    // 定时等待: 弹出所有到期的条目 (恢复时新登记的在 m_pendingTimers 中, 不在本帧处理)
+    while (!m_timers.empty() && m_timers.front().time <= now + TIME_EPSILON) {
+        std::pop_heap(m_timers.begin(), m_timers.end(), wakesLater<TimerEntry>);
+        const TimerEntry e = m_timers.back();
+        m_timers.pop_back();
+        if (e.generation != m_generations[e.aircraft]) continue;
+        --m_timerWaiting;
+        resume(e.aircraft);
+    }
+
+    // 按飞机序号排序后放入桶中: 检查时按序访问状态列
+    std::sort(m_pendingConditions.begin(), m_pendingConditions.end(),
+              [](const ConditionEntry& a, const ConditionEntry& b) { return a.aircraft < b.aircraft; });
+    for (const ConditionEntry& e : m_pendingConditions) {
+        m_buckets[e.aircraft % m_buckets.size()].push_back(e);
+    }
+    m_pendingConditions.clear();
+    ++m_frame;
+}
+
+// MissionScript 的恢复函数: 从上次的指令序号执行到下一个等待
+void ScenarioDirector::runScript(ScenarioDirector& director, size_t aircraft, void* context) {
+    const MissionScript& script = *static_cast<const MissionScript*>(context);
+    LaeroFleet& fleet = director.m_fleet;
+    const LaeroCommandLimits& limits = fleet.getCommandLimits();
+    uint32_t pc = director.m_tasks[aircraft].pc;
+
+    while (pc < script.size()) {
+        const MissionOp& op = script.op(pc++);
+        director.m_tasks[aircraft].pc = pc;
+        switch (op.code) {
+        case OP_COMMAND_ALTITUDE:
+            fleet.setCommandedAltitude(aircraft, op.a, limitOr(op.b, limits.aMps), limitOr(op.c, limits.maxPitchD));
+            break;
+        case OP_COMMAND_HEADING:
+            fleet.setCommandedHeadingD(aircraft, op.a, limitOr(op.b, limits.hDps), limitOr(op.c, limits.maxBankD));
+            break;
+        case OP_COMMAND_VELOCITY: fleet.setCommandedVelocityKts(aircraft, op.a, limitOr(op.b, limits.vNps)); break;
+        case OP_WAIT_SECONDS: director.sleepFor(aircraft, op.a); return;
+        case OP_WAIT_ALTITUDE: director.waitAltitude(aircraft, op.a, op.b); return;
+        case OP_WAIT_HEADING: director.waitHeading(aircraft, op.a, op.b); return;
+        case OP_WAIT_VELOCITY: director.waitVelocity(aircraft, op.a, op.b); return;
+        case OP_JUMP: pc = static_cast<uint32_t>(op.a); break;
+        default: break;
+        }
+    }
+    director.m_tasks[aircraft].pc = pc;
+}
@@ -0,0 +1,192 @@
+// ScenarioScript.hpp
+#ifndef SCENARIO_SCRIPT_HPP
+#define SCENARIO_SCRIPT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class LaeroFleet;
+
+// 场景脚本 (每架飞机一个任务, 由 ScenarioDirector 在等待条件满足时唤醒)
+//
+// 任务 = 依次下达指令, 中间等待 "到达高度/航向/速度" 或 "经过若干秒"。LaeroFleet 会保存指令,
+// 所以等待中的飞机不需要每帧重新下达指令, 调度器也不碰它们:
+//   - 定时等待放在按唤醒时刻排序的最小堆里, 每帧只看堆顶, 与等待中的任务数无关
+//   - 条件等待每 conditionPollFrames 帧检查一次 (按飞机序号分到不同帧), 每次检查读一个状态列
+//   - 已结束的任务没有任何开销
+// 唤醒后脚本一直执行到下一个等待 (或结束) 为止, 其间下达的指令在随后的 fleet.update 中生效。
+//
+// 任务有两种写法:
+//   - MissionScript: 指令表, 用链式接口构造, 可被任意多架飞机共享 (每架只有一个指令序号)
+//   - C++20 协程 (ScenarioCoroutine.hpp): co_await 等待条件, 适合带分支/循环的复杂逻辑
+// 两者都建立在 ScenarioDirector 的低层接口 (attach + sleepUntil/wait*) 上。
+
+namespace laero_scenario {
+
+enum OpCode {
+    OP_COMMAND_ALTITUDE = 0,    // a = 高度(米), b = aMps, c = maxPitchD
+    OP_COMMAND_HEADING,         // a = 航向(度), b = hDps, c = maxBankD
+    OP_COMMAND_VELOCITY,        // a = 速度(节), b = vNps
+    OP_WAIT_SECONDS,            // a = 秒 (> 0)
+    OP_WAIT_ALTITUDE,           // a = 高度(米), b = 容差(米)
+    OP_WAIT_HEADING,            // a = 航向(度), b = 容差(度)
+    OP_WAIT_VELOCITY,           // a = 速度(节), b = 容差(节)
+    OP_JUMP                     // a = 目标指令序号 (只能跳回前面的指令, 且循环内必须有等待)
+};
+
+enum WaitKind {
+    WAIT_NONE = 0,
+    WAIT_TIME,
+    WAIT_ALTITUDE,
+    WAIT_HEADING,
+    WAIT_VELOCITY
+};
+
+// 指令性能参数: 给出的值 (> 0), 或机队的缺省值
+inline double limitOr(double value, double fleetValue) { return value > 0.0 ? value : fleetValue; }
+
+} // namespace laero_scenario
+
+struct MissionOp {
+    uint8_t code = laero_scenario::OP_WAIT_SECONDS;
+    double a = 0.0;
+    double b = 0.0;
+    double c = 0.0;
+};
+
+// 指令表形式的任务脚本
+//   MissionScript patrol;
+//   patrol.commandAltitude(3000).waitAltitude(3000).wait(30).commandHeading(90).waitHeading(90).jump(0);
+class MissionScript {
+public:
+    // 指令 (参数同 LaeroFleet::setCommanded*); 性能参数为 0 (默认) 时取机队的 getCommandLimits()
+    MissionScript& commandAltitude(double meters, double aMps = 0.0, double maxPitchD = 0.0);
+    MissionScript& commandHeading(double degs, double hDps = 0.0, double maxBankD = 0.0);
+    MissionScript& commandVelocity(double kts, double vNps = 0.0);
+
+    // 等待
+    MissionScript& wait(double seconds);
+    MissionScript& waitAltitude(double meters, double toleranceM = 10.0);
+    MissionScript& waitHeading(double degs, double toleranceDeg = 1.0);
+    MissionScript& waitVelocity(double kts, double toleranceKts = 2.0);
+
+    // 跳回第 op 条指令 (循环巡逻)
+    MissionScript& jump(size_t op);
+
+    // 跳转目标在已有指令之前、循环内含有等待、且 wait 的秒数 > 0 时有效 (否则一次唤醒会无限循环)
+    bool valid() const;
+
+    size_t size() const { return m_ops.size(); }
+    const MissionOp& op(size_t i) const { return m_ops[i]; }
+
+private:
+    MissionScript& push(uint8_t code, double a, double b = 0.0, double c = 0.0);
+
+private:
+    std::vector<MissionOp> m_ops;
+};
+
+// 场景调度器: 持有每架飞机的任务状态, 在每帧 fleet.update 之前调用 step(now)
+class ScenarioDirector {
+public:
+    // 任务的恢复函数: 执行到下一次等待 (调用 sleepUntil/wait*) 后返回; 返回时没有登记等待则任务结束
+    typedef void (*ResumeFunction)(ScenarioDirector& director, size_t aircraft, void* context);
+
+    explicit ScenarioDirector(LaeroFleet& fleet);
+
+    LaeroFleet& fleet() { return m_fleet; }
+    double now() const { return m_now; }
+
+    // 条件等待的检查周期 (帧数, 默认6: 60Hz时唤醒延迟不超过0.1秒); 1 为每帧检查
+    void setConditionPollFrames(unsigned frames);
+    unsigned conditionPollFrames() const { return static_cast<unsigned>(m_buckets.size()); }
+
+    // 按机队规模预留任务表、定时堆和条件桶, 之后 step 不分配内存
+    void reserve(size_t aircraftCount);
+
+    // --- 高层接口: 指令表 ---
+    // 第 aircraft 架飞机在 startTime 开始执行 script (script 必须比调度器存活更久); script 无效时返回 false
+    // 已有的任务 (包括等待中的) 被取消
+    bool assign(size_t aircraft, const MissionScript& script, double startTime = 0.0);
+
+    // --- 低层接口: 任意可恢复任务 ---
+    // 在 startTime 第一次调用 resume(director, aircraft, context)
+    void attach(size_t aircraft, ResumeFunction resume, void* context, double startTime = 0.0);
+    void cancel(size_t aircraft);
+    // 第 aircraft 架飞机当前任务的 context (没有任务时为 nullptr)
+    void* context(size_t aircraft) const { return aircraft < m_tasks.size() ? m_tasks[aircraft].context : nullptr; }
+
+    // 只能在恢复函数中调用, 登记本次挂起的唤醒条件
+    void sleepUntil(size_t aircraft, double time);
+    void sleepFor(size_t aircraft, double seconds) { sleepUntil(aircraft, m_now + seconds); }
+    void waitAltitude(size_t aircraft, double meters, double toleranceM);
+    void waitHeading(size_t aircraft, double degs, double toleranceDeg);
+    void waitVelocity(size_t aircraft, double kts, double toleranceKts);
+
+    // 唤醒所有到期的任务 (now 必须单调不减)
+    void step(double now);
+
+    // --- 统计 ---
+    size_t activeCount() const { return m_active; }            // 未结束的任务
+    size_t timerCount() const { return m_timerWaiting; }       // 定时等待中的任务
+    size_t conditionCount() const { return m_conditionWaiting; }
+    uint64_t resumeCount() const { return m_resumes; }          // 累计唤醒次数
+    uint64_t conditionChecks() const { return m_checks; }       // 累计条件检查次数
+
+private:
+    struct Task {
+        ResumeFunction resume = nullptr;
+        void* context = nullptr;
+        uint32_t pc = 0;            // MissionScript 的指令序号
+        uint8_t wait = laero_scenario::WAIT_NONE;
+    };
+
+    struct TimerEntry {
+        double time;
+        uint32_t aircraft;
+        uint32_t generation;
+    };
+
+    // 条件放在条目中: 检查时只读条目和一个状态列 (以及紧凑的 generation 数组)
+    struct ConditionEntry {
+        uint32_t aircraft;
+        uint32_t generation;
+        uint8_t kind;
+        double target;
+        double tolerance;
+    };
+
+    // 本帧条件满足的飞机; 恢复前先核对 generation (先恢复的任务可能取消或重新登记了它)
+    struct WokenEntry {
+        uint32_t aircraft;
+        uint32_t generation;
+    };
+
+    Task& task(size_t aircraft);
+    void waitCondition(size_t aircraft, uint8_t kind, double target, double tolerance);
+    void resume(size_t aircraft);
+
+    static void runScript(ScenarioDirector& director, size_t aircraft, void* context);
+
+private:
+    LaeroFleet& m_fleet;
+    double m_now = 0.0;
+    uint64_t m_frame = 0;
+
+    std::vector<Task> m_tasks;
+    std::vector<uint32_t> m_generations;                // 每次登记/取消加一, 堆和桶里的旧条目据此作废
+    std::vector<TimerEntry> m_timers;                   // 最小堆 (按唤醒时刻, 同时刻按飞机序号)
+    std::vector<TimerEntry> m_pendingTimers;            // 上次 step 开始后登记的定时等待, 下次 step 开始时放入堆中
+    std::vector<std::vector<ConditionEntry>> m_buckets; // 条件等待按 飞机序号 % N 分桶, 第 frame % N 个桶在该帧检查
+    std::vector<ConditionEntry> m_pendingConditions;    // 本帧新登记的条件等待, 帧末放入桶中
+    std::vector<WokenEntry> m_woken;                    // 本帧条件满足、待恢复的飞机
+
+    size_t m_active = 0;
+    size_t m_timerWaiting = 0;
+    size_t m_conditionWaiting = 0;
+    uint64_t m_resumes = 0;
+    uint64_t m_checks = 0;
+};
+
+#endif // SCENARIO_SCRIPT_HPP
@@ -0,0 +1,249 @@
+// SharedState.cpp
+#include "SharedState.hpp"
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+size_t slotBytes(size_t capacity) {
+    const size_t bytes = sizeof(SharedStateSlot) + capacity * sizeof(AircraftState);
+    return (bytes + 63) / 64 * 64;
+}
+
+size_t regionBytes(size_t capacity) {
+    return sizeof(SharedStateHeader) + 2 * slotBytes(capacity);
+}
+
+} // namespace
+
+// ==============================================================
+// SharedStatePublisher
+// ==============================================================
+SharedStatePublisher::SharedStatePublisher() {
+}
+
+SharedStatePublisher::~SharedStatePublisher() {
+    close();
+}
+
+bool SharedStatePublisher::fail(const std::string& msg) {
+    m_error = msg;
+    close();
+    return false;
+}
+
+bool SharedStatePublisher::create(const std::string& name, size_t capacity) {
+    close();
+    m_error.clear();
+    if (capacity == 0) return fail("capacity must be positive");
+
+    // 总是新建对象: 仍映射着旧对象的读者不会因为 ftruncate 收到 SIGBUS
+    ::shm_unlink(name.c_str());
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) return fail("cannot create shared memory " + name);
+    m_name = name;
+
+    m_length = regionBytes(capacity);
+    if (::ftruncate(fd, static_cast<off_t>(m_length)) != 0) {
+        ::close(fd);
+        return fail("cannot resize shared memory " + name);
+    }
+
+    void* base = ::mmap(nullptr, m_length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) return fail("mmap failed for " + name);
+    m_base = base;
+    m_capacity = capacity;
+
+    // --- 初始化 (新对象内容为0) ---
+    char* bytes = static_cast<char*>(m_base);
+    m_header = reinterpret_cast<SharedStateHeader*>(bytes);
+    m_header->version = SHARED_STATE_VERSION;
+    m_header->headerSize = sizeof(SharedStateHeader);
+    m_header->recordSize = sizeof(AircraftState);
+    m_header->capacity = capacity;
+    for (int k = 0; k < 2; ++k) {
+        m_header->slotOffset[k] = sizeof(SharedStateHeader) + k * slotBytes(capacity);
+        new (bytes + m_header->slotOffset[k]) SharedStateSlot();
+    }
+    new (&m_header->latest) std::atomic<uint64_t>(SHARED_STATE_NO_SLOT);
+
+    // 魔数最后写入: 读者看到魔数时其余字段已经就绪
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(m_header->magic, SHARED_STATE_MAGIC, sizeof(m_header->magic));
+    m_frame = 0;
+    return true;
+}
+
+void SharedStatePublisher::close(bool unlink) {
+    if (m_base != nullptr) {
+        ::munmap(m_base, m_length);
+    }
+    if (unlink && !m_name.empty()) {
+        ::shm_unlink(m_name.c_str());
+    }
+    m_base = nullptr;
+    m_length = 0;
+    m_capacity = 0;
+    m_name.clear();
+    m_header = nullptr;
+    m_writing = nullptr;
+}
+
+AircraftState* SharedStatePublisher::beginSlot(double simTime, size_t count) {
+    if (m_base == nullptr) return nullptr;
+
+    // 交替使用两个槽, 读者正在读的 latest 槽在这一帧不会被改写
+    char* bytes = static_cast<char*>(m_base);
+    m_writing = reinterpret_cast<SharedStateSlot*>(bytes + m_header->slotOffset[m_frame & 1]);
+
+    const uint64_t seq = m_writing->seq.load(std::memory_order_relaxed);
+    m_writing->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_writing->frame = m_frame + 1;
+    m_writing->simTime = simTime;
+    m_writing->count = (count < m_capacity) ? count : m_capacity;
+    return reinterpret_cast<AircraftState*>(m_writing + 1);
+}
+
+void SharedStatePublisher::endSlot() {
+    m_writing->seq.fetch_add(1, std::memory_order_release);
+    m_header->latest.store(m_frame & 1, std::memory_order_release);
+    ++m_frame;
+    m_writing = nullptr;
+}
+
+void SharedStatePublisher::publish(double simTime, const AircraftState* states, size_t count) {
+    AircraftState* records = beginSlot(simTime, count);
+    if (records == nullptr) return;
+    std::memcpy(static_cast<void*>(records), states, m_writing->count * sizeof(AircraftState));
+    endSlot();
+}
+
+// ==============================================================
+// SharedStateReader
+// ==============================================================
+SharedStateReader::SharedStateReader() {
+}
+
+SharedStateReader::~SharedStateReader() {
+    close();
+}
+
+bool SharedStateReader::fail(const std::string& msg) {
+    m_error = msg;
+    close();
+    return false;
+}
+
+bool SharedStateReader::open(const std::string& name) {
+    close();
+    m_error.clear();
+
+    const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return fail("cannot open shared memory " + name);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return fail("cannot stat shared memory " + name);
+    }
+    m_length = static_cast<size_t>(st.st_size);
+    if (m_length < sizeof(SharedStateHeader)) {
+        ::close(fd);
+        return fail("shared memory too small for header");
+    }
+
+    void* base = ::mmap(nullptr, m_length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) return fail("mmap failed for " + name);
+    m_base = base;
+
+    // --- 校验头部 ---
+    m_header = static_cast<const SharedStateHeader*>(m_base);
+    if (std::memcmp(m_header->magic, SHARED_STATE_MAGIC, sizeof(m_header->magic)) != 0) return fail("bad magic (publisher not ready?)");
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_header->version != SHARED_STATE_VERSION) return fail("unsupported version");
+    if (m_header->headerSize != sizeof(SharedStateHeader)) return fail("header size mismatch");
+    if (m_header->recordSize != sizeof(AircraftState)) return fail("record size mismatch");
+    if (regionBytes(static_cast<size_t>(m_header->capacity)) > m_length) return fail("slots out of range");
+    for (int k = 0; k < 2; ++k) {
+        if (m_header->slotOffset[k] % alignof(SharedStateSlot) != 0 ||
+            m_header->slotOffset[k] + slotBytes(static_cast<size_t>(m_header->capacity)) > m_length) {
+            return fail("slot offset out of range");
+        }
+    }
+    return true;
+}
+
+void SharedStateReader::close() {
+    if (m_base != nullptr) {
+        ::munmap(m_base, m_length);
+    }
+    m_base = nullptr;
+    m_length = 0;
+    m_header = nullptr;
+}
+
+size_t SharedStateReader::capacity() const {
+    return m_header ? static_cast<size_t>(m_header->capacity) : 0;
+}
+
+bool SharedStateReader::acquire(View& view) const {
+    if (m_header == nullptr) return false;
+    const uint64_t latest = m_header->latest.load(std::memory_order_acquire);
+    if (latest > 1) return false;
+
+    const char* bytes = static_cast<const char*>(m_base);
+    const SharedStateSlot* slot = reinterpret_cast<const SharedStateSlot*>(bytes + m_header->slotOffset[latest]);
+    view.seq = slot->seq.load(std::memory_order_acquire);
+    if (view.seq & 1) return false;
+
+    view.slot = slot;
+    view.frame = slot->frame;
+    view.simTime = slot->simTime;
+    view.count = (slot->count < m_header->capacity) ? static_cast<size_t>(slot->count) : static_cast<size_t>(m_header->capacity);
+    view.states = reinterpret_cast<const AircraftState*>(slot + 1);
+    return true;
+}
+
+bool SharedStateReader::validate(const View& view) const {
+    if (view.slot == nullptr) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return view.slot->seq.load(std::memory_order_relaxed) == view.seq;
+}
+
+bool SharedStateReader::read(std::vector<AircraftState>& out, double* simTime, uint64_t* frame, int maxRetries) const {
+    for (int attempt = 0; attempt <= maxRetries; ++attempt) {
+        View view;
+        if (!acquire(view)) {
+            if (m_header == nullptr || m_header->latest.load(std::memory_order_acquire) > 1) return false;
+            continue;   // 读者落后一整圈, 槽正在被改写
+        }
+        out.resize(view.count);
+        std::memcpy(static_cast<void*>(out.data()), view.states, view.count * sizeof(AircraftState));
+        if (validate(view)) {
+            if (simTime) *simTime = view.simTime;
+            if (frame) *frame = view.frame;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t SharedStateReader::latestFrame() const {
+    View view;
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        if (!acquire(view)) {
+            if (m_header == nullptr || m_header->latest.load(std::memory_order_acquire) > 1) return 0;
+            continue;
+        }
+        if (validate(view)) return view.frame;
+    }
+    return 0;
+}
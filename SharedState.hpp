@@ -0,0 +1,152 @@
+// SharedState.hpp
+#ifndef SHARED_STATE_HPP
+#define SHARED_STATE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "AircraftState.hpp"
+
+// 通过 POSIX 共享内存实时发布机队状态
+//
+// 仿真进程每帧把所有飞机的 AircraftState 写入共享内存 (/dev/shm/<name>), 同一台机器上的可视化、
+// 分析、决策进程直接映射读取: 没有序列化, 没有系统调用, 发布方从不加锁也从不等待读者。
+//
+// 布局 (本机字节序):
+//   [0]                  SharedStateHeader (64字节)
+//   [slotOffset[k]]      SharedStateSlot (64字节) + AircraftState[capacity], k = 0, 1
+//
+// 双缓冲 + 顺序锁 (seqlock): 发布方交替写两个槽, 写之前把槽的 seq 加1 (奇数表示正在写),
+// 写完再加1, 然后把 header.latest 指向该槽。读者读 latest 指向的槽, 读前读后 seq 相同且为偶数
+// 则数据完整, 否则重试。一个槽在下一帧不会被改写, 读者有一整帧的时间完成读取。
+
+const char SHARED_STATE_MAGIC[8] = { 'L', 'A', 'E', 'R', 'O', 'S', 'H', 'M' };
+const uint32_t SHARED_STATE_VERSION = 1;
+
+static_assert(std::is_trivially_copyable<AircraftState>::value, "AircraftState must be trivially copyable");
+static_assert(sizeof(AircraftState) == 15 * sizeof(double), "AircraftState layout changed");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory needs lock-free 64-bit atomics");
+
+struct SharedStateHeader {
+    char     magic[8];              // SHARED_STATE_MAGIC
+    uint32_t version;               // SHARED_STATE_VERSION
+    uint32_t headerSize;            // sizeof(SharedStateHeader)
+    uint32_t recordSize;            // sizeof(AircraftState)
+    uint32_t reserved0;
+    uint64_t capacity;              // 每个槽最多的飞机数
+    uint64_t slotOffset[2];         // 两个槽的起始偏移
+    std::atomic<uint64_t> latest;   // 最近写完的槽号 (0/1); 尚未发布时为 SHARED_STATE_NO_SLOT
+    uint64_t reserved1;
+};
+
+struct alignas(64) SharedStateSlot {
+    std::atomic<uint64_t> seq;      // 奇数: 正在写
+    uint64_t frame;                 // 发布序号 (从1开始)
+    double   simTime;               // 仿真时间 (秒)
+    uint64_t count;                 // 本帧飞机数
+};
+
+static_assert(sizeof(SharedStateHeader) == 64, "SharedStateHeader layout changed");
+static_assert(sizeof(SharedStateSlot) == 64, "SharedStateSlot layout changed");
+
+const uint64_t SHARED_STATE_NO_SLOT = ~uint64_t(0);
+
+// --- 发布方 (仿真进程) ---
+class SharedStatePublisher {
+public:
+    SharedStatePublisher();
+    ~SharedStatePublisher();
+
+    SharedStatePublisher(const SharedStatePublisher&) = delete;
+    SharedStatePublisher& operator=(const SharedStatePublisher&) = delete;
+
+    // 创建 (或重建) 名为 name 的共享内存, 例如 "/laero_fleet"; 失败时返回false, 原因见 lastError()
+    bool create(const std::string& name, size_t capacity);
+    // 解除映射; unlink 为 true 时同时删除共享内存对象
+    void close(bool unlink = true);
+    bool isOpen() const { return m_base != nullptr; }
+
+    size_t capacity() const { return m_capacity; }
+    uint64_t frame() const { return m_frame; }
+
+    // 发布一帧; 超出容量的飞机被忽略
+    void publish(double simTime, const AircraftState* states, size_t count);
+
+    // 按序号取状态: getState(i) 返回 const AircraftState& (例如 models[i].getState())
+    template<class GetState>
+    void publish(double simTime, size_t count, GetState&& getState) {
+        AircraftState* records = beginSlot(simTime, count);
+        if (records == nullptr) return;
+        const size_t n = (count < m_capacity) ? count : m_capacity;
+        for (size_t i = 0; i < n; ++i) records[i] = getState(i);
+        endSlot();
+    }
+
+    const std::string& lastError() const { return m_error; }
+
+private:
+    AircraftState* beginSlot(double simTime, size_t count);
+    void endSlot();
+    bool fail(const std::string& msg);
+
+private:
+    void* m_base = nullptr;
+    size_t m_length = 0;
+    size_t m_capacity = 0;
+    std::string m_name;
+    SharedStateHeader* m_header = nullptr;
+    SharedStateSlot* m_writing = nullptr;
+    uint64_t m_frame = 0;
+    std::string m_error;
+};
+
+// --- 读取方 (其他进程) ---
+class SharedStateReader {
+public:
+    // 零拷贝读取: 指向共享内存中最新一帧, 使用完后用 validate() 确认期间没有被改写
+    struct View {
+        const AircraftState* states = nullptr;
+        size_t count = 0;
+        double simTime = 0.0;
+        uint64_t frame = 0;
+        const SharedStateSlot* slot = nullptr;
+        uint64_t seq = 0;
+    };
+
+    SharedStateReader();
+    ~SharedStateReader();
+
+    SharedStateReader(const SharedStateReader&) = delete;
+    SharedStateReader& operator=(const SharedStateReader&) = delete;
+
+    bool open(const std::string& name);
+    void close();
+    bool isOpen() const { return m_base != nullptr; }
+
+    size_t capacity() const;
+    // 最新发布序号, 尚未发布时为0
+    uint64_t latestFrame() const;
+
+    // 取最新一帧的视图; 尚未发布或正在写入时返回false
+    bool acquire(View& view) const;
+    bool validate(const View& view) const;
+
+    // 拷贝最新一帧 (最多重试 maxRetries 次); 成功时 out 为完整一致的一帧
+    bool read(std::vector<AircraftState>& out, double* simTime = nullptr, uint64_t* frame = nullptr, int maxRetries = 100) const;
+
+    const std::string& lastError() const { return m_error; }
+
+private:
+    bool fail(const std::string& msg);
+
+private:
+    void* m_base = nullptr;
+    size_t m_length = 0;
+    const SharedStateHeader* m_header = nullptr;
+    std::string m_error;
+};
+
+#endif // SHARED_STATE_HPP
@@ -0,0 +1,410 @@
+// Snapshot.cpp
+#include "Snapshot.hpp"
+#include <cstdio>
+
+namespace {
+
+// Internals / LaeroControlParams / LaeroCommandLimits 都只由 double 组成, 按 double 数组整体读写
+const size_t LAERO_INTERNALS_WORDS = sizeof(StandaloneLaeroModel::Internals) / sizeof(double);
+const size_t RAC_INTERNALS_WORDS = sizeof(StandaloneRacModel::Internals) / sizeof(double);
+const size_t CONTROL_PARAMS_WORDS = sizeof(LaeroControlParams) / sizeof(double);
+const size_t COMMAND_LIMITS_WORDS = sizeof(LaeroCommandLimits) / sizeof(double);
+const size_t STATE_WORDS = 15;          // SnapshotWriter::put(AircraftState): 3个角 + 4个 Vec3
+const size_t INTEGRATOR_WORDS = 6;      // putIntegrator: 类型 + 5个参数
+
+static_assert(sizeof(StandaloneLaeroModel::Internals) == 42 * sizeof(double), "Internals must contain only doubles");
+static_assert(sizeof(StandaloneRacModel::Internals) == 20 * sizeof(double), "Internals must contain only doubles");
+static_assert(sizeof(LaeroControlParams) == 6 * sizeof(double), "LaeroControlParams must contain only doubles");
+static_assert(sizeof(LaeroCommandLimits) == 5 * sizeof(double), "LaeroCommandLimits must contain only doubles");
+
+uint64_t magicWord() {
+    uint64_t w;
+    std::memcpy(&w, SNAPSHOT_MAGIC, sizeof(w));
+    return w;
+}
+
+// --- 差分编码 ---
+void putVarint(std::vector<uint8_t>& out, uint64_t x) {
+    while (x >= 0x80) {
+        out.push_back(static_cast<uint8_t>(x | 0x80));
+        x >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(x));
+}
+
+bool getVarint(const std::vector<uint8_t>& in, size_t& pos, uint64_t& x) {
+    x = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= in.size()) return false;
+        const uint8_t b = in[pos++];
+        x |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// ==============================================================
+// 读写
+// ==============================================================
+void SnapshotWriter::putHeader() {
+    putWord(magicWord());
+    putWord(SNAPSHOT_VERSION);
+}
+
+void SnapshotWriter::put(const double* x, size_t n) {
+    const size_t offset = m_out.size();
+    m_out.resize(offset + n);
+    std::memcpy(m_out.data() + offset, x, n * sizeof(double));
+}
+
+void SnapshotWriter::put(const oe_base::Vec3d& v) {
+    put(v.x());
+    put(v.y());
+    put(v.z());
+}
+
+void SnapshotWriter::put(const AircraftState& s) {
+    put(s.roll);
+    put(s.pitch);
+    put(s.yaw);
+    put(s.position);
+    put(s.velocity);
+    put(s.bodyVelocity);
+    put(s.angularVelocity);
+}
+
+bool SnapshotReader::readHeader() {
+    return expect(magicWord()) && expect(SNAPSHOT_VERSION);
+}
+
+bool SnapshotReader::expect(uint64_t tag) {
+    if (getWord() != tag) m_ok = false;
+    return m_ok;
+}
+
+bool SnapshotReader::get(double* x, size_t n) {
+    if (!m_ok || n > remaining()) {
+        m_ok = false;
+        return false;
+    }
+    std::memcpy(x, m_data + m_pos, n * sizeof(double));
+    m_pos += n;
+    return true;
+}
+
+oe_base::Vec3d SnapshotReader::getVec3() {
+    const double x = getDouble();
+    const double y = getDouble();
+    const double z = getDouble();
+    return oe_base::Vec3d(x, y, z);
+}
+
+AircraftState SnapshotReader::getState() {
+    AircraftState s;
+    s.roll = getDouble();
+    s.pitch = getDouble();
+    s.yaw = getDouble();
+    s.position = getVec3();
+    s.velocity = getVec3();
+    s.bodyVelocity = getVec3();
+    s.angularVelocity = getVec3();
+    return s;
+}
+
+// ==============================================================
+// 模型与机队
+// ==============================================================
+namespace {
+
+void putIntegrator(SnapshotWriter& w, const IntegratorConfig& c) {
+    w.putWord(static_cast<uint64_t>(c.type));
+    w.put(c.positionTol);
+    w.put(c.velocityTol);
+    w.put(c.angleTol);
+    w.put(c.minStep);
+    w.put(c.maxStep);
+}
+
+bool getIntegrator(SnapshotReader& r, IntegratorConfig& c) {
+    const uint64_t type = r.getWord();
+    c.positionTol = r.getDouble();
+    c.velocityTol = r.getDouble();
+    c.angleTol = r.getDouble();
+    c.minStep = r.getDouble();
+    c.maxStep = r.getDouble();
+    if (!r.ok() || type > INTEGRATOR_ADAPTIVE) return false;
+    c.type = static_cast<IntegratorType>(type);
+    return true;
+}
+
+} // namespace
+
+void writeSnapshot(SnapshotWriter& w, const StandaloneLaeroModel& model) {
+    const StandaloneLaeroModel::Internals in = model.getInternals();
+    w.putWord(SNAP_TAG_LAERO);
+    w.put(model.getState());
+    w.put(reinterpret_cast<const double*>(&in), LAERO_INTERNALS_WORDS);
+    w.put(reinterpret_cast<const double*>(&model.getControlParams()), CONTROL_PARAMS_WORDS);
+    w.put(reinterpret_cast<const double*>(&model.getCommandLimits()), COMMAND_LIMITS_WORDS);
+    w.put(model.getSteadyTolerance());
+    putIntegrator(w, model.getIntegrator());
+}
+
+bool readSnapshot(SnapshotReader& r, StandaloneLaeroModel& model) {
+    if (!r.expect(SNAP_TAG_LAERO)) return false;
+    const AircraftState state = r.getState();
+    StandaloneLaeroModel::Internals in;
+    LaeroControlParams control;
+    LaeroCommandLimits limits;
+    r.get(reinterpret_cast<double*>(&in), LAERO_INTERNALS_WORDS);
+    r.get(reinterpret_cast<double*>(&control), CONTROL_PARAMS_WORDS);
+    r.get(reinterpret_cast<double*>(&limits), COMMAND_LIMITS_WORDS);
+    const double steadyTol = r.getDouble();
+    IntegratorConfig integrator;
+    if (!getIntegrator(r, integrator)) return false;
+
+    // setInitialState 会改写 u/v/w 等, setIntegrator 可能清除历史值, 内部变量必须在它们之后恢复
+    model.setInitialState(state);
+    model.setIntegrator(integrator);
+    model.setInternals(in);
+    model.setControlParams(control);
+    model.setCommandLimits(limits);
+    model.setSteadyTolerance(steadyTol);
+    return true;
+}
+
+void writeSnapshot(SnapshotWriter& w, const StandaloneRacModel& model) {
+    const StandaloneRacModel::Internals in = model.getInternals();
+    double limits[4];
+    model.getPerformanceLimits(limits[0], limits[1], limits[2], limits[3]);
+    w.putWord(SNAP_TAG_RAC);
+    w.put(model.getState());
+    w.put(reinterpret_cast<const double*>(&in), RAC_INTERNALS_WORDS);
+    w.put(limits, 4);
+    putIntegrator(w, model.getIntegrator());
+}
+
+bool readSnapshot(SnapshotReader& r, StandaloneRacModel& model) {
+    if (!r.expect(SNAP_TAG_RAC)) return false;
+    const AircraftState state = r.getState();
+    StandaloneRacModel::Internals in;
+    double limits[4];
+    r.get(reinterpret_cast<double*>(&in), RAC_INTERNALS_WORDS);
+    r.get(limits, 4);
+    IntegratorConfig integrator;
+    if (!getIntegrator(r, integrator)) return false;
+
+    model.setInitialState(state);
+    model.setIntegrator(integrator);
+    model.setInternals(in);
+    model.setPerformanceLimits(limits[0], limits[1], limits[2], limits[3]);
+    return true;
+}
+
+// 标记 + 状态 + 各部分 (与上面的写入顺序一致)
+size_t modelSnapshotWords(const StandaloneLaeroModel*) {
+    return 1 + STATE_WORDS + LAERO_INTERNALS_WORDS + CONTROL_PARAMS_WORDS + COMMAND_LIMITS_WORDS + 1 + INTEGRATOR_WORDS;
+}
+
+size_t modelSnapshotWords(const StandaloneRacModel*) {
+    return 1 + STATE_WORDS + RAC_INTERNALS_WORDS + 4 + INTEGRATOR_WORDS;
+}
+
+void writeSnapshot(SnapshotWriter& w, const LaeroFleet& fleet) {
+    w.putWord(SNAP_TAG_LAERO_FLEET);
+    w.putWord(fleet.size());
+    w.putWord(LaeroFleet::FIELD_COUNT);
+    w.put(reinterpret_cast<const double*>(&fleet.getControlParams()), CONTROL_PARAMS_WORDS);
+    w.put(reinterpret_cast<const double*>(&fleet.getCommandLimits()), COMMAND_LIMITS_WORDS);
+    w.putWord(fleet.guidanceDivider());
+    w.putWord(fleet.guidancePhase());
+    for (int f = 0; f < LaeroFleet::FIELD_COUNT; ++f) {
+        w.put(fleet.column(static_cast<LaeroFleet::Field>(f)), fleet.size());
+    }
+}
+
+bool readSnapshot(SnapshotReader& r, LaeroFleet& fleet) {
+    if (!r.expect(SNAP_TAG_LAERO_FLEET)) return false;
+    const uint64_t n = r.getWord();
+    if (!r.expect(LaeroFleet::FIELD_COUNT)) return false;
+    LaeroControlParams control;
+    LaeroCommandLimits limits;
+    r.get(reinterpret_cast<double*>(&control), CONTROL_PARAMS_WORDS);
+    r.get(reinterpret_cast<double*>(&limits), COMMAND_LIMITS_WORDS);
+    const uint64_t divider = r.getWord();
+    const uint64_t phase = r.getWord();
+    if (!r.ok() || divider == 0 || divider > 0xFFFFFFFFu || phase >= divider) return false;
+    if (n > r.remaining() / LaeroFleet::FIELD_COUNT) return false;    // 不做乘法, 伪造的 n 会使其溢出
+
+    // 先读到临时机队, 完整读出后再替换
+    LaeroFleet restored(fleet.resource());  // 与目标使用同一内存, 替换时直接接管各列
+    restored.reserve(static_cast<size_t>(n));
+    for (uint64_t i = 0; i < n; ++i) restored.addAircraft(AircraftState());
+    for (int f = 0; f < LaeroFleet::FIELD_COUNT; ++f) {
+        if (!r.get(restored.column(static_cast<LaeroFleet::Field>(f)), static_cast<size_t>(n))) return false;
+    }
+    restored.setControlParams(control);
+    restored.setCommandLimits(limits);
+    restored.setGuidanceDivider(static_cast<unsigned>(divider), static_cast<unsigned>(phase));
+    fleet = std::move(restored);
+    return true;
+}
+
+// ==============================================================
+// 文件
+// ==============================================================
+bool saveSnapshotFile(const std::string& path, const SnapshotBuffer& snapshot) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) return false;
+    const size_t written = std::fwrite(snapshot.data(), sizeof(uint64_t), snapshot.size(), file);
+    const bool closed = (std::fclose(file) == 0);
+    return written == snapshot.size() && closed;
+}
+
+bool loadSnapshotFile(const std::string& path, SnapshotBuffer& snapshot) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) return false;
+
+    snapshot.clear();
+    uint64_t chunk[4096];
+    size_t n = 0;
+    while ((n = std::fread(chunk, sizeof(uint64_t), 4096, file)) > 0) {
+        snapshot.insert(snapshot.end(), chunk, chunk + n);
+    }
+    const bool ok = (std::ferror(file) == 0);
+    std::fclose(file);
+
+    SnapshotReader r(snapshot);
+    return ok && r.readHeader();
+}
+
+// ==============================================================
+// CheckpointHistory
+// ==============================================================
+CheckpointHistory::CheckpointHistory(size_t keyframeInterval, size_t maxCheckpoints)
+    : m_keyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1),
+      m_maxCheckpoints(maxCheckpoints) {
+}
+
+// 差分格式: 重复 { varint 跳过的不变字数, uint8 字节数k (1..8), 异或值的低k字节 }
+void CheckpointHistory::encodeDelta(const SnapshotBuffer& prev, const SnapshotBuffer& cur, std::vector<uint8_t>& out) {
+    out.clear();
+    uint64_t skip = 0;
+    for (size_t i = 0; i < cur.size(); ++i) {
+        uint64_t x = prev[i] ^ cur[i];
+        if (x == 0) {
+            ++skip;
+            continue;
+        }
+        putVarint(out, skip);
+        skip = 0;
+
+        // 相邻检查点的 double 通常符号、指数和高位尾数相同, 异或后高位字节为0
+        uint8_t bytes = 8;
+        while (bytes > 1 && (x >> (8 * (bytes - 1))) == 0) --bytes;
+        out.push_back(bytes);
+        for (uint8_t b = 0; b < bytes; ++b) {
+            out.push_back(static_cast<uint8_t>(x));
+            x >>= 8;
+        }
+    }
+    out.shrink_to_fit();
+}
+
+bool CheckpointHistory::applyDelta(const std::vector<uint8_t>& delta, SnapshotBuffer& words) {
+    size_t pos = 0;
+    size_t i = 0;
+    while (pos < delta.size()) {
+        uint64_t skip = 0;
+        if (!getVarint(delta, pos, skip)) return false;
+        i += static_cast<size_t>(skip);
+        if (i >= words.size() || pos >= delta.size()) return false;
+
+        const uint8_t bytes = delta[pos++];
+        if (bytes < 1 || bytes > 8 || pos + bytes > delta.size()) return false;
+        uint64_t x = 0;
+        for (uint8_t b = 0; b < bytes; ++b) {
+            x |= static_cast<uint64_t>(delta[pos++]) << (8 * b);
+        }
+        words[i++] ^= x;
+    }
+    return true;
+}
+
+void CheckpointHistory::push(double simTime, const SnapshotBuffer& snapshot) {
+    Entry e;
+    e.time = simTime;
+    e.wordCount = snapshot.size();
+    // 机队大小变化 (长度不同) 时只能存完整快照
+    e.keyframe = m_entries.empty() || m_sinceKeyframe + 1 >= m_keyframeInterval || snapshot.size() != m_last.size();
+    if (e.keyframe) {
+        e.full = snapshot;
+        m_sinceKeyframe = 0;
+    } else {
+        encodeDelta(m_last, snapshot, e.delta);
+        ++m_sinceKeyframe;
+    }
+    m_entries.push_back(std::move(e));
+    m_last = snapshot;
+
+    // 超出上限时丢弃最旧的一组 (关键帧及其差分), 至少保留最新的一组
+    if (m_maxCheckpoints > 0) {
+        while (m_entries.size() > m_maxCheckpoints) {
+            size_t next = 1;
+            while (next < m_entries.size() && !m_entries[next].keyframe) ++next;
+            if (next >= m_entries.size()) break;
+            m_entries.erase(m_entries.begin(), m_entries.begin() + next);
+        }
+    }
+}
+
+size_t CheckpointHistory::find(double simTime) const {
+    size_t lo = 0, hi = m_entries.size();
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (m_entries[mid].time <= simTime) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo == 0 ? NPOS : lo - 1;
+}
+
+bool CheckpointHistory::get(size_t k, SnapshotBuffer& out) const {
+    if (k >= m_entries.size()) return false;
+
+    size_t key = k;
+    while (!m_entries[key].keyframe) --key;    // 第一个检查点总是关键帧
+    out = m_entries[key].full;
+    for (size_t j = key + 1; j <= k; ++j) {
+        if (!applyDelta(m_entries[j].delta, out)) return false;
+    }
+    return out.size() == m_entries[k].wordCount;
+}
+
+void CheckpointHistory::truncate(size_t count) {
+    if (count >= m_entries.size()) return;
+    m_entries.resize(count);
+    if (m_entries.empty()) {
+        clear();
+        return;
+    }
+
+    get(count - 1, m_last);
+    m_sinceKeyframe = 0;
+    for (size_t j = count - 1; !m_entries[j].keyframe; --j) ++m_sinceKeyframe;
+}
+
+void CheckpointHistory::clear() {
+    m_entries.clear();
+    m_last.clear();
+    m_sinceKeyframe = 0;
+}
+
+size_t CheckpointHistory::memoryBytes() const {
+    size_t bytes = m_last.capacity() * sizeof(uint64_t);
+    for (const Entry& e : m_entries) {
+        bytes += sizeof(Entry) + e.full.capacity() * sizeof(uint64_t) + e.delta.capacity();
+    }
+    return bytes;
+}
@@ -0,0 +1,224 @@
+// Snapshot.hpp
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+#include "AircraftState.hpp"
+#include "LaeroFleet.hpp"
+#include "ModelFleet.hpp"
+#include "StandaloneLaeroModel.hpp"
+#include "StandaloneRacModel.hpp"
+
+// 完整仿真状态的快照与回退
+//
+// setInitialState 只设置 AircraftState, 模型的内部变量 (p/q/r、uDot、AB历史值、指令等) 会丢失,
+// 从中途重新开始的仿真与原来的不一致。快照按位保存模型的全部状态和参数, 恢复后继续仿真与原来逐位相同。
+//
+// 快照格式: 64位字的序列 (double 按位拷贝, 小端写入文件)
+//   头部: SNAPSHOT_MAGIC, SNAPSHOT_VERSION
+//   对象: 类型标记 (SnapshotTag) + 字段; 机队为 标记 + 架数 + 逐架模型。
+// 一个缓冲区可以依次写入多个对象 (例如机队 + 调用方自己的状态), 按同样顺序读出。
+//
+// CheckpointHistory 在内存中保存周期性检查点: 每隔若干个存一份完整快照 (关键帧),
+// 其余只存与上一个检查点的差分 (逐字异或, 只存非零的低位字节), 可以回退到任意检查点重新仿真。
+
+typedef std::vector<uint64_t> SnapshotBuffer;
+
+const char SNAPSHOT_MAGIC[8] = { 'L', 'A', 'E', 'R', 'O', 'S', 'N', 'P' };
+// 2: 模型内部变量增加 ABM3 历史值, 模型快照增加积分方法
+// 3: LaeroFleet 增加制导分频与分频计数
+// 4: StandaloneLaeroModel 增加指令性能参数 (机型参数)
+// 5: LaeroFleet 增加指令性能参数的缺省值
+const uint64_t SNAPSHOT_VERSION = 5;
+
+enum SnapshotTag {
+    SNAP_TAG_LAERO = 0x4C41,        // StandaloneLaeroModel
+    SNAP_TAG_RAC = 0x5241,          // StandaloneRacModel
+    SNAP_TAG_LAERO_FLEET = 0x4C46,  // LaeroFleet
+    SNAP_TAG_MODEL_FLEET = 0x4D46,  // ModelFleet<Model>
+    SNAP_TAG_MIXED_FLEET = 0x5846   // MixedFleet<Models...>
+};
+
+// --- 写入 ---
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(SnapshotBuffer& out) : m_out(out) {}
+
+    // 快照头部 (saveSnapshot 会自动写入)
+    void putHeader();
+
+    void putWord(uint64_t w) { m_out.push_back(w); }
+    void put(double x) {
+        uint64_t w;
+        std::memcpy(&w, &x, sizeof(w));
+        m_out.push_back(w);
+    }
+    void put(const double* x, size_t n);
+    void put(const oe_base::Vec3d& v);
+    void put(const AircraftState& s);
+
+private:
+    SnapshotBuffer& m_out;
+};
+
+// --- 读取 (越界或标记不符时 ok() 变为 false, 之后的读取都返回0) ---
+class SnapshotReader {
+public:
+    SnapshotReader(const uint64_t* data, size_t size) : m_data(data), m_size(size) {}
+    explicit SnapshotReader(const SnapshotBuffer& in) : m_data(in.data()), m_size(in.size()) {}
+
+    bool readHeader();
+    // 读一个字并检查是否等于 tag
+    bool expect(uint64_t tag);
+
+    uint64_t getWord() {
+        if (m_pos >= m_size) {
+            m_ok = false;
+            return 0;
+        }
+        return m_data[m_pos++];
+    }
+    double getDouble() {
+        const uint64_t w = getWord();
+        double x;
+        std::memcpy(&x, &w, sizeof(x));
+        return x;
+    }
+    bool get(double* x, size_t n);
+    oe_base::Vec3d getVec3();
+    AircraftState getState();
+
+    bool ok() const { return m_ok; }
+    size_t remaining() const { return m_size - m_pos; }
+
+private:
+    const uint64_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    bool m_ok = true;
+};
+
+// --- 各对象的快照 (读取失败时对象保持不变) ---
+void writeSnapshot(SnapshotWriter& w, const StandaloneLaeroModel& model);
+bool readSnapshot(SnapshotReader& r, StandaloneLaeroModel& model);
+
+void writeSnapshot(SnapshotWriter& w, const StandaloneRacModel& model);
+bool readSnapshot(SnapshotReader& r, StandaloneRacModel& model);
+
+void writeSnapshot(SnapshotWriter& w, const LaeroFleet& fleet);
+bool readSnapshot(SnapshotReader& r, LaeroFleet& fleet);
+
+// 单个模型快照的字数 (固定); 读取机队时按剩余字数限制飞机数, 伪造的个数不会导致按个数分配
+size_t modelSnapshotWords(const StandaloneLaeroModel*);
+size_t modelSnapshotWords(const StandaloneRacModel*);
+
+template<class Model>
+void writeSnapshot(SnapshotWriter& w, const ModelFleet<Model>& fleet) {
+    w.putWord(SNAP_TAG_MODEL_FLEET);
+    w.putWord(fleet.size());
+    for (const Model& m : fleet.models()) writeSnapshot(w, m);
+}
+
+template<class Model>
+bool readSnapshot(SnapshotReader& r, ModelFleet<Model>& fleet) {
+    if (!r.expect(SNAP_TAG_MODEL_FLEET)) return false;
+    const uint64_t n = r.getWord();
+    if (!r.ok() || n > r.remaining() / modelSnapshotWords(static_cast<const Model*>(nullptr))) return false;
+
+    std::vector<Model> models(static_cast<size_t>(n));
+    for (Model& m : models) {
+        if (!readSnapshot(r, m)) return false;
+    }
+    fleet.models().swap(models);
+    return true;
+}
+
+template<class... Models>
+void writeSnapshot(SnapshotWriter& w, const MixedFleet<Models...>& fleet) {
+    w.putWord(SNAP_TAG_MIXED_FLEET);
+    w.putWord(sizeof...(Models));
+    (writeSnapshot(w, fleet.template bucket<Models>()), ...);
+}
+
+template<class... Models>
+bool readSnapshot(SnapshotReader& r, MixedFleet<Models...>& fleet) {
+    if (!r.expect(SNAP_TAG_MIXED_FLEET) || !r.expect(sizeof...(Models))) return false;
+    MixedFleet<Models...> restored;
+    if (!(readSnapshot(r, restored.template bucket<Models>()) && ...)) return false;
+    fleet = std::move(restored);
+    return true;
+}
+
+// --- 整个缓冲区 ---
+template<class T>
+void saveSnapshot(const T& object, SnapshotBuffer& out) {
+    out.clear();
+    SnapshotWriter w(out);
+    w.putHeader();
+    writeSnapshot(w, object);
+}
+
+template<class T>
+bool restoreSnapshot(T& object, const SnapshotBuffer& in) {
+    SnapshotReader r(in);
+    return r.readHeader() && readSnapshot(r, object);
+}
+
+bool saveSnapshotFile(const std::string& path, const SnapshotBuffer& snapshot);
+bool loadSnapshotFile(const std::string& path, SnapshotBuffer& snapshot);
+
+// --- 内存中的检查点历史 ---
+class CheckpointHistory {
+public:
+    static const size_t NPOS = static_cast<size_t>(-1);
+
+    // keyframeInterval: 每隔多少个检查点存一份完整快照
+    // maxCheckpoints: 超出时丢弃最旧的关键帧及其差分 (0 表示不限)
+    explicit CheckpointHistory(size_t keyframeInterval = 32, size_t maxCheckpoints = 0);
+
+    // 追加检查点 (时间应递增)
+    void push(double simTime, const SnapshotBuffer& snapshot);
+
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+    double time(size_t k) const { return m_entries[k].time; }
+
+    // 时间不晚于 simTime 的最后一个检查点, 没有时返回 NPOS
+    size_t find(double simTime) const;
+    // 还原第k个检查点的完整快照
+    bool get(size_t k, SnapshotBuffer& out) const;
+
+    // 只保留前 count 个检查点 (回退后重新仿真时丢弃之后的检查点)
+    void truncate(size_t count);
+    void clear();
+
+    // 检查点占用的内存 (字节)
+    size_t memoryBytes() const;
+
+private:
+    struct Entry {
+        double time = 0.0;
+        size_t wordCount = 0;
+        bool keyframe = false;
+        SnapshotBuffer full;            // 关键帧
+        std::vector<uint8_t> delta;     // 与上一个检查点的差分
+    };
+
+    static void encodeDelta(const SnapshotBuffer& prev, const SnapshotBuffer& cur, std::vector<uint8_t>& out);
+    static bool applyDelta(const std::vector<uint8_t>& delta, SnapshotBuffer& words);
+
+private:
+    size_t m_keyframeInterval;
+    size_t m_maxCheckpoints;
+    std::deque<Entry> m_entries;
+    SnapshotBuffer m_last;              // 最后一个检查点的完整内容
+    size_t m_sinceKeyframe = 0;
+};
+
+#endif // SNAPSHOT_HPP
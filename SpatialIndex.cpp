@@ -0,0 +1,436 @@
+// SpatialIndex.cpp
+#include "SpatialIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "FleetScheduler.hpp"
+
+namespace {
+
+// 格子坐标的范围, 远离 int32 溢出
+const double MAX_CELL = 1.0e9;
+
+const double EPS = 1.0e-12;
+
+// 外包盒每边的余量: 1/8 范围加 1 个格子, 飞机小幅移动时不必重新布局
+inline int64_t layoutPad(int64_t extent) {
+    return extent / 8 + 1;
+}
+
+// 稠密网格的格子数上限
+inline bool denseFits(double cells, size_t count) {
+    return cells <= 4.0 * double(count) + 64.0;
+}
+
+// 时间区间 [lo, hi] 与 [t0, t1] 的交集写回 lo/hi
+inline void intersect(double t0, double t1, double& lo, double& hi) {
+    lo = std::max(lo, t0);
+    hi = std::min(hi, t1);
+}
+
+// 相对位置 d 和相对速度 dv (b 相对 a) 下的冲突预测: 水平距离 < H 且垂直距离 < V 的时段与 [0, T] 相交
+bool predictConflict(double dx, double dy, double dz, double dvx, double dvy, double dvz,
+                     const SpatialIndex::ConflictParams& params, SpatialIndex::Conflict& c) {
+    const double H = params.horizontalSeparation;
+    const double V = params.verticalSeparation;
+    const double T = params.lookahead;
+
+    // 粗筛 (不用除法): 预测时段内垂直或水平距离不可能缩小到间隔以内。
+    // 两个条件合成一个分支, 绝大多数候选在这里被排除, 分支容易预测
+    const double reachV = V + std::abs(dvz) * T;
+    const double reachH = H + std::sqrt(dvx * dvx + dvy * dvy) * T;
+    if ((dz * dz >= reachV * reachV) | (dx * dx + dy * dy >= reachH * reachH)) return false;
+
+    double lo = 0.0, hi = T;
+
+    // 垂直: |dz + dvz t| < V
+    if (std::abs(dvz) < EPS) {
+        if (!(std::abs(dz) < V)) return false;
+    } else {
+        const double tA = (-V - dz) / dvz;
+        const double tB = (V - dz) / dvz;
+        intersect(std::min(tA, tB), std::max(tA, tB), lo, hi);
+        if (lo > hi) return false;
+    }
+
+    // 水平: |d + dv t|^2 < H^2, 即 a t^2 + b t + c < 0
+    const double a = dvx * dvx + dvy * dvy;
+    const double b = 2.0 * (dx * dvx + dy * dvy);
+    const double cc = dx * dx + dy * dy - H * H;
+    if (a < EPS) {
+        if (!(cc < 0.0)) return false;
+    } else {
+        const double disc = b * b - 4.0 * a * cc;
+        if (!(disc > 0.0)) return false;
+        const double sq = std::sqrt(disc);
+        intersect((-b - sq) / (2.0 * a), (-b + sq) / (2.0 * a), lo, hi);
+        if (lo > hi) return false;
+    }
+
+    const double tc = (a < EPS) ? 0.0 : std::min(T, std::max(0.0, -b / (2.0 * a)));
+    const double hx = dx + dvx * tc;
+    const double hy = dy + dvy * tc;
+    c.timeToLoss = lo;
+    c.timeToCpa = tc;
+    c.cpaHorizontal = std::sqrt(hx * hx + hy * hy);
+    c.cpaVertical = std::abs(dz + dvz * tc);
+    return true;
+}
+
+} // namespace
+
+SpatialIndex::SpatialIndex(double cellSize, double cellHeight) {
+    setCellSize(cellSize, cellHeight);
+}
+
+void SpatialIndex::setCellSize(double cellSize, double cellHeight) {
+    m_cellSize = (cellSize > 0.0) ? cellSize : 20000.0;
+    m_cellHeight = (cellHeight > 0.0) ? cellHeight : 2000.0;
+    m_invCellSize = 1.0 / m_cellSize;
+    m_invCellHeight = 1.0 / m_cellHeight;
+    m_layoutValid = false;
+}
+
+// --- 重建 ---
+void SpatialIndex::build(const std::vector<AircraftState>& states) {
+    build(states.size(), [&states](size_t i) -> const AircraftState& { return states[i]; });
+}
+
+void SpatialIndex::build(size_t count, const double* x, const double* y, const double* z,
+                         const double* vn, const double* ve, const double* vd) {
+    beginBuild(count);
+    for (size_t i = 0; i < count; ++i) setEntry(i, x[i], y[i], z[i], vn[i], ve[i], vd[i]);
+    finishBuild();
+}
+
+void SpatialIndex::beginBuild(size_t count) {
+    if (count != m_input.size()) m_layoutValid = false;
+    m_input.resize(count);
+    m_keys.resize(count);
+    m_slot.resize(count);
+
+    for (int a = 0; a < 3; ++a) {
+        m_minCell[a] = std::numeric_limits<int32_t>::max();
+        m_maxCell[a] = std::numeric_limits<int32_t>::min();
+    }
+    m_maxHorizontalSpeed = 0.0;
+    m_maxVerticalSpeed = 0.0;
+}
+
+void SpatialIndex::setEntry(size_t i, double x, double y, double z, double vx, double vy, double vz) {
+    Entry& e = m_input[i];
+    e.x = x; e.y = y; e.z = z;
+    e.vx = vx; e.vy = vy; e.vz = vz;
+    e.cx = cellX(x);
+    e.cy = cellX(y);
+    e.cz = cellZ(z);
+    e.id = static_cast<uint32_t>(i);
+
+    m_minCell[0] = std::min(m_minCell[0], e.cx); m_maxCell[0] = std::max(m_maxCell[0], e.cx);
+    m_minCell[1] = std::min(m_minCell[1], e.cy); m_maxCell[1] = std::max(m_maxCell[1], e.cy);
+    m_minCell[2] = std::min(m_minCell[2], e.cz); m_maxCell[2] = std::max(m_maxCell[2], e.cz);
+    m_maxHorizontalSpeed = std::max(m_maxHorizontalSpeed, vx * vx + vy * vy);   // 先存平方
+    m_maxVerticalSpeed = std::max(m_maxVerticalSpeed, std::abs(vz));
+
+    if (!m_layoutValid) return;
+    if (m_dense && (e.cx < m_origin[0] || e.cx >= m_origin[0] + m_dims[0] ||
+                    e.cy < m_origin[1] || e.cy >= m_origin[1] + m_dims[1] ||
+                    e.cz < m_origin[2] || e.cz >= m_origin[2] + m_dims[2])) {
+        // 离开外包盒: 本帧重新布局
+        m_layoutValid = false;
+        return;
+    }
+    const uint32_t key = bucketOf(e.cx, e.cy, e.cz);
+    if (key != m_keys[i]) {
+        m_keys[i] = key;
+        m_keysChanged = true;
+    }
+}
+
+void SpatialIndex::chooseLayout(size_t count) {
+    m_layoutValid = true;
+    m_keysChanged = true;
+
+    double cells = 1.0;
+    for (int a = 0; a < 3; ++a) {
+        const int64_t extent = (count > 0) ? int64_t(m_maxCell[a]) - m_minCell[a] + 1 : 1;
+        const int64_t pad = layoutPad(extent);
+        m_origin[a] = static_cast<int32_t>((count > 0 ? m_minCell[a] : 0) - pad);
+        m_dims[a] = static_cast<int32_t>(std::min<int64_t>(extent + 2 * pad, int64_t(1) << 30));
+        cells *= m_dims[a];
+    }
+
+    m_dense = denseFits(cells, count);
+    size_t buckets = 16;
+    if (m_dense) {
+        buckets = static_cast<size_t>(cells);
+    } else {
+        while (buckets < 2 * count) buckets *= 2;
+        m_bucketMask = static_cast<uint32_t>(buckets - 1);
+    }
+    m_bucketStart.assign(buckets + 1, 0);
+}
+
+void SpatialIndex::finishBuild() {
+    const size_t n = m_input.size();
+    m_maxHorizontalSpeed = std::sqrt(m_maxHorizontalSpeed);
+
+    // 哈希布局下机队收拢到可以用稠密网格时也重新布局
+    if (m_layoutValid && !m_dense) {
+        double cells = 1.0;
+        for (int a = 0; a < 3; ++a) {
+            const int64_t extent = int64_t(m_maxCell[a]) - m_minCell[a] + 1;
+            cells *= double(extent + 2 * layoutPad(extent));
+        }
+        if (n > 0 && denseFits(cells, n)) m_layoutValid = false;
+    }
+    if (!m_layoutValid) {
+        chooseLayout(n);
+        for (size_t i = 0; i < n; ++i) m_keys[i] = bucketOf(m_input[i].cx, m_input[i].cy, m_input[i].cz);
+    }
+
+    m_lastSorted = m_keysChanged;
+    m_entries.resize(n);
+    if (m_keysChanged) {
+        // 计数排序: 统计每个桶的数量, 前缀和得到起点, 再按编号顺序放入 (同桶内保持编号升序)
+        const size_t buckets = m_bucketStart.size() - 1;
+        std::fill(m_bucketStart.begin(), m_bucketStart.end(), 0u);
+        for (size_t i = 0; i < n; ++i) ++m_bucketStart[m_keys[i] + 1];
+        for (size_t b = 0; b < buckets; ++b) m_bucketStart[b + 1] += m_bucketStart[b];
+
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t pos = m_bucketStart[m_keys[i]]++;
+            m_slot[i] = pos;
+            m_entries[pos] = m_input[i];
+        }
+        // 放入后 m_bucketStart[b] 变成桶 b 的终点, 整体右移一位恢复起点
+        for (size_t b = buckets; b > 0; --b) m_bucketStart[b] = m_bucketStart[b - 1];
+        m_bucketStart[0] = 0;
+        m_keysChanged = false;
+    } else {
+        for (size_t i = 0; i < n; ++i) m_entries[m_slot[i]] = m_input[i];
+    }
+}
+
+// --- 格子 ---
+namespace {
+
+inline bool finite(const oe_base::Vec3d& v) {
+    return std::isfinite(v.x()) && std::isfinite(v.y()) && std::isfinite(v.z());
+}
+
+// floor 并限制范围
+inline int32_t cellIndex(double t) {
+    double f = std::floor(t);
+    if (!(f > -MAX_CELL)) f = -MAX_CELL;   // 同时处理 NaN
+    else if (f > MAX_CELL) f = MAX_CELL;
+    return static_cast<int32_t>(f);
+}
+
+} // namespace
+
+int32_t SpatialIndex::cellX(double v) const {
+    return cellIndex(v * m_invCellSize);
+}
+
+int32_t SpatialIndex::cellZ(double v) const {
+    return cellIndex(v * m_invCellHeight);
+}
+
+uint32_t SpatialIndex::bucketOf(int32_t cx, int32_t cy, int32_t cz) const {
+    if (m_dense) {
+        return static_cast<uint32_t>((int64_t(cy - m_origin[1]) * m_dims[2] + (cz - m_origin[2])) * m_dims[0] + (cx - m_origin[0]));
+    }
+    const uint32_t h = (static_cast<uint32_t>(cx) * 73856093u) ^
+                       (static_cast<uint32_t>(cy) * 19349663u) ^
+                       (static_cast<uint32_t>(cz) * 83492791u);
+    return h & m_bucketMask;
+}
+
+template<class F>
+void SpatialIndex::forEachInCells(const int32_t lo[3], const int32_t hi[3], F&& f, uint32_t from) const {
+    const int32_t x0 = std::max(lo[0], m_minCell[0]), x1 = std::min(hi[0], m_maxCell[0]);
+    const int32_t y0 = std::max(lo[1], m_minCell[1]), y1 = std::min(hi[1], m_maxCell[1]);
+    const int32_t z0 = std::max(lo[2], m_minCell[2]), z1 = std::min(hi[2], m_maxCell[2]);
+
+    if (m_dense) {
+        // 同一行 (cy, cz) 的 x0..x1 是一段连续区间
+        if (x0 > x1) return;
+        for (int32_t cy = y0; cy <= y1; ++cy) {
+            for (int32_t cz = z0; cz <= z1; ++cz) {
+                const uint32_t end = m_bucketStart[bucketOf(x1, cy, cz) + 1];
+                for (uint32_t k = std::max(from, m_bucketStart[bucketOf(x0, cy, cz)]); k < end; ++k) f(k);
+            }
+        }
+        return;
+    }
+
+    for (int32_t cx = x0; cx <= x1; ++cx) {
+        for (int32_t cy = y0; cy <= y1; ++cy) {
+            for (int32_t cz = z0; cz <= z1; ++cz) {
+                const uint32_t b = bucketOf(cx, cy, cz);
+                const uint32_t end = m_bucketStart[b + 1];
+                for (uint32_t k = std::max(from, m_bucketStart[b]); k < end; ++k) {
+                    const Entry& e = m_entries[k];
+                    // 同一个桶里可能有其他格子的飞机
+                    if (e.cx == cx && e.cy == cy && e.cz == cz) f(k);
+                }
+            }
+        }
+    }
+}
+
+// --- 半径查询 ---
+size_t SpatialIndex::queryRadius(const oe_base::Vec3d& center, double radius, std::vector<uint32_t>& out) const {
+    if (m_entries.empty() || !(radius >= 0.0) || !finite(center)) return 0;
+    const size_t before = out.size();
+    const double r2 = radius * radius;
+
+    auto test = [&](uint32_t k) {
+        const Entry& e = m_entries[k];
+        const double dx = e.x - center.x(), dy = e.y - center.y(), dz = e.z - center.z();
+        if (dx * dx + dy * dy + dz * dz <= r2) out.push_back(e.id);
+    };
+
+    const int32_t lo[3] = { cellX(center.x() - radius), cellX(center.y() - radius), cellZ(center.z() - radius) };
+    const int32_t hi[3] = { cellX(center.x() + radius), cellX(center.y() + radius), cellZ(center.z() + radius) };
+
+    // 范围内的格子比飞机还多时直接遍历
+    double cells = 1.0;
+    for (int a = 0; a < 3; ++a) {
+        cells *= std::max(0.0, double(std::min(hi[a], m_maxCell[a])) - double(std::max(lo[a], m_minCell[a])) + 1.0);
+    }
+    if (cells > double(m_entries.size())) {
+        for (size_t k = 0; k < m_entries.size(); ++k) test(static_cast<uint32_t>(k));
+    } else {
+        forEachInCells(lo, hi, test);
+    }
+    return out.size() - before;
+}
+
+// --- k 近邻 ---
+void SpatialIndex::queryNearest(const oe_base::Vec3d& center, size_t k, std::vector<Neighbor>& out, uint32_t exclude) const {
+    out.clear();
+    if (k == 0 || m_entries.empty() || !finite(center)) return;
+
+    // out 作为按距离平方的最大堆
+    auto farther = [](const Neighbor& a, const Neighbor& b) { return a.distance < b.distance; };
+    auto consider = [&](uint32_t idx) {
+        const Entry& e = m_entries[idx];
+        if (e.id == exclude) return;
+        const double dx = e.x - center.x(), dy = e.y - center.y(), dz = e.z - center.z();
+        const double d2 = dx * dx + dy * dy + dz * dz;
+        if (out.size() < k) {
+            out.push_back(Neighbor{ e.id, d2 });
+            std::push_heap(out.begin(), out.end(), farther);
+        } else if (d2 < out.front().distance) {
+            std::pop_heap(out.begin(), out.end(), farther);
+            out.back() = Neighbor{ e.id, d2 };
+            std::push_heap(out.begin(), out.end(), farther);
+        }
+    };
+
+    // 查询点在有飞机的范围之外时, 从紧邻该范围的格子开始 (更外面的圈都是空的, 也避免格子坐标溢出);
+    // p 仍在圈的外侧, 下面的 bound 仍是圈外飞机距离的下限
+    int32_t c[3] = { cellX(center.x()), cellX(center.y()), cellZ(center.z()) };
+    for (int a = 0; a < 3; ++a) c[a] = std::min(std::max(c[a], m_minCell[a] - 1), m_maxCell[a] + 1);
+    const double p[3] = { center.x(), center.y(), center.z() };
+    const double size[3] = { m_cellSize, m_cellSize, m_cellHeight };
+    // 格子不是立方体: 每圈水平扩展1格, 垂直扩展同样的距离
+    const double zPerRing = m_cellSize / m_cellHeight;
+
+    // 由内向外逐圈搜索, 每圈只访问新增的格子
+    int32_t prevZ = -1;
+    for (int32_t r = 0;; ++r) {
+        const int32_t rz = static_cast<int32_t>(std::min(std::ceil(r * zPerRing), 1.0e9));
+        const int32_t lo[3] = { c[0] - r, c[1] - r, c[2] - rz };
+        const int32_t hi[3] = { c[0] + r, c[1] + r, c[2] + rz };
+        const int32_t x0 = std::max(lo[0], m_minCell[0]), x1 = std::min(hi[0], m_maxCell[0]);
+        const int32_t y0 = std::max(lo[1], m_minCell[1]), y1 = std::min(hi[1], m_maxCell[1]);
+        for (int32_t cy = y0; cy <= y1; ++cy) {
+            for (int32_t cx = x0; cx <= x1; ++cx) {
+                if (r == 0 || cx == lo[0] || cx == hi[0] || cy == lo[1] || cy == hi[1]) {
+                    const int32_t clo[3] = { cx, cy, lo[2] };
+                    const int32_t chi[3] = { cx, cy, hi[2] };
+                    forEachInCells(clo, chi, consider);
+                } else if (rz > prevZ) {
+                    // 内部柱只取上下新增的部分
+                    const int32_t blo[3] = { cx, cy, lo[2] };
+                    const int32_t bhi[3] = { cx, cy, c[2] - prevZ - 1 };
+                    forEachInCells(blo, bhi, consider);
+                    const int32_t tlo[3] = { cx, cy, c[2] + prevZ + 1 };
+                    const int32_t thi[3] = { cx, cy, hi[2] };
+                    forEachInCells(tlo, thi, consider);
+                }
+            }
+        }
+        prevZ = rz;
+
+        // 圈外的飞机至少相距 bound; 已覆盖全部有飞机的格子的方向不受限制
+        double bound = std::numeric_limits<double>::infinity();
+        bool covered = true;
+        for (int a = 0; a < 3; ++a) {
+            if (lo[a] > m_minCell[a]) {
+                bound = std::min(bound, p[a] - double(lo[a]) * size[a]);
+                covered = false;
+            }
+            if (hi[a] < m_maxCell[a]) {
+                bound = std::min(bound, double(hi[a] + 1) * size[a] - p[a]);
+                covered = false;
+            }
+        }
+        if (covered) break;
+        if (out.size() == k && out.front().distance <= bound * bound) break;
+    }
+
+    std::sort_heap(out.begin(), out.end(), farther);
+    for (Neighbor& n : out) n.distance = std::sqrt(n.distance);
+}
+
+// --- 冲突 ---
+void SpatialIndex::conflictsFor(const ConflictParams& params, size_t begin, size_t end, std::vector<Conflict>& out) const {
+    const double T = std::max(0.0, params.lookahead);
+    ConflictParams p = params;
+    p.lookahead = T;
+
+    for (size_t i = begin; i < end; ++i) {
+        const Entry& ei = m_entries[i];
+        // 搜索半径: 间隔 + 两机在 T 内可能的相对位移
+        const double reachH = p.horizontalSeparation + (std::sqrt(ei.vx * ei.vx + ei.vy * ei.vy) + m_maxHorizontalSpeed) * T;
+        const double reachV = p.verticalSeparation + (std::abs(ei.vz) + m_maxVerticalSpeed) * T;
+        const int32_t lo[3] = { cellX(ei.x - reachH), cellX(ei.y - reachH), cellZ(ei.z - reachV) };
+        const int32_t hi[3] = { cellX(ei.x + reachH), cellX(ei.y + reachH), cellZ(ei.z + reachV) };
+
+        // 每对只算一次: 只看排在第 i 条之后的飞机
+        forEachInCells(lo, hi, [&](uint32_t j) {
+            const Entry& ej = m_entries[j];
+            Conflict c;
+            if (predictConflict(ej.x - ei.x, ej.y - ei.y, ej.z - ei.z,
+                                ej.vx - ei.vx, ej.vy - ei.vy, ej.vz - ei.vz, p, c)) {
+                c.a = std::min(ei.id, ej.id);
+                c.b = std::max(ei.id, ej.id);
+                out.push_back(c);
+            }
+        }, static_cast<uint32_t>(i + 1));
+    }
+}
+
+void SpatialIndex::findConflicts(const ConflictParams& params, std::vector<Conflict>& out) const {
+    out.clear();
+    conflictsFor(params, 0, m_entries.size(), out);
+}
+
+void SpatialIndex::findConflicts(const ConflictParams& params, std::vector<Conflict>& out, FleetScheduler& scheduler) const {
+    out.clear();
+    const size_t n = m_entries.size();
+    const size_t chunk = scheduler.chunkSize();
+    m_chunkConflicts.resize((n + chunk - 1) / chunk);
+
+    // 每个块写自己的缓冲区, 再按块顺序拼接
+    scheduler.parallelFor(n, [this, &params, chunk](size_t begin, size_t end) {
+        std::vector<Conflict>& buffer = m_chunkConflicts[begin / chunk];
+        buffer.clear();
+        conflictsFor(params, begin, end, buffer);
+    });
+    for (const std::vector<Conflict>& buffer : m_chunkConflicts) out.insert(out.end(), buffer.begin(), buffer.end());
+}
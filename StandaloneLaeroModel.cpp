@@ -1,67 +1,97 @@
 // StandaloneLaeroModel.cpp
 #include "StandaloneLaeroModel.hpp"
+#include "Profiler.hpp"
 #include <iostream>
+#include <limits>
 
-const double StandaloneLaeroModel::HALF_PI = oe_base::PI / 2.0;
-const double StandaloneLaeroModel::EPSILON = 1.0E-10;
+// 常量统一写成 T(...): double 版本与原来的计算逐位相同, float 版本全程单精度
 
-StandaloneLaeroModel::StandaloneLaeroModel() {
+template<class T>
+StandaloneLaeroModelT<T>::StandaloneLaeroModelT() {
     // 构造函数中可以设置初始状态
 }
 
-void StandaloneLaeroModel::setInitialVelocityKts(double kts) {
-    const double KTS2MPS = 1852.0 / 3600.0;
-    u = kts * KTS2MPS;
-    m_state.bodyVelocity.set(u, 0, 0);
+template<class T>
+StandaloneLaeroModelT<T>::StandaloneLaeroModelT(const AirframeProfile& airframe) {
+    setAirframe(airframe);
 }
 
-void StandaloneLaeroModel::setInitialState(const AircraftState& initialState) {
+template<class T>
+void StandaloneLaeroModelT<T>::setAirframe(const AirframeProfile& airframe) {
+    m_control = airframe.control;
+    m_limits = airframe.limits;
+}
+
+template<class T>
+void StandaloneLaeroModelT<T>::setInitialVelocityKts(double kts) {
+    const T KTS2MPS = T(oe_base::units::KTS2MPS);
+    u = T(kts) * KTS2MPS;
+    m_state.bodyVelocity.set(u, T(0), T(0));
+}
+
+template<class T>
+void StandaloneLaeroModelT<T>::setInitialState(const AircraftStateT<T>& initialState) {
     m_state = initialState;
     // 关键: 同时初始化内部使用的机体速度u, 否则控制律会出错
     u = m_state.bodyVelocity.length();
 }
 
 
-void StandaloneLaeroModel::update(const double dt) {
-    dT = dt;
-    updateModel(dt);
+template<class T>
+void StandaloneLaeroModelT<T>::update(const double dt) {
+    LAERO_PROFILE_SCOPE(PHASE_INTEGRATION);
+    dT = T(dt);
+    if (m_integrator.type == INTEGRATOR_DEFAULT) {
+        updateModel(dt);
+    } else {
+        integrateOde(dt);
+    }
+}
+
+template<class T>
+void StandaloneLaeroModelT<T>::setIntegrator(const IntegratorConfig& config) {
+    // 换用其他方法时历史值失效
+    if (config.type != m_integrator.type) m_historyCount = T(0);
+    m_integrator = config;
 }
 
-void StandaloneLaeroModel::updateModel(const double dt) {
+template<class T>
+void StandaloneLaeroModelT<T>::updateModel(const double dtIn) {
+    const T dt = T(dtIn);
     // ==============================================================
     // 旋转方程 EOM
     // ==============================================================
-    double& phi = m_state.roll;
-    double& tht = m_state.pitch;
-    double& psi = m_state.yaw;
+    T& phi = m_state.roll;
+    T& tht = m_state.pitch;
+    T& psi = m_state.yaw;
 
-    phi += 0.5 * (3.0 * phiDot - phiDot1) * dT;
+    phi += T(0.5) * (T(3.0) * phiDot - phiDot1) * dT;
     phi = oe_base::aepcdRad(phi);
 
-    tht += 0.5 * (3.0 * thtDot - thtDot1) * dT;
-    if (tht >= HALF_PI) tht = (HALF_PI - EPSILON);
-    if (tht <= -HALF_PI) tht = -(HALF_PI - EPSILON);
+    tht += T(0.5) * (T(3.0) * thtDot - thtDot1) * dT;
+    if (tht >= T(HALF_PI)) tht = T(HALF_PI - EPSILON);
+    if (tht <= -T(HALF_PI)) tht = -T(HALF_PI - EPSILON);
 
-    psi += 0.5 * (3.0 * psiDot - psiDot1) * dT;
+    psi += T(0.5) * (T(3.0) * psiDot - psiDot1) * dT;
     psi = oe_base::aepcdRad(psi);
 
     phiDot1 = phiDot;
     thtDot1 = thtDot;
     psiDot1 = psiDot;
     
-    double sinPhi = std::sin(phi), cosPhi = std::cos(phi);
-    double sinTht = std::sin(tht), cosTht = std::cos(tht);
-    double sinPsi = std::sin(psi), cosPsi = std::cos(psi);
-
-    double l1 = cosTht * cosPsi;
-    double l2 = cosTht * sinPsi;
-    double l3 = -sinTht;
-    double m1 = sinPhi * sinTht * cosPsi - cosPhi * sinPsi;
-    double m2 = sinPhi * sinTht * sinPsi + cosPhi * cosPsi;
-    double m3 = sinPhi * cosTht;
-    double n1 = cosPhi * sinTht * cosPsi + sinPhi * sinPsi;
-    double n2 = cosPhi * sinTht * sinPsi - sinPhi * cosPsi;
-    double n3 = cosPhi * cosTht;
+    T sinPhi = std::sin(phi), cosPhi = std::cos(phi);
+    T sinTht = std::sin(tht), cosTht = std::cos(tht);
+    T sinPsi = std::sin(psi), cosPsi = std::cos(psi);
+
+    T l1 = cosTht * cosPsi;
+    T l2 = cosTht * sinPsi;
+    T l3 = -sinTht;
+    T m1 = sinPhi * sinTht * cosPsi - cosPhi * sinPsi;
+    T m2 = sinPhi * sinTht * sinPsi + cosPhi * cosPsi;
+    T m3 = sinPhi * cosTht;
+    T n1 = cosPhi * sinTht * cosPsi + sinPhi * sinPsi;
+    T n2 = cosPhi * sinTht * sinPsi - sinPhi * cosPsi;
+    T n3 = cosPhi * cosTht;
 
     p = phiDot - sinTht * psiDot;
     q = cosPhi * thtDot + cosTht * sinPhi * psiDot;
@@ -71,73 +101,86 @@ void StandaloneLaeroModel::updateModel(const double dt) {
     // ==============================================================
     // 平移方程 EOM
     // ==============================================================
-    u += 0.5 * (3.0 * uDot - uDot1) * dT;
-    v += 0.5 * (3.0 * vDot - vDot1) * dT;
-    w += 0.5 * (3.0 * wDot - wDot1) * dT;
+    u += T(0.5) * (T(3.0) * uDot - uDot1) * dT;
+    v += T(0.5) * (T(3.0) * vDot - vDot1) * dT;
+    w += T(0.5) * (T(3.0) * wDot - wDot1) * dT;
     m_state.bodyVelocity.set(u, v, w);
 
     uDot1 = uDot;
     vDot1 = vDot;
     wDot1 = wDot;
 
-    double velN = l1 * u + m1 * v + n1 * w;
-    double velE = l2 * u + m2 * v + n2 * w;
-    double velD = l3 * u + m3 * v + n3 * w;
+    T velN = l1 * u + m1 * v + n1 * w;
+    T velE = l2 * u + m2 * v + n2 * w;
+    T velD = l3 * u + m3 * v + n3 * w;
     m_state.velocity.set(velN, velE, velD);
 
     // 更新位置 (简单的欧拉积分)
-    double posX = m_state.position.x() + velN * dt;
-    double posY = m_state.position.y() + velE * dt;
-    double posZ = m_state.position.z() + velD * dt;
+    T posX = m_state.position.x() + velN * dt;
+    T posY = m_state.position.y() + velE * dt;
+    T posZ = m_state.position.z() + velD * dt;
     m_state.position.set(posX, posY, posZ);
 }
 
 // --- 控制律实现 ---
-bool StandaloneLaeroModel::flyPhi(double phiCmdDeg, double phiDotCmdDps) {
-    double phiCmdRad = phiCmdDeg * oe_base::angle::D2RCC;
-    double phiDotCmdRps = phiDotCmdDps * oe_base::angle::D2RCC;
+template<class T>
+bool StandaloneLaeroModelT<T>::flyPhi(T phiCmdDeg, T phiDotCmdDps) {
+    phiDot = rollRate(phiCmdDeg, phiDotCmdDps, m_state.roll);
+    return true;
+}
 
-    double phiErrRad = oe_base::aepcdRad(phiCmdRad - m_state.roll);
+template<class T>
+bool StandaloneLaeroModelT<T>::flyTht(T thtCmdDeg, T thtDotCmdDps) {
+    thtDot = pitchRate(thtCmdDeg, thtDotCmdDps, m_state.pitch);
+    return true;
+}
+
+template<class T>
+T StandaloneLaeroModelT<T>::rollRate(T phiCmdDeg, T phiDotCmdDps, T phi) const {
+    T phiCmdRad = phiCmdDeg * T(oe_base::angle::D2RCC);
+    T phiDotCmdRps = phiDotCmdDps * T(oe_base::angle::D2RCC);
 
-    const double TAU = 1.0;
-    double phiErrBrkRad = phiDotCmdRps * TAU;
+    T phiErrRad = oe_base::aepcdRad(phiCmdRad - phi);
+
+    const T TAU = T(m_control.phiTau);
+    T phiErrBrkRad = phiDotCmdRps * TAU;
     
-    double phiDotRps = oe_base::sign(phiErrRad) * phiDotCmdRps;
+    T phiDotRps = oe_base::sign(phiErrRad) * phiDotCmdRps;
     if (std::abs(phiErrRad) < phiErrBrkRad) {
         phiDotRps = (phiErrRad / phiErrBrkRad) * phiDotCmdRps;
     }
-    phiDot = phiDotRps;
-    return true;
+    return phiDotRps;
 }
 
-bool StandaloneLaeroModel::flyTht(double thtCmdDeg, double thtDotCmdDps) {
-    double thtCmdRad = thtCmdDeg * oe_base::angle::D2RCC;
-    double thtDotCmdRps = thtDotCmdDps * oe_base::angle::D2RCC;
+template<class T>
+T StandaloneLaeroModelT<T>::pitchRate(T thtCmdDeg, T thtDotCmdDps, T tht) const {
+    T thtCmdRad = thtCmdDeg * T(oe_base::angle::D2RCC);
+    T thtDotCmdRps = thtDotCmdDps * T(oe_base::angle::D2RCC);
     
-    double thtErrRad = thtCmdRad - m_state.pitch;
+    T thtErrRad = thtCmdRad - tht;
     
-    const double TAU = 1.0;
-    double thtErrBrkRad = thtDotCmdRps * TAU;
+    const T TAU = T(m_control.thtTau);
+    T thtErrBrkRad = thtDotCmdRps * TAU;
 
-    double thtDotRps = oe_base::sign(thtErrRad) * thtDotCmdRps;
+    T thtDotRps = oe_base::sign(thtErrRad) * thtDotCmdRps;
     if (std::abs(thtErrRad) < thtErrBrkRad) {
         thtDotRps = (thtErrRad / thtErrBrkRad) * thtDotCmdRps;
     }
-    thtDot = thtDotRps;
-    return true;
+    return thtDotRps;
 }
 
-bool StandaloneLaeroModel::flyPsi(double psiCmdDeg, double psiDotCmdDps) {
+template<class T>
+bool StandaloneLaeroModelT<T>::flyPsi(T psiCmdDeg, T psiDotCmdDps) {
     // 此函数在原始代码中存在，但高层指令未使用，为完整性保留
-    double psiCmdRad = psiCmdDeg * oe_base::angle::D2RCC;
-    double psiDotCmdRps = psiDotCmdDps * oe_base::angle::D2RCC;
+    T psiCmdRad = psiCmdDeg * T(oe_base::angle::D2RCC);
+    T psiDotCmdRps = psiDotCmdDps * T(oe_base::angle::D2RCC);
     
-    double psiErrRad = oe_base::aepcdRad(psiCmdRad - m_state.yaw);
+    T psiErrRad = oe_base::aepcdRad(psiCmdRad - m_state.yaw);
     
-    const double TAU = 1.0;
-    double psiErrBrkRad = psiDotCmdRps * TAU;
+    const T TAU = T(m_control.psiTau);
+    T psiErrBrkRad = psiDotCmdRps * TAU;
 
-    double psiDotRps = oe_base::sign(psiErrRad) * psiDotCmdRps;
+    T psiDotRps = oe_base::sign(psiErrRad) * psiDotCmdRps;
     if (std::abs(psiErrRad) < psiErrBrkRad) {
         psiDotRps = (psiErrRad / psiErrBrkRad) * psiDotCmdRps;
     }
@@ -146,72 +189,405 @@ bool StandaloneLaeroModel::flyPsi(double psiCmdDeg, double psiDotCmdDps) {
 }
 
 // --- 高层指令接口 ---
-void StandaloneLaeroModel::setCommandedHeadingD(double h, double hDps, double maxBank) {
-    const double MAX_BANK_RAD = maxBank * oe_base::angle::D2RCC;
-    const double TAU = 1.0;
+template<class T>
+void StandaloneLaeroModelT<T>::setCommandedHeadingD(double degs, double degsPerSec, double maxBankD) {
+    LAERO_PROFILE_SCOPE(PHASE_COMMAND);
+    const T h = T(degs), hDps = T(degsPerSec), maxBank = T(maxBankD);
+    m_cmdHdgD = h;
+    m_cmdHdgDps = hDps;
+    m_cmdMaxBankD = maxBank;
+
+    T phiCmdDeg = T(0);
+    psiDot = headingLaw(h, hDps, maxBank, m_state.yaw, m_state.bodyVelocity.length(), phiCmdDeg);
+    flyPhi(phiCmdDeg);
+}
+
+template<class T>
+T StandaloneLaeroModelT<T>::headingLaw(T h, T hDps, T maxBank, T yaw, T velMps, T& phiCmdDeg) const {
+    const T MAX_BANK_RAD = maxBank * T(oe_base::angle::D2RCC);
+    const T TAU = T(m_control.headingTau);
 
-    double velMps = m_state.bodyVelocity.length();
-    if (velMps < 1.0) velMps = 1.0; // 避免除零
+    if (velMps < T(1.0)) velMps = T(1.0); // 避免除零
 
-    double hdgDeg = m_state.yaw * oe_base::angle::R2DCC;
-    double hdgErrDeg = oe_base::aepcdDeg(h - hdgDeg);
+    T hdgDeg = yaw * T(oe_base::angle::R2DCC);
+    T hdgErrDeg = oe_base::aepcdDeg(h - hdgDeg);
 
-    double hdgDotMaxAbsRps = oe_base::ETHGM * std::tan(MAX_BANK_RAD) / velMps;
-    double hdgDotMaxAbsDps = hdgDotMaxAbsRps * oe_base::angle::R2DCC;
+    T hdgDotMaxAbsRps = T(oe_base::ETHGM) * std::tan(MAX_BANK_RAD) / velMps;
+    T hdgDotMaxAbsDps = hdgDotMaxAbsRps * T(oe_base::angle::R2DCC);
 
-    double hdgDotAbsDps = std::min(hDps, hdgDotMaxAbsDps);
+    T hdgDotAbsDps = std::min(hDps, hdgDotMaxAbsDps);
     
-    double hdgErrBrkAbsDeg = TAU * hdgDotAbsDps;
+    T hdgErrBrkAbsDeg = TAU * hdgDotAbsDps;
     if (std::abs(hdgErrDeg) < hdgErrBrkAbsDeg) {
         hdgDotAbsDps = std::abs(hdgErrDeg) / TAU;
     }
 
-    double hdgDotDps = oe_base::sign(hdgErrDeg) * hdgDotAbsDps;
-    psiDot = hdgDotDps * oe_base::angle::D2RCC;
+    T hdgDotDps = oe_base::sign(hdgErrDeg) * hdgDotAbsDps;
+    const T psiDotRps = hdgDotDps * T(oe_base::angle::D2RCC);
 
-    double phiCmdDeg = std::atan2(psiDot * velMps, oe_base::ETHGM) * oe_base::angle::R2DCC;
-    flyPhi(phiCmdDeg);
+    phiCmdDeg = std::atan2(psiDotRps * velMps, T(oe_base::ETHGM)) * T(oe_base::angle::R2DCC);
+    return psiDotRps;
 }
 
-void StandaloneLaeroModel::setCommandedAltitude(double a, double aMps, double maxPitch) {
-    const double TAU = 4.0;
-    double altMtr = -m_state.position.z(); // 假设Z轴朝下（NED坐标系）
-    double altErrMtr = a - altMtr;
+template<class T>
+void StandaloneLaeroModelT<T>::setCommandedAltitude(double meters, double metersPerSec, double maxPitchD) {
+    LAERO_PROFILE_SCOPE(PHASE_COMMAND);
+    const T a = T(meters), aMps = T(metersPerSec), maxPitch = T(maxPitchD);
+    m_cmdAltM = a;
+    m_cmdAltMps = aMps;
+    m_cmdMaxPitchD = maxPitch;
+
+    flyTht(altitudeLaw(a, aMps, maxPitch, m_state.position.z(), m_state.bodyVelocity.x()));
+}
+
+template<class T>
+T StandaloneLaeroModelT<T>::altitudeLaw(T a, T aMps, T maxPitch, T posZ, T velU) const {
+    const T TAU = T(m_control.altitudeTau);
+    T altMtr = -posZ; // 假设Z轴朝下（NED坐标系）
+    T altErrMtr = a - altMtr;
     
-    double altDotCmdMps = aMps;
-    double altErrBrkMtr = altDotCmdMps * TAU;
+    T altDotCmdMps = aMps;
+    T altErrBrkMtr = altDotCmdMps * TAU;
 
-    double altDotMps = oe_base::sign(altErrMtr) * altDotCmdMps;
+    T altDotMps = oe_base::sign(altErrMtr) * altDotCmdMps;
     if (std::abs(altErrMtr) < altErrBrkMtr) {
         altDotMps = altErrMtr * (altDotCmdMps / altErrBrkMtr);
     }
     
-    double velU = m_state.bodyVelocity.x();
-    if (std::abs(velU) < 1.0) velU = 1.0;
+    if (std::abs(velU) < T(1.0)) velU = T(1.0);
 
-    double thtCmdRad = std::asin(altDotMps / velU);
-    double thtCmdDeg = thtCmdRad * oe_base::angle::R2DCC;
+    T thtCmdRad = std::asin(altDotMps / velU);
+    T thtCmdDeg = thtCmdRad * T(oe_base::angle::R2DCC);
     
     // 限制最大俯仰角
-    thtCmdDeg = std::max(-maxPitch, std::min(maxPitch, thtCmdDeg));
-    
-    flyTht(thtCmdDeg);
+    return std::max(-maxPitch, std::min(maxPitch, thtCmdDeg));
 }
 
-void StandaloneLaeroModel::setCommandedVelocityKts(double v, double vNps) {
-    const double KTS2MPS = 1852.0 / 3600.0;
-    double velCmdMps = v * KTS2MPS;
-    double velDotCmdMps2 = vNps * KTS2MPS;
+template<class T>
+void StandaloneLaeroModelT<T>::setCommandedVelocityKts(double kts, double ktsPerSec) {
+    LAERO_PROFILE_SCOPE(PHASE_COMMAND);
+    const T velKts = T(kts), vNps = T(ktsPerSec);
+    m_cmdVelKts = velKts;
+    m_cmdVelNps = vNps;
+
+    uDot = velocityLaw(velKts, vNps, m_state.bodyVelocity.x()); // 只考虑前向速度
+}
+
+template<class T>
+T StandaloneLaeroModelT<T>::velocityLaw(T velKts, T vNps, T velMps) const {
+    const T KTS2MPS = T(oe_base::units::KTS2MPS);
+    T velCmdMps = velKts * KTS2MPS;
+    T velDotCmdMps2 = vNps * KTS2MPS;
     
-    double velMps = m_state.bodyVelocity.x(); // 只考虑前向速度
-    double velErrMps = velCmdMps - velMps;
+    T velErrMps = velCmdMps - velMps;
     
-    const double TAU = 1.0;
-    double velErrBrkMps = velDotCmdMps2 * TAU;
+    const T TAU = T(m_control.velocityTau);
+    T velErrBrkMps = velDotCmdMps2 * TAU;
 
-    double velDotMps2 = oe_base::sign(velErrMps) * velDotCmdMps2;
+    T velDotMps2 = oe_base::sign(velErrMps) * velDotCmdMps2;
     if (std::abs(velErrMps) < velErrBrkMps) {
         velDotMps2 = (velErrMps / velErrBrkMps) * velDotCmdMps2;
     }
-    uDot = velDotMps2;
-}
\ No newline at end of file
+    return velDotMps2;
+}
+
+// --- 常微分方程形式 (非默认积分方法) ---
+template<class T>
+typename StandaloneLaeroModelT<T>::StateVector StandaloneLaeroModelT<T>::packState() const {
+    StateVector y;
+    y[S_PHI] = m_state.roll;
+    y[S_THT] = m_state.pitch;
+    y[S_PSI] = m_state.yaw;
+    y[S_U] = u;
+    y[S_V] = v;
+    y[S_W] = w;
+    y[S_X] = m_state.position.x();
+    y[S_Y] = m_state.position.y();
+    y[S_Z] = m_state.position.z();
+    return y;
+}
+
+template<class T>
+void StandaloneLaeroModelT<T>::derivative(const StateVector& y, StateVector& dy) const {
+    // 按保存的指令在状态 y 上重新计算控制律 (与 applyStoredCommands 相同的通道), 未下达指令的通道保持当前速率
+    T phiD = phiDot, thtD = thtDot, psiD = psiDot, uD = uDot;
+    if (m_cmdAltM != T(NO_COMMAND)) {
+        thtD = pitchRate(altitudeLaw(m_cmdAltM, m_cmdAltMps, m_cmdMaxPitchD, y[S_Z], y[S_U]), T(10.0), y[S_THT]);
+    }
+    if (m_cmdVelKts != T(NO_COMMAND)) {
+        uD = velocityLaw(m_cmdVelKts, m_cmdVelNps, y[S_U]);
+    }
+    if (m_cmdHdgD != T(NO_COMMAND)) {
+        const T velMps = std::sqrt(y[S_U] * y[S_U] + y[S_V] * y[S_V] + y[S_W] * y[S_W]);
+        T phiCmdDeg = T(0);
+        psiD = headingLaw(m_cmdHdgD, m_cmdHdgDps, m_cmdMaxBankD, y[S_PSI], velMps, phiCmdDeg);
+        phiD = rollRate(phiCmdDeg, T(30.0), y[S_PHI]);
+    }
+
+    dy[S_PHI] = phiD;
+    dy[S_THT] = thtD;
+    dy[S_PSI] = psiD;
+    dy[S_U] = uD;
+    dy[S_V] = vDot;
+    dy[S_W] = wDot;
+
+    // 位置导数: 机体速度转到世界坐标系
+    const T sinPhi = std::sin(y[S_PHI]), cosPhi = std::cos(y[S_PHI]);
+    const T sinTht = std::sin(y[S_THT]), cosTht = std::cos(y[S_THT]);
+    const T sinPsi = std::sin(y[S_PSI]), cosPsi = std::cos(y[S_PSI]);
+    const T bu = y[S_U], bv = y[S_V], bw = y[S_W];
+    dy[S_X] = cosTht * cosPsi * bu + (sinPhi * sinTht * cosPsi - cosPhi * sinPsi) * bv + (cosPhi * sinTht * cosPsi + sinPhi * sinPsi) * bw;
+    dy[S_Y] = cosTht * sinPsi * bu + (sinPhi * sinTht * sinPsi + cosPhi * cosPsi) * bv + (cosPhi * sinTht * sinPsi - sinPhi * cosPsi) * bw;
+    dy[S_Z] = -sinTht * bu + sinPhi * cosTht * bv + cosPhi * cosTht * bw;
+}
+
+template<class T>
+void StandaloneLaeroModelT<T>::integrateOde(const double dtIn) {
+    const T h = T(dtIn);
+    const StateVector y0 = packState();
+    StateVector f0;
+    derivative(y0, f0);
+    size_t evals = 1;
+
+    const StateVector f1 = { phiDot1, thtDot1, psiDot1, uDot1, vDot1, wDot1, velN1, velE1, velD1 };
+    const StateVector f2 = { phiDot2, thtDot2, psiDot2, uDot2, vDot2, wDot2, velN2, velE2, velD2 };
+    const T angTol = T(m_integrator.angleTol), velTol = T(m_integrator.velocityTol), posTol = T(m_integrator.positionTol);
+    const StateVector tol = { angTol, angTol, angTol, velTol, velTol, velTol, posTol, posTol, posTol };
+
+    auto f = [this](const StateVector& y, StateVector& dy) { derivative(y, dy); };
+    const StateVector y1 = integrator::advance(m_integrator, y0, f0, f1, f2, tol, h,
+                                               m_historyCount, m_historyDt, m_adaptiveStep, f, evals);
+    m_derivativeEvals += evals;
+    LAERO_PROFILE_COUNT(COUNTER_DERIVATIVE_EVALS, evals);
+
+    // 历史值后移
+    phiDot2 = phiDot1; thtDot2 = thtDot1; psiDot2 = psiDot1;
+    uDot2 = uDot1; vDot2 = vDot1; wDot2 = wDot1;
+    velN2 = velN1; velE2 = velE1; velD2 = velD1;
+    phiDot1 = f0[S_PHI]; thtDot1 = f0[S_THT]; psiDot1 = f0[S_PSI];
+    uDot1 = f0[S_U]; vDot1 = f0[S_V]; wDot1 = f0[S_W];
+    velN1 = f0[S_X]; velE1 = f0[S_Y]; velD1 = f0[S_Z];
+
+    // 速率取步长起点的值 (与 updateModel 相同)
+    phiDot = f0[S_PHI];
+    thtDot = f0[S_THT];
+    psiDot = f0[S_PSI];
+    uDot = f0[S_U];
+
+    T phi = oe_base::aepcdRad(y1[S_PHI]);
+    T tht = y1[S_THT];
+    if (tht >= T(HALF_PI)) tht = T(HALF_PI - EPSILON);
+    if (tht <= -T(HALF_PI)) tht = -T(HALF_PI - EPSILON);
+    T psi = oe_base::aepcdRad(y1[S_PSI]);
+    m_state.roll = phi;
+    m_state.pitch = tht;
+    m_state.yaw = psi;
+
+    const T sinPhi = std::sin(phi), cosPhi = std::cos(phi);
+    const T sinTht = std::sin(tht), cosTht = std::cos(tht);
+    const T sinPsi = std::sin(psi), cosPsi = std::cos(psi);
+    p = phiDot - sinTht * psiDot;
+    q = cosPhi * thtDot + cosTht * sinPhi * psiDot;
+    r = -sinPhi * thtDot + cosTht * cosPhi * psiDot;
+    m_state.angularVelocity.set(p, q, r);
+
+    u = y1[S_U];
+    v = y1[S_V];
+    w = y1[S_W];
+    m_state.bodyVelocity.set(u, v, w);
+    m_state.velocity.set(cosTht * cosPsi * u + (sinPhi * sinTht * cosPsi - cosPhi * sinPsi) * v + (cosPhi * sinTht * cosPsi + sinPhi * sinPsi) * w,
+                         cosTht * sinPsi * u + (sinPhi * sinTht * sinPsi + cosPhi * cosPsi) * v + (cosPhi * sinTht * sinPsi - sinPhi * cosPsi) * w,
+                         -sinTht * u + sinPhi * cosTht * v + cosPhi * cosTht * w);
+    m_state.position.set(y1[S_X], y1[S_Y], y1[S_Z]);
+}
+// --- 内部变量 ---
+template<class T>
+typename StandaloneLaeroModelT<T>::Internals StandaloneLaeroModelT<T>::getInternals() const {
+    Internals in;
+    in.p = p; in.q = q; in.r = r;
+    in.phiDot = phiDot; in.thtDot = thtDot; in.psiDot = psiDot;
+    in.u = u; in.v = v; in.w = w;
+    in.uDot = uDot; in.vDot = vDot; in.wDot = wDot;
+    in.phiDot1 = phiDot1; in.thtDot1 = thtDot1; in.psiDot1 = psiDot1;
+    in.uDot1 = uDot1; in.vDot1 = vDot1; in.wDot1 = wDot1;
+    in.dT = dT;
+    in.velN1 = velN1; in.velE1 = velE1; in.velD1 = velD1;
+    in.phiDot2 = phiDot2; in.thtDot2 = thtDot2; in.psiDot2 = psiDot2;
+    in.uDot2 = uDot2; in.vDot2 = vDot2; in.wDot2 = wDot2;
+    in.velN2 = velN2; in.velE2 = velE2; in.velD2 = velD2;
+    in.historyCount = m_historyCount; in.historyDt = m_historyDt;
+    in.adaptiveStep = m_adaptiveStep;
+    in.cmdHdgD = m_cmdHdgD; in.cmdHdgDps = m_cmdHdgDps; in.cmdMaxBankD = m_cmdMaxBankD;
+    in.cmdAltM = m_cmdAltM; in.cmdAltMps = m_cmdAltMps; in.cmdMaxPitchD = m_cmdMaxPitchD;
+    in.cmdVelKts = m_cmdVelKts; in.cmdVelNps = m_cmdVelNps;
+    return in;
+}
+
+template<class T>
+void StandaloneLaeroModelT<T>::setInternals(const Internals& in) {
+    p = in.p; q = in.q; r = in.r;
+    phiDot = in.phiDot; thtDot = in.thtDot; psiDot = in.psiDot;
+    u = in.u; v = in.v; w = in.w;
+    uDot = in.uDot; vDot = in.vDot; wDot = in.wDot;
+    phiDot1 = in.phiDot1; thtDot1 = in.thtDot1; psiDot1 = in.psiDot1;
+    uDot1 = in.uDot1; vDot1 = in.vDot1; wDot1 = in.wDot1;
+    dT = in.dT;
+    velN1 = in.velN1; velE1 = in.velE1; velD1 = in.velD1;
+    phiDot2 = in.phiDot2; thtDot2 = in.thtDot2; psiDot2 = in.psiDot2;
+    uDot2 = in.uDot2; vDot2 = in.vDot2; wDot2 = in.wDot2;
+    velN2 = in.velN2; velE2 = in.velE2; velD2 = in.velD2;
+    m_historyCount = in.historyCount; m_historyDt = in.historyDt;
+    m_adaptiveStep = in.adaptiveStep;
+    m_cmdHdgD = in.cmdHdgD; m_cmdHdgDps = in.cmdHdgDps; m_cmdMaxBankD = in.cmdMaxBankD;
+    m_cmdAltM = in.cmdAltM; m_cmdAltMps = in.cmdAltMps; m_cmdMaxPitchD = in.cmdMaxPitchD;
+    m_cmdVelKts = in.cmdVelKts; m_cmdVelNps = in.cmdVelNps;
+}
+
+// --- 快进 ---
+template<class T>
+size_t StandaloneLaeroModelT<T>::fastForward(double duration, double dt) {
+    if (dt <= 0.0 || duration <= 0.0) return 0;
+    const size_t total = static_cast<size_t>(duration / dt + 1.0e-9);
+
+    size_t done = 0;
+    while (done < total) {
+        applyStoredCommands();
+
+        T turnRate = T(0);
+        const double limit = double(steadyTimeLimit(turnRate));
+        size_t n = 0;
+        // 闭式解对应默认积分方法的逐步结果, 其他积分方法只逐步推进
+        if (limit >= 0.0 && m_integrator.type == INTEGRATOR_DEFAULT) {
+            const size_t remaining = total - done;
+            if (limit >= remaining * dt) {
+                n = remaining;
+            } else {
+                // 留一步余量, 保证跳跃结束时控制律仍在饱和段内
+                n = static_cast<size_t>(limit / dt);
+                n = (n > 1) ? n - 1 : 0;
+            }
+        }
+
+        if (n >= 2) {
+            propagateSteady(n, dt, turnRate);
+            done += n;
+        } else {
+            update(dt);
+            ++done;
+        }
+    }
+    return total;
+}
+
+template<class T>
+void StandaloneLaeroModelT<T>::applyStoredCommands() {
+    if (m_cmdAltM != T(NO_COMMAND)) setCommandedAltitude(m_cmdAltM, m_cmdAltMps, m_cmdMaxPitchD);
+    if (m_cmdVelKts != T(NO_COMMAND)) setCommandedVelocityKts(m_cmdVelKts, m_cmdVelNps);
+    if (m_cmdHdgD != T(NO_COMMAND)) setCommandedHeadingD(m_cmdHdgD, m_cmdHdgDps, m_cmdMaxBankD);
+}
+
+template<class T>
+T StandaloneLaeroModelT<T>::steadyTimeLimit(T& turnRate) const {
+    const T tol = T(m_steadyTol);
+
+    // 滚转、俯仰和前向速度已收敛, 偏航角速率恒定
+    if (std::abs(phiDot) > tol || std::abs(phiDot1) > tol) return T(-1.0);
+    if (std::abs(thtDot) > tol || std::abs(thtDot1) > tol) return T(-1.0);
+    if (std::abs(uDot) > tol || std::abs(uDot1) > tol) return T(-1.0);
+    if (std::abs(vDot) > tol || std::abs(wDot) > tol) return T(-1.0);
+    if (std::abs(psiDot - psiDot1) > tol) return T(-1.0);
+
+    T limit = std::numeric_limits<T>::infinity();
+    turnRate = psiDot;
+
+    // --- 航向: 饱和段内以恒定速率转弯, 直到误差进入断点; 比例段内须已收敛 ---
+    if (m_cmdHdgD != T(NO_COMMAND)) {
+        T velMps = m_state.bodyVelocity.length();
+        if (velMps < T(1.0)) velMps = T(1.0);
+
+        const T hdgErrDeg = oe_base::aepcdDeg(m_cmdHdgD - m_state.yaw * T(oe_base::angle::R2DCC));
+        const T hdgDotMaxAbsDps = T(oe_base::ETHGM) * std::tan(m_cmdMaxBankD * T(oe_base::angle::D2RCC)) / velMps * T(oe_base::angle::R2DCC);
+        const T hdgDotAbsDps = std::min(m_cmdHdgDps, hdgDotMaxAbsDps);
+        const T hdgErrBrkAbsDeg = T(m_control.headingTau) * hdgDotAbsDps;
+
+        if (std::abs(hdgErrDeg) < hdgErrBrkAbsDeg) {
+            if (std::abs(psiDot) > tol) return T(-1.0);
+            turnRate = T(0); // 已对准指令航向
+        } else if (hdgDotAbsDps > T(0)) {
+            limit = std::min(limit, (std::abs(hdgErrDeg) - hdgErrBrkAbsDeg) / hdgDotAbsDps);
+        }
+    }
+
+    // --- 高度: 饱和段内等速爬升/下降, 直到误差进入断点; 比例段内须已收敛 ---
+    if (m_cmdAltM != T(NO_COMMAND)) {
+        const T altErrMtr = m_cmdAltM + m_state.position.z();
+        const T altErrBrkMtr = m_cmdAltMps * T(m_control.altitudeTau);
+        const T climbMps = -m_state.velocity.z();
+
+        if (std::abs(altErrMtr) < altErrBrkMtr) {
+            if (std::abs(climbMps) > tol) return T(-1.0);
+        } else if (std::abs(climbMps) > tol && oe_base::sign(climbMps) == oe_base::sign(altErrMtr)) {
+            limit = std::min(limit, (std::abs(altErrMtr) - altErrBrkMtr) / std::abs(climbMps));
+        }
+    }
+    return limit;
+}
+
+template<class T>
+void StandaloneLaeroModelT<T>::propagateSteady(size_t n, const double dtIn, T turnRate) {
+    const T dt = T(dtIn);
+    // 姿态和机体速度保持不变, 偏航角每步增加 theta = turnRate * dt。
+    // 世界坐标系速度是机体速度绕z轴旋转 psi: velN = a*cos(psi) - b*sin(psi), velE = a*sin(psi) + b*cos(psi),
+    // 逐步欧拉积分的位置增量是等比数列 sum(exp(i*psi_k)), k = 1..n, 按闭式求和。
+    const T phi = m_state.roll;
+    const T tht = m_state.pitch;
+    const T psi0 = m_state.yaw;
+
+    const T sinPhi = std::sin(phi), cosPhi = std::cos(phi);
+    const T sinTht = std::sin(tht), cosTht = std::cos(tht);
+
+    const T a = cosTht * u + sinPhi * sinTht * v + cosPhi * sinTht * w;
+    const T b = cosPhi * v - sinPhi * w;
+    const T velD = -sinTht * u + sinPhi * cosTht * v + cosPhi * cosTht * w;
+
+    const T N = static_cast<T>(n);
+    const T theta = turnRate * dt;
+    const T halfTheta = T(0.5) * theta;
+    const T sinHalf = std::sin(halfTheta);
+    const T ratio = (std::abs(sinHalf) > T(1.0e-12)) ? std::sin(N * halfTheta) / sinHalf : N;
+    const T mid = psi0 + (N + T(1.0)) * halfTheta;
+    const T sumCos = ratio * std::cos(mid);
+    const T sumSin = ratio * std::sin(mid);
+
+    m_state.position.set(m_state.position.x() + dt * (a * sumCos - b * sumSin),
+                         m_state.position.y() + dt * (a * sumSin + b * sumCos),
+                         m_state.position.z() + N * dt * velD);
+
+    // 偏航角 (大角度先用 fmod 约简)
+    T psi = std::fmod(psi0 + N * theta, T(2.0 * oe_base::PI));
+    psi = oe_base::aepcdRad(psi);
+    m_state.yaw = psi;
+
+    const T sinPsi = std::sin(psi), cosPsi = std::cos(psi);
+    m_state.velocity.set(a * cosPsi - b * sinPsi, a * sinPsi + b * cosPsi, velD);
+
+    // 角速度与历史值 (与逐步积分在稳态下相同)
+    psiDot = turnRate;
+    p = phiDot - sinTht * psiDot;
+    q = cosPhi * thtDot + cosTht * sinPhi * psiDot;
+    r = -sinPhi * thtDot + cosTht * cosPhi * psiDot;
+    m_state.angularVelocity.set(p, q, r);
+
+    phiDot1 = phiDot;
+    thtDot1 = thtDot;
+    psiDot1 = psiDot;
+    uDot1 = uDot;
+    vDot1 = vDot;
+    wDot1 = wDot;
+    dT = dt;
+}
+
+// --- 显式实例化 ---
+template class StandaloneLaeroModelT<double>;
+template class StandaloneLaeroModelT<float>;
+
@@ -2,55 +2,178 @@
 #ifndef STANDALONE_LAERO_MODEL_HPP
 #define STANDALONE_LAERO_MODEL_HPP
 
+#include <cstdint>
 #include "AircraftState.hpp"
+#include "AirframeProfile.hpp"
+#include "FlightModel.hpp"
+#include "Integrator.hpp"
+#include "LaeroControlParams.hpp"
 
-class StandaloneLaeroModel {
+// T 为标量类型: 状态、内部变量和全部计算都使用 T; 指令和参数接口保持 double。
+// 成员函数在 StandaloneLaeroModel.cpp 中定义, 并显式实例化 double 和 float 两个版本。
+template<class T>
+class StandaloneLaeroModelT : public FlightModel<StandaloneLaeroModelT<T>, T> {
 public:
-    StandaloneLaeroModel();
+    StandaloneLaeroModelT();
+    // 按机型参数构造: 控制律时间常数和指令性能参数取自 airframe (见 AirframeProfile.hpp)
+    explicit StandaloneLaeroModelT(const AirframeProfile& airframe);
 
     // --- 公共接口 ---
     void update(const double dt);
     
-    void setCommandedHeadingD(double degs, double hDps = 20.0, double maxBankD = 30.0);
-    void setCommandedAltitude(double meters, double aMps = 150.0, double maxPitchD = 15.0);
-    void setCommandedVelocityKts(double kts, double vNps = 5.0);
+    // 省略的性能参数取 getCommandLimits() (默认 20度/秒、30度, 150米/秒、15度, 5节/秒)
+    void setCommandedHeadingD(double degs) { setCommandedHeadingD(degs, m_limits.hDps, m_limits.maxBankD); }
+    void setCommandedHeadingD(double degs, double hDps) { setCommandedHeadingD(degs, hDps, m_limits.maxBankD); }
+    void setCommandedHeadingD(double degs, double hDps, double maxBankD);
+    void setCommandedAltitude(double meters) { setCommandedAltitude(meters, m_limits.aMps, m_limits.maxPitchD); }
+    void setCommandedAltitude(double meters, double aMps) { setCommandedAltitude(meters, aMps, m_limits.maxPitchD); }
+    void setCommandedAltitude(double meters, double aMps, double maxPitchD);
+    void setCommandedVelocityKts(double kts) { setCommandedVelocityKts(kts, m_limits.vNps); }
+    void setCommandedVelocityKts(double kts, double vNps);
 
-    const AircraftState& getState() const { return m_state; }
-    void setInitialState(const AircraftState& initialState);
+    // --- 快进 (批量模式) ---
+    // 以最后一次下达的指令推进 duration 秒, 结果等价于每个 dt 调用一次 setCommanded*() 和 update(dt)。
+    // 处于稳态 (phiDot、thtDot、uDot ≈ 0, psiDot 恒定: 平飞巡航、等速爬升/下降、稳定盘旋) 时按闭式解一次跳过多步,
+    // 直到某条控制律即将离开饱和段; 非稳态时逐步积分。返回推进的步数。
+    size_t fastForward(double duration, double dt);
+    // 稳态判据: 角速率 (rad/s)、前向加速度 (m/s^2) 和比例段内垂直速度 (m/s) 的容差
+    void setSteadyTolerance(double tol) { m_steadyTol = tol; }
+    double getSteadyTolerance() const { return m_steadyTol; }
+
+    const AircraftStateT<T>& getState() const { return m_state; }
+    void setInitialState(const AircraftStateT<T>& initialState);
     void setInitialVelocityKts(double kts);
 
+    // 控制律时间常数
+    void setControlParams(const LaeroControlParams& params) { m_control = params; }
+    const LaeroControlParams& getControlParams() const { return m_control; }
+
+    // 指令性能参数的缺省值
+    void setCommandLimits(const LaeroCommandLimits& limits) { m_limits = limits; }
+    const LaeroCommandLimits& getCommandLimits() const { return m_limits; }
+
+    // 机型参数 = 控制律时间常数 + 指令性能参数 (名称不保存在模型中)
+    void setAirframe(const AirframeProfile& airframe);
+
+    // 积分方法 (见 Integrator.hpp); 默认 INTEGRATOR_DEFAULT 与原来逐位相同。
+    // 其他方法每个阶段按保存的指令重新计算控制律, 未下达指令的通道保持当前速率; fastForward 不再按闭式跳跃。
+    void setIntegrator(const IntegratorConfig& config);
+    const IntegratorConfig& getIntegrator() const { return m_integrator; }
+    // 非默认积分方法累计的导数计算次数 (衡量计算量)
+    uint64_t derivativeEvaluations() const { return m_derivativeEvals; }
+
+    // --- 内部变量 (模型切换时交接状态) ---
+    static constexpr double NO_COMMAND = -9999.0; // 未下达的指令
+
+    struct Internals {
+        T p, q, r;
+        T phiDot, thtDot, psiDot;
+        T u, v, w;
+        T uDot, vDot, wDot;
+        T phiDot1, thtDot1, psiDot1;   // Adams-Bashforth历史值
+        T uDot1, vDot1, wDot1;
+        T dT;
+
+        // ABM3 历史值: 上一步的位置导数, 以及再前一步的全部导数
+        T velN1, velE1, velD1;
+        T phiDot2, thtDot2, psiDot2;
+        T uDot2, vDot2, wDot2;
+        T velN2, velE2, velD2;
+        T historyCount, historyDt;     // 有效历史步数 (0..2) 及其步长
+        T adaptiveStep;                // ADAPTIVE 上次的子步长
+
+        // 最后一次下达的指令
+        T cmdHdgD, cmdHdgDps, cmdMaxBankD;
+        T cmdAltM, cmdAltMps, cmdMaxPitchD;
+        T cmdVelKts, cmdVelNps;
+    };
+    Internals getInternals() const;
+    // 只替换内部变量, 不改变 getState()
+    void setInternals(const Internals& in);
+
 private:
     // --- 私有辅助函数 (移植自LaeroModel) ---
     void updateModel(const double dt);
-    bool flyPhi(double phiCmdDeg, double phiDotCmdDps = 30.0);
-    bool flyTht(double thtCmdDeg, double thtDotCmdDps = 10.0);
-    bool flyPsi(double psiCmdDeg, double psiDotCmdDps = 20.0);
+    bool flyPhi(T phiCmdDeg, T phiDotCmdDps = T(30.0));
+    bool flyTht(T thtCmdDeg, T thtDotCmdDps = T(10.0));
+    bool flyPsi(T psiCmdDeg, T psiDotCmdDps = T(20.0));
+
+    // 快进辅助: 按保存的指令重新计算控制律; 稳态时返回可以跳过的时间 (秒), 否则返回负数
+    void applyStoredCommands();
+    // turnRate 返回跳跃期间使用的偏航角速率 (rad/s)
+    T steadyTimeLimit(T& turnRate) const;
+    // 稳态闭式推进n步
+    void propagateSteady(size_t n, const double dt, T turnRate);
+
+    // --- 控制律 (纯函数, 输入为状态分量; setCommanded* 和 derivative 共用) ---
+    // 返回偏航角速率 (rad/s), phiCmdDeg 输出协调转弯所需的滚转角
+    T headingLaw(T h, T hDps, T maxBank, T yaw, T velMps, T& phiCmdDeg) const;
+    // 返回俯仰角指令 (度)
+    T altitudeLaw(T a, T aMps, T maxPitch, T posZ, T velU) const;
+    // 返回前向加速度 (m/s^2)
+    T velocityLaw(T velKts, T vNps, T velMps) const;
+    T rollRate(T phiCmdDeg, T phiDotCmdDps, T phi) const;
+    T pitchRate(T thtCmdDeg, T thtDotCmdDps, T tht) const;
+
+    // --- 常微分方程形式 (非默认积分方法) ---
+    // 状态向量: 欧拉角、机体速度、位置
+    enum { S_PHI = 0, S_THT, S_PSI, S_U, S_V, S_W, S_X, S_Y, S_Z, STATE_SIZE };
+    typedef integrator::StateVector<T, STATE_SIZE> StateVector;
+
+    StateVector packState() const;
+    void derivative(const StateVector& y, StateVector& dy) const;
+    void integrateOde(const double dt);
 
 private:
     // --- 模型状态和内部变量 ---
-    AircraftState m_state;
+    AircraftStateT<T> m_state;
+    LaeroControlParams m_control;
+    LaeroCommandLimits m_limits;
+
+    // 最后一次下达的指令 (未设置时为 NO_COMMAND), 供 fastForward 重复使用
+    T m_cmdHdgD = T(NO_COMMAND), m_cmdHdgDps = T(20.0), m_cmdMaxBankD = T(30.0);
+    T m_cmdAltM = T(NO_COMMAND), m_cmdAltMps = T(150.0), m_cmdMaxPitchD = T(15.0);
+    T m_cmdVelKts = T(NO_COMMAND), m_cmdVelNps = T(5.0);
+    double m_steadyTol = 1.0e-7;
+
+    IntegratorConfig m_integrator;
+    uint64_t m_derivativeEvals = 0;
 
     // --- LaeroModel的内部变量 ---
-    static const double HALF_PI;
-    static const double EPSILON;
+    static constexpr double HALF_PI = oe_base::PI / 2.0;
+    static constexpr double EPSILON = 1.0E-10;
     
-    double dT = 0.0;
+    T dT = T(0);
     
     // 机体角速度分量 (p, q, r)
-    double p = 0.0, q = 0.0, r = 0.0;
+    T p = T(0), q = T(0), r = T(0);
     
     // 欧拉角速率 (phiDot, thtDot, psiDot)
-    double phiDot = 0.0, thtDot = 0.0, psiDot = 0.0;
+    T phiDot = T(0), thtDot = T(0), psiDot = T(0);
     
     // 机体线速度分量 (u, v, w)
-    double u = 0.0, v = 0.0, w = 0.0;
+    T u = T(0), v = T(0), w = T(0);
 
     // 机体线加速度分量 (uDot, vDot, wDot)
-    double uDot = 0.0, vDot = 0.0, wDot = 0.0;
+    T uDot = T(0), vDot = T(0), wDot = T(0);
 
     // Adams-Bashforth积分的历史值
-    double phiDot1 = 0.0, thtDot1 = 0.0, psiDot1 = 0.0;
-    double uDot1 = 0.0, vDot1 = 0.0, wDot1 = 0.0;
+    T phiDot1 = T(0), thtDot1 = T(0), psiDot1 = T(0);
+    T uDot1 = T(0), vDot1 = T(0), wDot1 = T(0);
+
+    // ABM3 的历史值 (前一步起点的导数为 *1, 再前一步为 *2)
+    T velN1 = T(0), velE1 = T(0), velD1 = T(0);
+    T phiDot2 = T(0), thtDot2 = T(0), psiDot2 = T(0);
+    T uDot2 = T(0), vDot2 = T(0), wDot2 = T(0);
+    T velN2 = T(0), velE2 = T(0), velD2 = T(0);
+    T m_historyCount = T(0), m_historyDt = T(0);
+    T m_adaptiveStep = T(0);
 };
 
+extern template class StandaloneLaeroModelT<double>;
+extern template class StandaloneLaeroModelT<float>;
+
+typedef StandaloneLaeroModelT<double> StandaloneLaeroModel;
+typedef StandaloneLaeroModelT<float> StandaloneLaeroModelF;
+
 #endif // STANDALONE_LAERO_MODEL_HPP
\ No newline at end of file
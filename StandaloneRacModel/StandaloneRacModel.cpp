@@ -1,101 +1,145 @@
 // StandaloneRacModel.cpp
 #include "StandaloneRacModel.hpp"
+#include "Profiler.hpp"
 #include <iostream>
 
-StandaloneRacModel::StandaloneRacModel() {
+template<class T>
+StandaloneRacModelT<T>::StandaloneRacModelT() {
     // 构造函数初始化
 }
 
-void StandaloneRacModel::setInitialState(const AircraftState& initialState) {
+template<class T>
+void StandaloneRacModelT<T>::setInitialState(const AircraftStateT<T>& initialState) {
     m_state = initialState;
 }
 
-void StandaloneRacModel::update(const double dt) {
-    updateRac(dt);
+template<class T>
+void StandaloneRacModelT<T>::update(const double dt) {
+    // RacModel的指令在 update 中才生效, 控制律与积分一起计入 Integration
+    LAERO_PROFILE_SCOPE(PHASE_INTEGRATION);
+    if (m_integrator.type == INTEGRATOR_DEFAULT) {
+        updateRac(dt);
+    } else {
+        integrateOde(dt);
+    }
 }
 
-void StandaloneRacModel::setPerformanceLimits(double minSpeedKts, double maxG_val, double speedAtMaxG_Kts, double maxAccel_mps2) {
-    vpMinKts = minSpeedKts;
-    gMax = maxG_val;
-    vpMaxG_Kts = speedAtMaxG_Kts;
-    maxAccel = maxAccel_mps2;
+template<class T>
+void StandaloneRacModelT<T>::setIntegrator(const IntegratorConfig& config) {
+    // 换用其他方法时历史值失效
+    if (config.type != m_integrator.type) m_historyCount = T(0);
+    m_integrator = config;
 }
 
-void StandaloneRacModel::setCommandedHeadingD(double degs) {
-    cmdHeading = degs;
+template<class T>
+void StandaloneRacModelT<T>::setPerformanceLimits(double minSpeedKts, double maxG_val, double speedAtMaxG_Kts, double maxAccel_mps2) {
+    vpMinKts = T(minSpeedKts);
+    gMax = T(maxG_val);
+    vpMaxG_Kts = T(speedAtMaxG_Kts);
+    maxAccel = T(maxAccel_mps2);
 }
 
-void StandaloneRacModel::setCommandedAltitude(double meters) {
-    cmdAltitude = meters;
+template<class T>
+void StandaloneRacModelT<T>::getPerformanceLimits(double& minSpeedKts, double& maxG_val, double& speedAtMaxG_Kts, double& maxAccel_mps2) const {
+    minSpeedKts = vpMinKts;
+    maxG_val = gMax;
+    speedAtMaxG_Kts = vpMaxG_Kts;
+    maxAccel_mps2 = maxAccel;
 }
 
-void StandaloneRacModel::setCommandedVelocityKts(double kts) {
-    cmdVelocity = kts;
+template<class T>
+void StandaloneRacModelT<T>::setCommandedHeadingD(double degs) {
+    cmdHeading = T(degs);
 }
 
-void StandaloneRacModel::updateRac(const double dt) {
-    // --- 常量转换 ---
-    const double KTS2MPS = 1852.0 / 3600.0;
-    const double MPS2KTS = 3600.0 / 1852.0;
-    const double R2D = oe_base::angle::R2DCC;
-    const double D2R = oe_base::angle::D2RCC;
+template<class T>
+void StandaloneRacModelT<T>::setCommandedAltitude(double meters) {
+    cmdAltitude = T(meters);
+}
 
-    // 获取当前状态
-    double currentAltitudeM = -m_state.position.z();
-    double currentHeadingD = m_state.yaw * R2D;
-    double currentVelocityKts = m_state.bodyVelocity.length() * MPS2KTS;
-    double currentVelocityMps = m_state.bodyVelocity.length();
+template<class T>
+void StandaloneRacModelT<T>::setCommandedVelocityKts(double kts) {
+    cmdVelocity = T(kts);
+}
 
+template<class T>
+void StandaloneRacModelT<T>::holdUnsetCommands() {
     // 如果指令未设置，则保持当前状态
-    if (cmdAltitude < -9000.0) cmdAltitude = currentAltitudeM;
-    if (cmdHeading < -9000.0) cmdHeading = currentHeadingD;
-    if (cmdVelocity < -9000.0) cmdVelocity = currentVelocityKts;
+    if (cmdAltitude < T(-9000.0)) cmdAltitude = -m_state.position.z();
+    if (cmdHeading < T(-9000.0)) cmdHeading = m_state.yaw * T(oe_base::angle::R2DCC);
+    if (cmdVelocity < T(-9000.0)) cmdVelocity = m_state.bodyVelocity.length() * T(oe_base::units::MPS2KTS);
+}
+
+template<class T>
+void StandaloneRacModelT<T>::racLaws(T currentAltitudeM, T currentVelocityMps, T pitch, T yaw,
+                                     T& qa, T& ra, T& ra_max, T& vpdot) const {
+    // --- 常量转换 ---
+    const T KTS2MPS = T(oe_base::units::KTS2MPS);
+    const T MPS2KTS = T(oe_base::units::MPS2KTS);
+    const T D2R = T(oe_base::angle::D2RCC);
+
+    T currentVelocityKts = currentVelocityMps * MPS2KTS;
 
     // --- 计算高度差、期望垂直速度和期望俯仰角 ---
-    double maxAltRate = (3000.0 / 60.0) * (3.28084 / 3.28084); // 3000 ft/min in m/s
-    double cmdAltRate = cmdAltitude - currentAltitudeM;
+    T maxAltRate = T((3000.0 / 60.0) * (3.28084 / 3.28084)); // 3000 ft/min in m/s
+    T cmdAltRate = cmdAltitude - currentAltitudeM;
     cmdAltRate = std::max(-maxAltRate, std::min(maxAltRate, cmdAltRate));
     
-    double cmdPitchRad = 0.0;
-    if (currentVelocityMps > 1.0) {
+    T cmdPitchRad = T(0);
+    if (currentVelocityMps > T(1.0)) {
         cmdPitchRad = std::asin(cmdAltRate / currentVelocityMps);
     }
     
     // --- 计算最大G值 ---
-    double gmax_now = gMax;
+    T gmax_now = gMax;
     if (currentVelocityKts < vpMaxG_Kts && vpMaxG_Kts > vpMinKts) {
-        gmax_now = 1.0 + (gMax - 1.0) * (currentVelocityKts - vpMinKts) / (vpMaxG_Kts - vpMinKts);
+        gmax_now = T(1.0) + (gMax - T(1.0)) * (currentVelocityKts - vpMinKts) / (vpMaxG_Kts - vpMinKts);
     }
-    if (gmax_now < 1.0) gmax_now = 1.0;
+    if (gmax_now < T(1.0)) gmax_now = T(1.0);
 
     // --- 计算最大转弯率和俯仰率 ---
-    double ra_max = (gmax_now * oe_base::ETHGM) / currentVelocityMps;
-    double qa_max = ra_max;
-    double qa_min = -ra_max;
-    if (gmax_now > 2.0) {
-        qa_min = -(2.0f * oe_base::ETHGM / currentVelocityMps);
+    ra_max = (gmax_now * T(oe_base::ETHGM)) / currentVelocityMps;
+    T qa_max = ra_max;
+    T qa_min = -ra_max;
+    if (gmax_now > T(2.0)) {
+        qa_min = -(T(2.0f) * T(oe_base::ETHGM) / currentVelocityMps);
     }
 
     // --- 计算期望角速度 ---
-    double qa = oe_base::aepcdRad(cmdPitchRad - m_state.pitch) * 0.5; // 增加增益使其响应更快
+    qa = oe_base::aepcdRad(cmdPitchRad - pitch) * T(0.5); // 增加增益使其响应更快
     qa = std::max(qa_min, std::min(qa_max, qa));
 
-    double ra = oe_base::aepcdRad((cmdHeading * D2R) - m_state.yaw) * 0.5; // 增加增益
+    ra = oe_base::aepcdRad((cmdHeading * D2R) - yaw) * T(0.5); // 增加增益
     ra = std::max(-ra_max, std::min(ra_max, ra));
 
+    // --- 计算期望加速度 ---
+    T cmdVelMPS = cmdVelocity * KTS2MPS;
+    vpdot = (cmdVelMPS - currentVelocityMps) * T(0.1); // 增加增益
+    vpdot = std::max(-maxAccel, std::min(maxAccel, vpdot));
+}
+
+template<class T>
+void StandaloneRacModelT<T>::updateRac(const double dtIn) {
+    const T dt = T(dtIn);
+    const T KTS2MPS = T(oe_base::units::KTS2MPS);
+    const T D2R = T(oe_base::angle::D2RCC);
+
+    holdUnsetCommands();
+
+    // 获取当前状态并计算控制律
+    T currentVelocityMps = m_state.bodyVelocity.length();
+    T qa, ra, ra_max, vpdot;
+    racLaws(-m_state.position.z(), currentVelocityMps, m_state.pitch, m_state.yaw, qa, ra, ra_max, vpdot);
+
     // --- 积分计算新姿态 ---
-    double newTheta = m_state.pitch + (qa + qa1) * dt / 2.0;
-    double newPsi = oe_base::aepcdRad(m_state.yaw + (ra + ra1) * dt / 2.0);
+    T newTheta = m_state.pitch + (qa + qa1) * dt / T(2.0);
+    T newPsi = oe_base::aepcdRad(m_state.yaw + (ra + ra1) * dt / T(2.0));
     
     // 滚转角与转弯率成正比 (为了视觉效果)
-    double newPhi = 0.98 * m_state.roll + 0.02 * (ra / ra_max * (D2R * 60.0));
+    T newPhi = T(0.98) * m_state.roll + T(0.02) * (ra / ra_max * (D2R * T(60.0)));
 
-    // --- 计算期望加速度和新速度 ---
-    double cmdVelMPS = cmdVelocity * KTS2MPS;
-    double vpdot = (cmdVelMPS - currentVelocityMps) * 0.1; // 增加增益
-    vpdot = std::max(-maxAccel, std::min(maxAccel, vpdot));
-
-    double newVP_mps = currentVelocityMps + vpdot * dt;
+    // --- 新速度 ---
+    T newVP_mps = currentVelocityMps + vpdot * dt;
     if (newVP_mps < vpMinKts * KTS2MPS) newVP_mps = vpMinKts * KTS2MPS;
 
     // --- 更新状态 ---
@@ -103,24 +147,132 @@ void StandaloneRacModel::updateRac(const double dt) {
     m_state.pitch = newTheta;
     m_state.yaw = newPsi;
     
-    m_state.angularVelocity.set(0.0, qa, ra); // pa (滚转率)简化为0
+    m_state.angularVelocity.set(T(0), qa, ra); // pa (滚转率)简化为0
     qa1 = qa;
     ra1 = ra;
 
-    m_state.bodyVelocity.set(newVP_mps, 0.0, 0.0); // 简化: 无侧滑和垂直机体速度
+    m_state.bodyVelocity.set(newVP_mps, T(0), T(0)); // 简化: 无侧滑和垂直机体速度
     
     // 通过姿态和机体速度计算世界速度和位置
-    double l1 = std::cos(newTheta) * std::cos(newPsi);
-    double l2 = std::cos(newTheta) * std::sin(newPsi);
-    double l3 = -std::sin(newTheta);
+    T l1 = std::cos(newTheta) * std::cos(newPsi);
+    T l2 = std::cos(newTheta) * std::sin(newPsi);
+    T l3 = -std::sin(newTheta);
     // ... (m, n分量计算，为简化省略v,w的影响)
-    double velN = l1 * newVP_mps;
-    double velE = l2 * newVP_mps;
-    double velD = l3 * newVP_mps;
+    T velN = l1 * newVP_mps;
+    T velE = l2 * newVP_mps;
+    T velD = l3 * newVP_mps;
     m_state.velocity.set(velN, velE, velD);
     m_state.position.set(
         m_state.position.x() + velN * dt,
         m_state.position.y() + velE * dt,
         m_state.position.z() + velD * dt
     );
-}
\ No newline at end of file
+}
+
+// --- 常微分方程形式 (非默认积分方法) ---
+template<class T>
+void StandaloneRacModelT<T>::derivative(const StateVector& y, StateVector& dy) const {
+    // 滚转一阶滞后的速率: dt = 1/60 时每步 phi = 0.98*phi + 0.02*目标, 即 -60*ln(0.98)
+    const T ROLL_LAG = T(1.212162439051168);
+    const T D2R = T(oe_base::angle::D2RCC);
+
+    T qa, ra, ra_max, vpdot;
+    racLaws(-y[S_Z], y[S_VP], y[S_THT], y[S_PSI], qa, ra, ra_max, vpdot);
+    // 速度下限处不再减速
+    if (y[S_VP] <= vpMinKts * T(oe_base::units::KTS2MPS) && vpdot < T(0)) vpdot = T(0);
+
+    dy[S_PHI] = ROLL_LAG * (ra / ra_max * (D2R * T(60.0)) - y[S_PHI]);
+    dy[S_THT] = qa;
+    dy[S_PSI] = ra;
+    dy[S_VP] = vpdot;
+
+    const T cosTht = std::cos(y[S_THT]);
+    dy[S_X] = cosTht * std::cos(y[S_PSI]) * y[S_VP];
+    dy[S_Y] = cosTht * std::sin(y[S_PSI]) * y[S_VP];
+    dy[S_Z] = -std::sin(y[S_THT]) * y[S_VP];
+}
+
+template<class T>
+void StandaloneRacModelT<T>::integrateOde(const double dtIn) {
+    const T h = T(dtIn);
+    holdUnsetCommands();
+
+    StateVector y0;
+    y0[S_PHI] = m_state.roll;
+    y0[S_THT] = m_state.pitch;
+    y0[S_PSI] = m_state.yaw;
+    y0[S_VP] = m_state.bodyVelocity.length();
+    y0[S_X] = m_state.position.x();
+    y0[S_Y] = m_state.position.y();
+    y0[S_Z] = m_state.position.z();
+
+    StateVector f0;
+    derivative(y0, f0);
+    size_t evals = 1;
+
+    const StateVector f1 = { phiDot1, qa1, ra1, vpDot1, velN1, velE1, velD1 };
+    const StateVector f2 = { phiDot2, qa2, ra2, vpDot2, velN2, velE2, velD2 };
+    const T angTol = T(m_integrator.angleTol), velTol = T(m_integrator.velocityTol), posTol = T(m_integrator.positionTol);
+    const StateVector tol = { angTol, angTol, angTol, velTol, posTol, posTol, posTol };
+
+    auto f = [this](const StateVector& y, StateVector& dy) { derivative(y, dy); };
+    const StateVector y1 = integrator::advance(m_integrator, y0, f0, f1, f2, tol, h,
+                                               m_historyCount, m_historyDt, m_adaptiveStep, f, evals);
+    m_derivativeEvals += evals;
+    LAERO_PROFILE_COUNT(COUNTER_DERIVATIVE_EVALS, evals);
+
+    // 历史值后移 (qa1/ra1 同时是默认梯形积分的历史值)
+    phiDot2 = phiDot1; qa2 = qa1; ra2 = ra1; vpDot2 = vpDot1;
+    velN2 = velN1; velE2 = velE1; velD2 = velD1;
+    phiDot1 = f0[S_PHI]; qa1 = f0[S_THT]; ra1 = f0[S_PSI]; vpDot1 = f0[S_VP];
+    velN1 = f0[S_X]; velE1 = f0[S_Y]; velD1 = f0[S_Z];
+
+    const T minVel = vpMinKts * T(oe_base::units::KTS2MPS);
+    const T vp = std::max(y1[S_VP], minVel);
+    const T newTheta = y1[S_THT];
+    const T newPsi = oe_base::aepcdRad(y1[S_PSI]);
+
+    m_state.roll = y1[S_PHI];
+    m_state.pitch = newTheta;
+    m_state.yaw = newPsi;
+    m_state.angularVelocity.set(T(0), f0[S_THT], f0[S_PSI]);
+    m_state.bodyVelocity.set(vp, T(0), T(0));
+    m_state.velocity.set(std::cos(newTheta) * std::cos(newPsi) * vp,
+                         std::cos(newTheta) * std::sin(newPsi) * vp,
+                         -std::sin(newTheta) * vp);
+    m_state.position.set(y1[S_X], y1[S_Y], y1[S_Z]);
+}
+
+template<class T>
+typename StandaloneRacModelT<T>::Internals StandaloneRacModelT<T>::getInternals() const {
+    Internals in;
+    in.qa1 = qa1;
+    in.ra1 = ra1;
+    in.cmdAltitude = cmdAltitude;
+    in.cmdHeading = cmdHeading;
+    in.cmdVelocity = cmdVelocity;
+    in.phiDot1 = phiDot1; in.vpDot1 = vpDot1; in.velN1 = velN1; in.velE1 = velE1; in.velD1 = velD1;
+    in.phiDot2 = phiDot2; in.qa2 = qa2; in.ra2 = ra2; in.vpDot2 = vpDot2;
+    in.velN2 = velN2; in.velE2 = velE2; in.velD2 = velD2;
+    in.historyCount = m_historyCount; in.historyDt = m_historyDt;
+    in.adaptiveStep = m_adaptiveStep;
+    return in;
+}
+
+template<class T>
+void StandaloneRacModelT<T>::setInternals(const Internals& in) {
+    qa1 = in.qa1;
+    ra1 = in.ra1;
+    cmdAltitude = in.cmdAltitude;
+    cmdHeading = in.cmdHeading;
+    cmdVelocity = in.cmdVelocity;
+    phiDot1 = in.phiDot1; vpDot1 = in.vpDot1; velN1 = in.velN1; velE1 = in.velE1; velD1 = in.velD1;
+    phiDot2 = in.phiDot2; qa2 = in.qa2; ra2 = in.ra2; vpDot2 = in.vpDot2;
+    velN2 = in.velN2; velE2 = in.velE2; velD2 = in.velD2;
+    m_historyCount = in.historyCount; m_historyDt = in.historyDt;
+    m_adaptiveStep = in.adaptiveStep;
+}
+
+// --- 显式实例化 ---
+template class StandaloneRacModelT<double>;
+template class StandaloneRacModelT<float>;
@@ -2,11 +2,16 @@
 #ifndef STANDALONE_RAC_MODEL_HPP
 #define STANDALONE_RAC_MODEL_HPP
 
+#include <cstdint>
 #include "AircraftState.hpp"
+#include "FlightModel.hpp"
+#include "Integrator.hpp"
 
-class StandaloneRacModel {
+// T 为标量类型 (double 或 float); 成员函数在 StandaloneRacModel.cpp 中定义并显式实例化
+template<class T>
+class StandaloneRacModelT : public FlightModel<StandaloneRacModelT<T>, T> {
 public:
-    StandaloneRacModel();
+    StandaloneRacModelT();
 
     // --- 公共接口 ---
     void update(const double dt);
@@ -18,33 +23,82 @@ public:
 
     // 设置飞机性能限制 (替代原有的Slots配置)
     void setPerformanceLimits(double minSpeedKts, double maxG, double speedAtMaxG_Kts, double maxAccel_mps2);
+    void getPerformanceLimits(double& minSpeedKts, double& maxG, double& speedAtMaxG_Kts, double& maxAccel_mps2) const;
 
     // 获取当前状态
-    const AircraftState& getState() const { return m_state; }
-    void setInitialState(const AircraftState& initialState);
+    const AircraftStateT<T>& getState() const { return m_state; }
+    void setInitialState(const AircraftStateT<T>& initialState);
+
+    // 积分方法 (见 Integrator.hpp); 默认 INTEGRATOR_DEFAULT 与原来逐位相同。
+    // 其他方法中滚转角的每步 0.98/0.02 滤波换成等效的一阶滞后 (dt = 1/60 时相同), 速度下限在每步末施加。
+    void setIntegrator(const IntegratorConfig& config);
+    const IntegratorConfig& getIntegrator() const { return m_integrator; }
+    uint64_t derivativeEvaluations() const { return m_derivativeEvals; }
+
+    // --- 内部变量 (模型切换时交接状态) ---
+    struct Internals {
+        T qa1, ra1;    // 上一步的俯仰/偏航角速率 (梯形积分历史值)
+        T cmdAltitude, cmdHeading, cmdVelocity;    // 未设置时为 -9999
+
+        // ABM3 历史值: 上一步的其余导数, 以及再前一步的全部导数
+        T phiDot1, vpDot1, velN1, velE1, velD1;
+        T phiDot2, qa2, ra2, vpDot2, velN2, velE2, velD2;
+        T historyCount, historyDt;     // 有效历史步数 (0..2) 及其步长
+        T adaptiveStep;                // ADAPTIVE 上次的子步长
+    };
+    Internals getInternals() const;
+    // 只替换内部变量, 不改变 getState()
+    void setInternals(const Internals& in);
 
 private:
     // --- 私有辅助函数 (移植自RacModel) ---
     void updateRac(const double dt);
 
+    // 未设置的指令取当前状态 (保持)
+    void holdUnsetCommands();
+    // 控制律: 由高度、速度、俯仰、偏航求期望俯仰/偏航角速率、最大转弯率和前向加速度
+    void racLaws(T currentAltitudeM, T currentVelocityMps, T pitch, T yaw, T& qa, T& ra, T& ra_max, T& vpdot) const;
+
+    // --- 常微分方程形式 (非默认积分方法) ---
+    // 状态向量: 欧拉角、速度、位置
+    enum { S_PHI = 0, S_THT, S_PSI, S_VP, S_X, S_Y, S_Z, STATE_SIZE };
+    typedef integrator::StateVector<T, STATE_SIZE> StateVector;
+
+    void derivative(const StateVector& y, StateVector& dy) const;
+    void integrateOde(const double dt);
+
 private:
     // --- 模型状态 ---
-    AircraftState m_state;
+    AircraftStateT<T> m_state;
 
     // --- 性能限制参数 (原槽位变量) ---
-    double vpMinKts   = 80.0;    // 最小速度 (节)
-    double vpMaxG_Kts = 350.0;   // 达到最大G值的速度 (节)
-    double gMax       = 7.0;     // 最大G值
-    double maxAccel   = 20.0;    // 最大加速度 (米/秒^2)
+    T vpMinKts   = T(80.0);    // 最小速度 (节)
+    T vpMaxG_Kts = T(350.0);   // 达到最大G值的速度 (节)
+    T gMax       = T(7.0);     // 最大G值
+    T maxAccel   = T(20.0);    // 最大加速度 (米/秒^2)
 
     // --- 指令变量 ---
-    double cmdAltitude = -9999.0;
-    double cmdHeading  = -9999.0;
-    double cmdVelocity = -9999.0;
+    T cmdAltitude = T(-9999.0);
+    T cmdHeading  = T(-9999.0);
+    T cmdVelocity = T(-9999.0);
     
     // --- 内部状态变量 ---
-    double qa1 = 0.0;
-    double ra1 = 0.0;
+    T qa1 = T(0);
+    T ra1 = T(0);
+
+    // --- 积分方法及 ABM3 历史值 ---
+    IntegratorConfig m_integrator;
+    uint64_t m_derivativeEvals = 0;
+    T phiDot1 = T(0), vpDot1 = T(0), velN1 = T(0), velE1 = T(0), velD1 = T(0);
+    T phiDot2 = T(0), qa2 = T(0), ra2 = T(0), vpDot2 = T(0), velN2 = T(0), velE2 = T(0), velD2 = T(0);
+    T m_historyCount = T(0), m_historyDt = T(0);
+    T m_adaptiveStep = T(0);
 };
 
+extern template class StandaloneRacModelT<double>;
+extern template class StandaloneRacModelT<float>;
+
+typedef StandaloneRacModelT<double> StandaloneRacModel;
+typedef StandaloneRacModelT<float> StandaloneRacModelF;
+
 #endif // STANDALONE_RAC_MODEL_HPP
\ No newline at end of file
@@ -0,0 +1,219 @@
+// StateLogger.cpp
+#include "StateLogger.hpp"
+#include "Profiler.hpp"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+double StateLogRecord::* const COLUMNS[STATE_LOG_COLUMN_COUNT] = {
+    &StateLogRecord::time,
+    &StateLogRecord::posX, &StateLogRecord::posY, &StateLogRecord::alt,
+    &StateLogRecord::rollDeg, &StateLogRecord::pitchDeg, &StateLogRecord::yawDeg,
+    &StateLogRecord::velKts,
+    &StateLogRecord::targetPosX, &StateLogRecord::targetPosY, &StateLogRecord::targetAlt,
+    &StateLogRecord::targetHdg, &StateLogRecord::targetVelKts,
+    &StateLogRecord::errorDist, &StateLogRecord::errorAlt, &StateLogRecord::errorHdg, &StateLogRecord::errorVel
+};
+
+size_t roundUpPow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+double stateLogColumn(const StateLogRecord& r, size_t k) {
+    return r.*COLUMNS[k];
+}
+
+void setStateLogColumn(StateLogRecord& r, size_t k, double value) {
+    r.*COLUMNS[k] = value;
+}
+
+// ==============================================================
+// StateLogger
+// ==============================================================
+StateLogger::StateLogger(size_t ringCapacity, size_t blockCapacity, std::pmr::memory_resource* resource)
+    : m_ring(resource), m_blockIds(resource), m_blockColumns(resource) {
+    m_ring.resize(roundUpPow2(ringCapacity < 2 ? 2 : ringCapacity));
+    m_mask = m_ring.size() - 1;
+
+    m_blockCapacity = (blockCapacity > 0) ? blockCapacity : 1;
+    m_blockIds.resize(m_blockCapacity);
+    m_blockColumns.resize(m_blockCapacity * STATE_LOG_COLUMN_COUNT);
+}
+
+size_t StateLogger::bufferBytes(size_t ringCapacity, size_t blockCapacity) {
+    const size_t ring = roundUpPow2(ringCapacity < 2 ? 2 : ringCapacity);
+    const size_t block = (blockCapacity > 0) ? blockCapacity : 1;
+    return ring * sizeof(StateLogRecord) + alignof(StateLogRecord)
+         + block * sizeof(uint32_t) + alignof(uint32_t)
+         + block * STATE_LOG_COLUMN_COUNT * sizeof(double) + alignof(double);
+}
+
+StateLogger::~StateLogger() {
+    close();
+}
+
+bool StateLogger::open(const std::string& path, StateLogLayout layout) {
+    close();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (m_file == nullptr) return false;
+
+    StateLogFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, STATE_LOG_MAGIC, sizeof(header.magic));
+    header.version = STATE_LOG_VERSION;
+    header.layout = layout;
+    header.columnCount = STATE_LOG_COLUMN_COUNT;
+    header.blockCapacity = static_cast<uint32_t>(m_blockCapacity);
+    std::fwrite(&header, sizeof(header), 1, m_file);
+
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    m_logged.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+    m_blockCount = 0;
+    m_stop.store(false, std::memory_order_relaxed);
+    m_writer = std::thread(&StateLogger::writerLoop, this);
+    return true;
+}
+
+void StateLogger::close() {
+    if (m_file == nullptr) return;
+
+    m_stop.store(true, std::memory_order_release);
+    if (m_writer.joinable()) m_writer.join();
+
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+bool StateLogger::log(const StateLogRecord& record) {
+    LAERO_PROFILE_SCOPE(PHASE_LOGGING);
+    const uint64_t head = m_head.load(std::memory_order_relaxed);
+    const uint64_t tail = m_tail.load(std::memory_order_acquire);
+    if (head - tail >= m_ring.size()) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_ring[head & m_mask] = record;
+    m_head.store(head + 1, std::memory_order_release);
+    m_logged.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void StateLogger::writerLoop() {
+    for (;;) {
+        const bool stopping = m_stop.load(std::memory_order_acquire);
+        const size_t n = drain();
+        if (stopping && n == 0) break;
+        if (n == 0) {
+            // 缓冲区为空时短暂休眠, 仿真线程不需要唤醒写线程
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    flushBlock();
+    std::fflush(m_file);
+}
+
+size_t StateLogger::drain() {
+    uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    const size_t n = static_cast<size_t>(head - tail);
+
+    for (; tail != head; ++tail) {
+        const StateLogRecord& r = m_ring[tail & m_mask];
+        m_blockIds[m_blockCount] = r.aircraftId;
+        for (size_t k = 0; k < STATE_LOG_COLUMN_COUNT; ++k) {
+            m_blockColumns[k * m_blockCapacity + m_blockCount] = r.*COLUMNS[k];
+        }
+        // 每条记录拷贝完即归还槽位, 让生产者尽早复用
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        if (++m_blockCount == m_blockCapacity) flushBlock();
+    }
+    return n;
+}
+
+void StateLogger::flushBlock() {
+    if (m_blockCount == 0) return;
+
+    StateLogBlockHeader header;
+    header.magic = STATE_LOG_BLOCK_MAGIC;
+    header.recordCount = static_cast<uint32_t>(m_blockCount);
+    std::fwrite(&header, sizeof(header), 1, m_file);
+
+    std::fwrite(m_blockIds.data(), sizeof(uint32_t), m_blockCount, m_file);
+    if (m_blockCount % 2 != 0) {
+        const uint32_t pad = 0;
+        std::fwrite(&pad, sizeof(pad), 1, m_file);
+    }
+    for (size_t k = 0; k < STATE_LOG_COLUMN_COUNT; ++k) {
+        std::fwrite(&m_blockColumns[k * m_blockCapacity], sizeof(double), m_blockCount, m_file);
+    }
+    m_blockCount = 0;
+}
+
+// ==============================================================
+// StateLogReader
+// ==============================================================
+StateLogReader::StateLogReader() {
+}
+
+StateLogReader::~StateLogReader() {
+    close();
+}
+
+bool StateLogReader::open(const std::string& path) {
+    close();
+
+    m_file = std::fopen(path.c_str(), "rb");
+    if (m_file == nullptr) return false;
+
+    StateLogFileHeader header;
+    if (std::fread(&header, sizeof(header), 1, m_file) != 1 ||
+        std::memcmp(header.magic, STATE_LOG_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != STATE_LOG_VERSION ||
+        header.columnCount != STATE_LOG_COLUMN_COUNT) {
+        close();
+        return false;
+    }
+    m_layout = static_cast<StateLogLayout>(header.layout);
+    m_blockCapacity = header.blockCapacity;
+    return true;
+}
+
+void StateLogReader::close() {
+    if (m_file != nullptr) std::fclose(m_file);
+    m_file = nullptr;
+}
+
+bool StateLogReader::readBlock(std::vector<StateLogRecord>& records) {
+    records.clear();
+    if (m_file == nullptr) return false;
+
+    StateLogBlockHeader header;
+    if (std::fread(&header, sizeof(header), 1, m_file) != 1) return false;
+    if (header.magic != STATE_LOG_BLOCK_MAGIC || header.recordCount > m_blockCapacity) return false;
+
+    const size_t n = header.recordCount;
+    m_ids.resize(n + 1);
+    m_columns.resize(n * STATE_LOG_COLUMN_COUNT);
+
+    const size_t idWords = n + (n % 2);
+    if (std::fread(m_ids.data(), sizeof(uint32_t), idWords, m_file) != idWords) return false;
+    if (std::fread(m_columns.data(), sizeof(double), m_columns.size(), m_file) != m_columns.size()) return false;
+
+    records.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        records[i].aircraftId = m_ids[i];
+        for (size_t k = 0; k < STATE_LOG_COLUMN_COUNT; ++k) {
+            records[i].*COLUMNS[k] = m_columns[k * n + i];
+        }
+    }
+    return true;
+}
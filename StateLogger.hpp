@@ -0,0 +1,143 @@
+// StateLogger.hpp
+#ifndef STATE_LOGGER_HPP
+#define STATE_LOGGER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 高吞吐二进制状态日志
+//
+// 仿真线程把每步的状态/目标/误差写入无锁环形缓冲区 (只做一次内存拷贝, 从不等待磁盘),
+// 后台线程把缓冲区中的记录按列 (columnar) 打包成数据块写入文件。
+// 离线工具 Log2Csv 把二进制日志还原为原来 maneuver_log.csv / rac_model_log.csv 的列格式。
+//
+// 文件格式 (小端):
+//   StateLogFileHeader
+//   若干数据块: StateLogBlockHeader, uint32_t aircraftId[n], 补齐到8字节,
+//               然后 STATE_LOG_COLUMN_COUNT 列, 每列 double[n]
+
+// 一条日志记录, 对应CSV中的一行 (角度为度, 速度为节, 高度为正)
+struct StateLogRecord {
+    uint32_t aircraftId = 0;
+
+    double time = 0.0;
+    double posX = 0.0, posY = 0.0, alt = 0.0;
+    double rollDeg = 0.0, pitchDeg = 0.0, yawDeg = 0.0;
+    double velKts = 0.0;
+    double targetPosX = 0.0, targetPosY = 0.0, targetAlt = 0.0;
+    double targetHdg = 0.0, targetVelKts = 0.0;
+    double errorDist = 0.0, errorAlt = 0.0, errorHdg = 0.0, errorVel = 0.0;
+};
+
+const size_t STATE_LOG_COLUMN_COUNT = 17;
+
+// 日志的CSV列布局
+enum StateLogLayout {
+    LOG_LAYOUT_MANEUVER = 0,    // main.cpp 的 maneuver_log.csv
+    LOG_LAYOUT_RAC = 1          // main_rac.cpp 的 rac_model_log.csv
+};
+
+const char STATE_LOG_MAGIC[8] = { 'L', 'A', 'E', 'R', 'O', 'L', 'O', 'G' };
+const uint32_t STATE_LOG_VERSION = 1;
+const uint32_t STATE_LOG_BLOCK_MAGIC = 0x4B4C4253; // "SBLK"
+
+struct StateLogFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t layout;            // StateLogLayout
+    uint32_t columnCount;       // STATE_LOG_COLUMN_COUNT
+    uint32_t blockCapacity;     // 每块最多记录数
+};
+
+struct StateLogBlockHeader {
+    uint32_t magic;             // STATE_LOG_BLOCK_MAGIC
+    uint32_t recordCount;
+};
+
+// 第k列在 StateLogRecord 中的值
+double stateLogColumn(const StateLogRecord& r, size_t k);
+void setStateLogColumn(StateLogRecord& r, size_t k, double value);
+
+// --- 写日志 ---
+class StateLogger {
+public:
+    // ringCapacity 向上取整为2的幂; 环形缓冲区和数据块缓冲区在构造时从 resource 一次分配 (如 ScenarioArena)
+    explicit StateLogger(size_t ringCapacity = 65536, size_t blockCapacity = 4096,
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    ~StateLogger();
+
+    StateLogger(const StateLogger&) = delete;
+    StateLogger& operator=(const StateLogger&) = delete;
+
+    // 上面两个缓冲区所需字节 (用于估算场景内存)
+    static size_t bufferBytes(size_t ringCapacity = 65536, size_t blockCapacity = 4096);
+
+    bool open(const std::string& path, StateLogLayout layout = LOG_LAYOUT_MANEUVER);
+    // 写完缓冲区中剩余记录后关闭文件
+    void close();
+    bool isOpen() const { return m_file != nullptr; }
+
+    // 仿真线程调用 (单生产者); 缓冲区满时丢弃该记录并返回false, 从不阻塞
+    bool log(const StateLogRecord& record);
+
+    uint64_t loggedCount() const { return m_logged.load(std::memory_order_relaxed); }
+    uint64_t droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    void writerLoop();
+    size_t drain();
+    void flushBlock();
+
+private:
+    // --- 单生产者单消费者环形缓冲区 ---
+    std::pmr::vector<StateLogRecord> m_ring;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<uint64_t> m_head{0};   // 生产者写入位置
+    alignas(64) std::atomic<uint64_t> m_tail{0};   // 消费者读取位置
+    alignas(64) std::atomic<uint64_t> m_logged{0};
+    std::atomic<uint64_t> m_dropped{0};
+
+    // --- 后台写线程 ---
+    std::thread m_writer;
+    std::atomic<bool> m_stop{false};
+    std::FILE* m_file = nullptr;
+
+    // 列式数据块 (仅写线程访问)
+    size_t m_blockCapacity = 0;
+    size_t m_blockCount = 0;
+    std::pmr::vector<uint32_t> m_blockIds;
+    std::pmr::vector<double> m_blockColumns;    // 列优先: [列][记录]
+};
+
+// --- 读日志 ---
+class StateLogReader {
+public:
+    StateLogReader();
+    ~StateLogReader();
+
+    StateLogReader(const StateLogReader&) = delete;
+    StateLogReader& operator=(const StateLogReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    StateLogLayout layout() const { return m_layout; }
+
+    // 读取下一个数据块; 文件结束或出错时返回false
+    bool readBlock(std::vector<StateLogRecord>& records);
+
+private:
+    std::FILE* m_file = nullptr;
+    StateLogLayout m_layout = LOG_LAYOUT_MANEUVER;
+    uint32_t m_blockCapacity = 0;
+    std::vector<uint32_t> m_ids;
+    std::vector<double> m_columns;
+};
+
+#endif // STATE_LOGGER_HPP
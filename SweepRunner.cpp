@@ -0,0 +1,182 @@
+// SweepRunner.cpp
+#include "SweepRunner.hpp"
+#include <cstdio>
+#include <random>
+#include "FleetScheduler.hpp"
+#include "StandaloneLaeroModel.hpp"
+#include "TrackingDriver.hpp"
+#include "TrajectoryTrack.hpp"
+
+namespace {
+
+const std::vector<double>& valuesOr(const std::vector<double>& values, std::vector<double>& fallback, double def) {
+    if (!values.empty()) return values;
+    fallback.assign(1, def);
+    return fallback;
+}
+
+double uniform(std::mt19937_64& rng, const SweepRange& range) {
+    if (range.max <= range.min) return range.min;
+    return std::uniform_real_distribution<double>(range.min, range.max)(rng);
+}
+
+double normal(std::mt19937_64& rng, double sigma) {
+    if (sigma <= 0.0) return 0.0;
+    return std::normal_distribution<double>(0.0, sigma)(rng);
+}
+
+// 每个工况独立的随机数流, 与生成顺序和线程无关
+std::mt19937_64 caseRng(uint64_t seed, size_t index) {
+    std::seed_seq seq{ static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+                       static_cast<uint32_t>(index), static_cast<uint32_t>(static_cast<uint64_t>(index) >> 32) };
+    return std::mt19937_64(seq);
+}
+
+LaeroCommandLimits commandLimits(const SweepCase& c) {
+    LaeroCommandLimits limits;
+    limits.hDps = c.hDps;
+    limits.maxBankD = c.maxBankD;
+    limits.aMps = c.aMps;
+    limits.maxPitchD = c.maxPitchD;
+    limits.vNps = c.vNps;
+    return limits;
+}
+
+} // namespace
+
+// ==============================================================
+// 生成工况
+// ==============================================================
+std::vector<SweepCase> makeGridCases(const SweepGrid& grid) {
+    const SweepCase def;
+    std::vector<double> f[8];
+    const std::vector<double>& bank = valuesOr(grid.maxBankD, f[0], def.maxBankD);
+    const std::vector<double>& hdps = valuesOr(grid.hDps, f[1], def.hDps);
+    const std::vector<double>& pitch = valuesOr(grid.maxPitchD, f[2], def.maxPitchD);
+    const std::vector<double>& amps = valuesOr(grid.aMps, f[3], def.aMps);
+    const std::vector<double>& vnps = valuesOr(grid.vNps, f[4], def.vNps);
+    const std::vector<double>& hTau = valuesOr(grid.headingTau, f[5], def.control.headingTau);
+    const std::vector<double>& aTau = valuesOr(grid.altitudeTau, f[6], def.control.altitudeTau);
+    const std::vector<double>& vTau = valuesOr(grid.velocityTau, f[7], def.control.velocityTau);
+
+    std::vector<SweepCase> cases;
+    cases.reserve(bank.size() * hdps.size() * pitch.size() * amps.size() *
+                  vnps.size() * hTau.size() * aTau.size() * vTau.size());
+    for (double b : bank)
+    for (double h : hdps)
+    for (double p : pitch)
+    for (double a : amps)
+    for (double v : vnps)
+    for (double ht : hTau)
+    for (double at : aTau)
+    for (double vt : vTau) {
+        SweepCase c;
+        c.maxBankD = b;
+        c.hDps = h;
+        c.maxPitchD = p;
+        c.aMps = a;
+        c.vNps = v;
+        c.control.headingTau = ht;
+        c.control.altitudeTau = at;
+        c.control.velocityTau = vt;
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+std::vector<SweepCase> makeRandomCases(const SweepRandomSpec& spec) {
+    std::vector<SweepCase> cases(spec.count);
+    for (size_t k = 0; k < spec.count; ++k) {
+        std::mt19937_64 rng = caseRng(spec.seed, k);
+        SweepCase& c = cases[k];
+        c.maxBankD = uniform(rng, spec.maxBankD);
+        c.hDps = uniform(rng, spec.hDps);
+        c.maxPitchD = uniform(rng, spec.maxPitchD);
+        c.aMps = uniform(rng, spec.aMps);
+        c.vNps = uniform(rng, spec.vNps);
+        c.control.headingTau = uniform(rng, spec.headingTau);
+        c.control.altitudeTau = uniform(rng, spec.altitudeTau);
+        c.control.velocityTau = uniform(rng, spec.velocityTau);
+    }
+    return cases;
+}
+
+void applyPerturbation(std::vector<SweepCase>& cases, const SweepPerturbation& perturbation, uint64_t seed) {
+    for (size_t k = 0; k < cases.size(); ++k) {
+        // 与参数采样使用不同的随机数流
+        std::mt19937_64 rng = caseRng(~seed, k);
+        SweepCase& c = cases[k];
+        c.positionOffset.set(normal(rng, perturbation.horizontalSigmaM),
+                             normal(rng, perturbation.horizontalSigmaM),
+                             normal(rng, perturbation.altitudeSigmaM));
+        c.headingOffsetDeg = normal(rng, perturbation.headingSigmaDeg);
+        c.velocityOffsetKts = normal(rng, perturbation.velocitySigmaKts);
+    }
+}
+
+// ==============================================================
+// 运行
+// ==============================================================
+SweepResult runSweepCase(TrajectorySpan trajectory, const SweepCase& sweepCase, double dt) {
+    SweepResult result;
+    result.params = sweepCase;
+    if (trajectory.empty()) return result;
+
+    // --- 初始状态: 轨迹起点加扰动 ---
+    TrajectoryPoint startPoint = trajectory.front();
+    startPoint.position = startPoint.position + sweepCase.positionOffset;
+    startPoint.headingDeg = oe_base::aepcdDeg(startPoint.headingDeg + sweepCase.headingOffsetDeg);
+    startPoint.velocityKts += sweepCase.velocityOffsetKts;
+
+    StandaloneLaeroModel aircraft;
+    aircraft.setControlParams(sweepCase.control);
+    aircraft.setCommandLimits(commandLimits(sweepCase));
+    aircraft.setInitialState(trackingStartState(startPoint));
+
+    // --- 仿真循环 (与 main.cpp 共用 TrackingDriver), 误差与日志中的误差列定义相同 ---
+    const TrajectoryTrack track(trajectory);
+    result.steps = runTrackingScenario(aircraft, track, dt, [&](const StateLogRecord& r) {
+        result.stats.add(r.errorDist, r.errorAlt, r.errorHdg, r.errorVel);
+    });
+    return result;
+}
+
+std::vector<SweepResult> runSweep(TrajectorySpan trajectory, const std::vector<SweepCase>& cases,
+                                  FleetScheduler& scheduler, double dt) {
+    std::vector<SweepResult> results(cases.size());
+
+    // 每个工况一整段仿真: 按单个工况分块
+    scheduler.parallelFor(cases.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            results[k] = runSweepCase(trajectory, cases[k], dt);
+            results[k].caseIndex = k;
+        }
+    });
+    return results;
+}
+
+// ==============================================================
+// 输出
+// ==============================================================
+void writeSweepTable(std::ostream& out, const std::vector<SweepResult>& results) {
+    out << "Case,MaxBankD,HDps,MaxPitchD,AMps,VNps,HeadingTau,AltitudeTau,VelocityTau,"
+           "OffsetX,OffsetY,OffsetZ,OffsetHdg,OffsetVel,Steps,"
+           "ErrorDistRms,ErrorDistMax,ErrorAltRms,ErrorAltMaxAbs,"
+           "ErrorHdgRms,ErrorHdgMaxAbs,ErrorVelRms,ErrorVelMaxAbs\n";
+
+    char line[512];
+    for (const SweepResult& r : results) {
+        const SweepCase& c = r.params;
+        const TrackingStats& s = r.stats;
+        std::snprintf(line, sizeof(line),
+                      "%zu,%g,%g,%g,%g,%g,%g,%g,%g,%.3f,%.3f,%.3f,%.3f,%.3f,%zu,"
+                      "%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+                      r.caseIndex, c.maxBankD, c.hDps, c.maxPitchD, c.aMps, c.vNps,
+                      c.control.headingTau, c.control.altitudeTau, c.control.velocityTau,
+                      c.positionOffset.x(), c.positionOffset.y(), c.positionOffset.z(),
+                      c.headingOffsetDeg, c.velocityOffsetKts, r.steps,
+                      s.dist.rms(), s.dist.max(), s.alt.rms(), s.alt.maxAbs(),
+                      s.hdg.rms(), s.hdg.maxAbs(), s.vel.rms(), s.vel.maxAbs());
+        out << line;
+    }
+}
@@ -0,0 +1,103 @@
+// SweepRunner.hpp
+#ifndef SWEEP_RUNNER_HPP
+#define SWEEP_RUNNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "LaeroControlParams.hpp"
+#include "TrackingStats.hpp"
+#include "Trajectory.hpp"
+
+class FleetScheduler;
+
+// 轨迹跟踪参数扫描 / 蒙特卡洛
+//
+// 每个工况在进程内运行一次 main.cpp 的跟踪场景 (同一条期望轨迹, 同样的步长和误差定义),
+// 误差逐步归约为 TrackingStats, 不写逐步日志。工况之间互不依赖, 由 FleetScheduler 分配到所有核上;
+// 每个工况的随机扰动只由 (seed, 工况序号) 决定, 结果与线程数无关。
+
+// 一个工况: 指令参数 + 控制律时间常数 + 初始状态扰动
+struct SweepCase {
+    double maxBankD = 30.0;     // setCommandedHeadingD 最大坡度
+    double hDps = 20.0;         // setCommandedHeadingD 转弯速率
+    double maxPitchD = 15.0;    // setCommandedAltitude 最大俯仰角
+    double aMps = 150.0;        // setCommandedAltitude 爬升率
+    double vNps = 5.0;          // setCommandedVelocityKts 加速度 (节/秒)
+    LaeroControlParams control;
+
+    // 初始状态相对轨迹起点的偏差
+    oe_base::Vec3d positionOffset;  // 米 (NED)
+    double headingOffsetDeg = 0.0;
+    double velocityOffsetKts = 0.0;
+};
+
+// 网格扫描: 各参数取值的笛卡尔积; 空列表表示取 SweepCase 的默认值
+struct SweepGrid {
+    std::vector<double> maxBankD;
+    std::vector<double> hDps;
+    std::vector<double> maxPitchD;
+    std::vector<double> aMps;
+    std::vector<double> vNps;
+    std::vector<double> headingTau;
+    std::vector<double> altitudeTau;
+    std::vector<double> velocityTau;
+};
+
+// 随机采样的取值区间 [min, max]; min == max 时为定值
+struct SweepRange {
+    double min = 0.0;
+    double max = 0.0;
+    SweepRange() {}
+    SweepRange(double lo, double hi) : min(lo), max(hi) {}
+};
+
+// 随机采样: 各参数在区间内均匀分布
+struct SweepRandomSpec {
+    size_t count = 100;
+    uint64_t seed = 1;
+    SweepRange maxBankD{30.0, 30.0};
+    SweepRange hDps{20.0, 20.0};
+    SweepRange maxPitchD{15.0, 15.0};
+    SweepRange aMps{150.0, 150.0};
+    SweepRange vNps{5.0, 5.0};
+    SweepRange headingTau{1.0, 1.0};
+    SweepRange altitudeTau{4.0, 4.0};
+    SweepRange velocityTau{1.0, 1.0};
+};
+
+// 初始状态扰动 (正态分布的标准差)
+struct SweepPerturbation {
+    double horizontalSigmaM = 0.0;
+    double altitudeSigmaM = 0.0;
+    double headingSigmaDeg = 0.0;
+    double velocitySigmaKts = 0.0;
+};
+
+// 一个工况的结果
+struct SweepResult {
+    size_t caseIndex = 0;
+    SweepCase params;
+    TrackingStats stats;
+    size_t steps = 0;
+};
+
+// --- 生成工况 ---
+std::vector<SweepCase> makeGridCases(const SweepGrid& grid);
+std::vector<SweepCase> makeRandomCases(const SweepRandomSpec& spec);
+// 给每个工况叠加随机初始扰动
+void applyPerturbation(std::vector<SweepCase>& cases, const SweepPerturbation& perturbation, uint64_t seed);
+
+// --- 运行 ---
+// 单个工况 (即 main.cpp 的仿真循环)
+SweepResult runSweepCase(TrajectorySpan trajectory, const SweepCase& sweepCase, double dt = 1.0 / 60.0);
+// 全部工况并行运行, 结果按工况顺序返回
+std::vector<SweepResult> runSweep(TrajectorySpan trajectory, const std::vector<SweepCase>& cases,
+                                  FleetScheduler& scheduler, double dt = 1.0 / 60.0);
+
+// --- 输出 ---
+// 每个工况一行的CSV结果表
+void writeSweepTable(std::ostream& out, const std::vector<SweepResult>& results);
+
+#endif // SWEEP_RUNNER_HPP
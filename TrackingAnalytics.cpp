@@ -0,0 +1,429 @@
+// TrackingAnalytics.cpp
+#include "TrackingAnalytics.hpp"
+#include "OeBase.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace {
+
+const char* const PHASE_NAMES[MANEUVER_PHASE_COUNT] = {
+    "cruise", "climb", "descent", "turn_left", "turn_right", "speed_change"
+};
+
+const char* const RESPONSE_NAMES[RESPONSE_CHANNEL_COUNT] = { "alt", "hdg", "vel" };
+
+const double PERCENTILES[] = { 0.50, 0.90, 0.95, 0.99 };
+const char* const PERCENTILE_NAMES[] = { "p50", "p90", "p95", "p99" };
+const size_t PERCENTILE_COUNT = sizeof(PERCENTILES) / sizeof(PERCENTILES[0]);
+
+// JSON/CSV 数值; 非有限值在 JSON 中写 null, 在 CSV 中留空
+std::string num(double v, bool json = true) {
+    if (!std::isfinite(v)) return json ? "null" : "";
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.6g", v);
+    return buf;
+}
+
+void writeChannelJson(std::ostream& out, const char* name, const ErrorChannel& c, bool last) {
+    const RunningStats& s = c.stats;
+    out << "    \"" << name << "\": {\"mean\": " << num(s.mean()) << ", \"rms\": " << num(s.rms())
+        << ", \"min\": " << num(s.min()) << ", \"max\": " << num(s.max()) << ", \"maxAbs\": " << num(s.maxAbs());
+    for (size_t k = 0; k < PERCENTILE_COUNT; ++k) {
+        out << ", \"" << PERCENTILE_NAMES[k] << "\": " << num(c.percentile(PERCENTILES[k]));
+    }
+    out << "}" << (last ? "" : ",") << "\n";
+}
+
+void writeStatsJson(std::ostream& out, const TrackingStats& s) {
+    const RunningStats* channels[4] = { &s.dist, &s.alt, &s.hdg, &s.vel };
+    const char* names[4] = { "dist", "alt", "hdg", "vel" };
+    for (int k = 0; k < 4; ++k) {
+        out << ", \"" << names[k] << "Rms\": " << num(channels[k]->rms())
+            << ", \"" << names[k] << "MaxAbs\": " << num(channels[k]->maxAbs());
+    }
+}
+
+} // namespace
+
+const char* maneuverPhaseName(ManeuverPhase phase) {
+    return (phase >= 0 && phase < MANEUVER_PHASE_COUNT) ? PHASE_NAMES[phase] : "unknown";
+}
+
+const char* responseChannelName(ResponseChannel channel) {
+    return (channel >= 0 && channel < RESPONSE_CHANNEL_COUNT) ? RESPONSE_NAMES[channel] : "unknown";
+}
+
+// ==============================================================
+// ErrorHistogram
+// ==============================================================
+void ErrorHistogram::add(double absValue) {
+    // 桶号直接取自 double 的指数和尾数高位, 不调用 log
+    uint64_t bits;
+    std::memcpy(&bits, &absValue, sizeof(bits));
+    const int exponent = static_cast<int>((bits >> 52) & 0x7FF) - 1023;
+
+    int bucket;
+    if (exponent < MIN_EXPONENT) {
+        bucket = 0;
+    } else if (exponent >= MAX_EXPONENT) {
+        bucket = BUCKET_COUNT - 1;      // 含 inf/NaN
+    } else {
+        const int sub = static_cast<int>((bits >> (52 - SUB_BUCKET_BITS)) & ((1u << SUB_BUCKET_BITS) - 1));
+        bucket = 1 + ((exponent - MIN_EXPONENT) << SUB_BUCKET_BITS) + sub;
+    }
+    ++m_buckets[bucket];
+    ++m_count;
+}
+
+void ErrorHistogram::merge(const ErrorHistogram& o) {
+    for (int b = 0; b < BUCKET_COUNT; ++b) m_buckets[b] += o.m_buckets[b];
+    m_count += o.m_count;
+}
+
+double ErrorHistogram::quantile(double q, double maxValue) const {
+    if (m_count == 0) return 0.0;
+    if (q < 0.0) q = 0.0;
+    if (q > 1.0) q = 1.0;
+
+    // 第 rank 个样本 (从1开始) 所在的桶
+    const double rank = std::max(1.0, std::ceil(q * static_cast<double>(m_count)));
+    uint64_t before = 0;
+    for (int b = 0; b < BUCKET_COUNT; ++b) {
+        const uint64_t n = m_buckets[b];
+        if (n == 0 || static_cast<double>(before + n) < rank) {
+            before += n;
+            continue;
+        }
+        if (b == BUCKET_COUNT - 1) return maxValue;
+
+        double lo, hi;
+        if (b == 0) {
+            lo = 0.0;
+            hi = std::ldexp(1.0, MIN_EXPONENT);
+        } else {
+            const int exponent = MIN_EXPONENT + ((b - 1) >> SUB_BUCKET_BITS);
+            const int sub = (b - 1) & ((1 << SUB_BUCKET_BITS) - 1);
+            const double width = std::ldexp(1.0, exponent - SUB_BUCKET_BITS);
+            lo = std::ldexp(1.0, exponent) + sub * width;
+            hi = lo + width;
+        }
+        // 桶内按均匀分布插值
+        const double frac = (rank - static_cast<double>(before) - 0.5) / static_cast<double>(n);
+        const double v = lo + frac * (hi - lo);
+        return std::min(v, maxValue);
+    }
+    return maxValue;
+}
+
+// ==============================================================
+// TrackingAnalytics
+// ==============================================================
+TrackingAnalytics::TrackingAnalytics(const AnalyticsConfig& config)
+    : m_config(config) {
+}
+
+void TrackingAnalytics::reserve() {
+    m_segments.reserve(m_config.maxSegments);
+    m_responseList.reserve(m_config.maxResponses);
+}
+
+ManeuverPhase TrackingAnalytics::classify(double altRate, double hdgRate, double velRate) const {
+    if (std::fabs(hdgRate) > m_config.turnRateDps) return (hdgRate > 0.0) ? MANEUVER_TURN_RIGHT : MANEUVER_TURN_LEFT;
+    if (altRate > m_config.climbRateMps) return MANEUVER_CLIMB;
+    if (altRate < -m_config.climbRateMps) return MANEUVER_DESCENT;
+    if (std::fabs(velRate) > m_config.accelKtsPerSec) return MANEUVER_SPEED_CHANGE;
+    return MANEUVER_CRUISE;
+}
+
+void TrackingAnalytics::add(const StateLogRecord& r) {
+    if (m_samples == 0) m_aircraftCount = 1;
+    ++m_samples;
+    m_dist.add(r.errorDist);
+    m_alt.add(r.errorAlt);
+    m_hdg.add(r.errorHdg);
+    m_vel.add(r.errorVel);
+
+    // 第一步没有变化率, 先保存, 计入第二步所在的阶段
+    if (!m_hasPrevious) {
+        m_hasPrevious = true;
+        m_firstPending = true;
+        m_firstRecord = r;
+    } else {
+        // 目标值变化率
+        double dt = r.time - m_prevTime;
+        const double dAlt = r.targetAlt - m_prevAlt;
+        const double dHdg = oe_base::aepcdDeg(r.targetHdg - m_prevHdg);
+        const double dVel = r.targetVelKts - m_prevVel;
+        double altRate = 0.0, hdgRate = 0.0, velRate = 0.0;
+        if (dt > 0.0) {
+            altRate = dAlt / dt;
+            hdgRate = dHdg / dt;
+            velRate = dVel / dt;
+        } else {
+            dt = 0.0;
+        }
+        m_duration += dt;
+
+        // --- 阶段 ---
+        const ManeuverPhase phase = classify(altRate, hdgRate, velRate);
+        if (!m_segmentOpen || phase != m_segment.phase) {
+            closeSegment();
+            m_segment = PhaseSegment();
+            m_segment.phase = phase;
+            m_segment.startTime = m_prevTime;
+            m_segmentOpen = true;
+        }
+        m_segment.endTime = r.time;
+        if (m_firstPending) addToPhase(phase, m_firstRecord, 0.0);
+        addToPhase(phase, r, dt);
+
+        // --- 指令响应 ---
+        trackResponse(RESPONSE_ALT, r.time, m_prevTime, r.targetAlt, m_prevAlt, dAlt, altRate,
+                      m_config.climbRateMps, r.alt);
+        trackResponse(RESPONSE_HDG, r.time, m_prevTime, r.targetHdg, m_prevHdg, dHdg, hdgRate,
+                      m_config.turnRateDps, r.yawDeg);
+        trackResponse(RESPONSE_VEL, r.time, m_prevTime, r.targetVelKts, m_prevVel, dVel, velRate,
+                      m_config.accelKtsPerSec, r.velKts);
+    }
+
+    m_prevTime = r.time;
+    m_prevAlt = r.targetAlt;
+    m_prevHdg = r.targetHdg;
+    m_prevVel = r.targetVelKts;
+}
+
+void TrackingAnalytics::addToPhase(ManeuverPhase phase, const StateLogRecord& r, double dt) {
+    m_segment.stats.add(r.errorDist, r.errorAlt, r.errorHdg, r.errorVel);
+    PhaseSummary& summary = m_phases[phase];
+    summary.duration += dt;
+    summary.stats.add(r.errorDist, r.errorAlt, r.errorHdg, r.errorVel);
+    m_firstPending = false;
+}
+
+void TrackingAnalytics::trackResponse(ResponseChannel c, double time, double prevTime, double command,
+                                      double prevCommand, double commandDelta, double rate, double threshold,
+                                      double actual) {
+    ResponseTracker& tr = m_trackers[c];
+    const double absBand = (c == RESPONSE_ALT) ? m_config.altitudeBandM
+                         : (c == RESPONSE_HDG) ? m_config.headingBandDeg : m_config.velocityBandKts;
+
+    if (std::fabs(rate) > threshold) {
+        // 指令开始变化, 或变化方向反转 (如S型转弯): 结束上一次, 开始新的一次
+        // 反转时上一次没有停下来观察过, 只记为中断, 不计入超调和调节统计
+        const bool reversed = tr.changing && ((rate > 0.0) != (tr.current.step > 0.0));
+        if (reversed) {
+            tr.changing = false;
+            tr.pending = std::fabs(tr.current.step) >= absBand;
+            tr.current.to = prevCommand;
+            tr.current.endTime = prevTime;
+            tr.current.interrupted = true;
+            tr.settleStart = -1.0;
+        }
+        if (!tr.changing) {
+            finishResponse(c);
+            tr.changing = true;
+            tr.current = StepResponse();
+            tr.current.channel = c;
+            tr.current.startTime = prevTime;
+            tr.current.from = prevCommand;
+        }
+        tr.current.step += commandDelta;
+    } else if (tr.changing) {
+        // 指令停止变化: 开始观察超调和调节过程
+        tr.changing = false;
+        tr.current.step += commandDelta;
+        tr.current.to = command;
+        tr.current.endTime = time;
+        tr.band = std::max(absBand, m_config.bandFraction * std::fabs(tr.current.step));
+        tr.settleStart = -1.0;
+        tr.pending = std::fabs(tr.current.step) >= absBand;
+    }
+
+    if (tr.pending) {
+        const double e = (c == RESPONSE_HDG) ? oe_base::aepcdDeg(actual - tr.current.to) : actual - tr.current.to;
+        const double along = (tr.current.step > 0.0) ? e : -e;
+        if (along > tr.current.overshoot) tr.current.overshoot = along;
+        if (std::fabs(e) > tr.band) tr.settleStart = -1.0;
+        else if (tr.settleStart < 0.0) tr.settleStart = time;
+    }
+}
+
+void TrackingAnalytics::finishResponse(ResponseChannel c) {
+    ResponseTracker& tr = m_trackers[c];
+    if (!tr.pending) return;
+    tr.pending = false;
+
+    StepResponse& s = tr.current;
+    ResponseSummary& summary = m_responses[c];
+    if (s.interrupted) {
+        ++summary.interrupted;
+        if (m_responseList.size() < m_config.maxResponses) m_responseList.push_back(s);
+        return;
+    }
+    s.overshootPct = s.overshoot / std::fabs(s.step) * 100.0;
+    s.settlingTime = (tr.settleStart >= 0.0) ? tr.settleStart - s.endTime : -1.0;
+
+    ++summary.count;
+    summary.overshoot.add(s.overshoot);
+    summary.overshootPct.add(s.overshootPct);
+    if (s.settlingTime >= 0.0) {
+        ++summary.settled;
+        summary.settlingTime.add(s.settlingTime);
+    }
+    if (m_responseList.size() < m_config.maxResponses) m_responseList.push_back(s);
+}
+
+void TrackingAnalytics::closeSegment() {
+    if (!m_segmentOpen) return;
+    m_segmentOpen = false;
+    ++m_phases[m_segment.phase].segments;
+    if (m_segments.size() < m_config.maxSegments) m_segments.push_back(m_segment);
+}
+
+void TrackingAnalytics::finish() {
+    // 只有一步时计入平飞
+    if (m_firstPending) {
+        m_segment = PhaseSegment();
+        m_segment.startTime = m_segment.endTime = m_firstRecord.time;
+        m_segmentOpen = true;
+        addToPhase(MANEUVER_CRUISE, m_firstRecord, 0.0);
+    }
+    // 结束时仍在变化的指令没有终值, 不计入
+    for (int c = 0; c < RESPONSE_CHANNEL_COUNT; ++c) {
+        m_trackers[c].changing = false;
+        finishResponse(static_cast<ResponseChannel>(c));
+    }
+    closeSegment();
+}
+
+void TrackingAnalytics::merge(const TrackingAnalytics& o) {
+    m_samples += o.m_samples;
+    m_duration += o.m_duration;
+    m_aircraftCount += o.m_aircraftCount;
+    m_dist.merge(o.m_dist);
+    m_alt.merge(o.m_alt);
+    m_hdg.merge(o.m_hdg);
+    m_vel.merge(o.m_vel);
+    for (int p = 0; p < MANEUVER_PHASE_COUNT; ++p) {
+        m_phases[p].duration += o.m_phases[p].duration;
+        m_phases[p].segments += o.m_phases[p].segments;
+        m_phases[p].stats.merge(o.m_phases[p].stats);
+    }
+    for (int c = 0; c < RESPONSE_CHANNEL_COUNT; ++c) {
+        ResponseSummary& a = m_responses[c];
+        const ResponseSummary& b = o.m_responses[c];
+        a.count += b.count;
+        a.settled += b.settled;
+        a.interrupted += b.interrupted;
+        a.overshoot.merge(b.overshoot);
+        a.overshootPct.merge(b.overshootPct);
+        a.settlingTime.merge(b.settlingTime);
+    }
+}
+
+// ==============================================================
+// 输出
+// ==============================================================
+void TrackingAnalytics::writeJson(std::ostream& out) const {
+    out << "{\n";
+    out << "  \"aircraft\": " << m_aircraftCount << ",\n";
+    out << "  \"samples\": " << m_samples << ",\n";
+    out << "  \"duration\": " << num(m_duration) << ",\n";
+
+    out << "  \"errors\": {\n";
+    writeChannelJson(out, "dist", m_dist, false);
+    writeChannelJson(out, "alt", m_alt, false);
+    writeChannelJson(out, "hdg", m_hdg, false);
+    writeChannelJson(out, "vel", m_vel, true);
+    out << "  },\n";
+
+    out << "  \"phases\": {\n";
+    bool first = true;
+    for (int p = 0; p < MANEUVER_PHASE_COUNT; ++p) {
+        const PhaseSummary& s = m_phases[p];
+        if (s.stats.dist.count() == 0) continue;
+        out << (first ? "" : ",\n") << "    \"" << PHASE_NAMES[p] << "\": {\"duration\": " << num(s.duration)
+            << ", \"segments\": " << s.segments << ", \"samples\": " << s.stats.dist.count();
+        writeStatsJson(out, s.stats);
+        out << "}";
+        first = false;
+    }
+    out << (first ? "" : "\n") << "  },\n";
+
+    out << "  \"responses\": {\n";
+    for (int c = 0; c < RESPONSE_CHANNEL_COUNT; ++c) {
+        const ResponseSummary& s = m_responses[c];
+        out << "    \"" << RESPONSE_NAMES[c] << "\": {\"count\": " << s.count << ", \"settled\": " << s.settled
+            << ", \"interrupted\": " << s.interrupted
+            << ", \"overshootMax\": " << num(s.overshoot.count() ? s.overshoot.max() : 0.0)
+            << ", \"overshootPctMean\": " << num(s.overshootPct.mean())
+            << ", \"overshootPctMax\": " << num(s.overshootPct.count() ? s.overshootPct.max() : 0.0)
+            << ", \"settlingMean\": " << (s.settlingTime.count() ? num(s.settlingTime.mean()) : "null")
+            << ", \"settlingMax\": " << (s.settlingTime.count() ? num(s.settlingTime.max()) : "null") << "}"
+            << (c + 1 < RESPONSE_CHANNEL_COUNT ? "," : "") << "\n";
+    }
+    out << "  },\n";
+
+    out << "  \"segments\": [";
+    for (size_t k = 0; k < m_segments.size(); ++k) {
+        const PhaseSegment& s = m_segments[k];
+        out << (k ? ",\n" : "\n") << "    {\"phase\": \"" << PHASE_NAMES[s.phase] << "\", \"start\": "
+            << num(s.startTime) << ", \"end\": " << num(s.endTime);
+        writeStatsJson(out, s.stats);
+        out << "}";
+    }
+    out << (m_segments.empty() ? "" : "\n  ") << "],\n";
+
+    out << "  \"stepResponses\": [";
+    for (size_t k = 0; k < m_responseList.size(); ++k) {
+        const StepResponse& s = m_responseList[k];
+        out << (k ? ",\n" : "\n") << "    {\"channel\": \"" << RESPONSE_NAMES[s.channel]
+            << "\", \"start\": " << num(s.startTime) << ", \"end\": " << num(s.endTime)
+            << ", \"from\": " << num(s.from) << ", \"to\": " << num(s.to) << ", \"step\": " << num(s.step)
+            << ", \"overshoot\": " << num(s.overshoot) << ", \"overshootPct\": " << num(s.overshootPct)
+            << ", \"settlingTime\": " << (s.settlingTime >= 0.0 ? num(s.settlingTime) : "null")
+            << ", \"interrupted\": " << (s.interrupted ? "true" : "false") << "}";
+    }
+    out << (m_responseList.empty() ? "" : "\n  ") << "]\n";
+    out << "}\n";
+}
+
+void TrackingAnalytics::writeCsv(std::ostream& out) const {
+    out << "Scope,Channel,Samples,Duration,Mean,Rms,Max,MaxAbs,P50,P90,P95,P99,"
+           "Responses,Settled,Interrupted,OvershootMax,OvershootPctMax,SettlingMean,SettlingMax\n";
+
+    const char* names[4] = { "dist", "alt", "hdg", "vel" };
+    const ErrorChannel* channels[4] = { &m_dist, &m_alt, &m_hdg, &m_vel };
+    for (int k = 0; k < 4; ++k) {
+        const RunningStats& s = channels[k]->stats;
+        out << "all," << names[k] << "," << s.count() << "," << num(m_duration, false) << ","
+            << num(s.mean(), false) << "," << num(s.rms(), false) << "," << num(s.max(), false) << ","
+            << num(s.maxAbs(), false);
+        for (size_t q = 0; q < PERCENTILE_COUNT; ++q) out << "," << num(channels[k]->percentile(PERCENTILES[q]), false);
+        if (k == 0) {
+            out << ",,,,,,,\n";
+            continue;
+        }
+        const ResponseSummary& r = m_responses[k - 1];
+        out << "," << r.count << "," << r.settled << "," << r.interrupted
+            << "," << num(r.overshoot.count() ? r.overshoot.max() : 0.0, false)
+            << "," << num(r.overshootPct.count() ? r.overshootPct.max() : 0.0, false)
+            << "," << (r.settlingTime.count() ? num(r.settlingTime.mean(), false) : "")
+            << "," << (r.settlingTime.count() ? num(r.settlingTime.max(), false) : "") << "\n";
+    }
+
+    for (int p = 0; p < MANEUVER_PHASE_COUNT; ++p) {
+        const PhaseSummary& ph = m_phases[p];
+        if (ph.stats.dist.count() == 0) continue;
+        const RunningStats* stats[4] = { &ph.stats.dist, &ph.stats.alt, &ph.stats.hdg, &ph.stats.vel };
+        for (int k = 0; k < 4; ++k) {
+            const RunningStats& s = *stats[k];
+            out << PHASE_NAMES[p] << "," << names[k] << "," << s.count() << "," << num(ph.duration, false) << ","
+                << num(s.mean(), false) << "," << num(s.rms(), false) << "," << num(s.max(), false) << ","
+                << num(s.maxAbs(), false) << ",,,,,,,,,,,\n";
+        }
+    }
+}
@@ -0,0 +1,219 @@
+// TrackingAnalytics.hpp
+#ifndef TRACKING_ANALYTICS_HPP
+#define TRACKING_ANALYTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "StateLogger.hpp"
+#include "TrackingStats.hpp"
+
+// 仿真过程中的流式跟踪误差分析 (代替运行后用 pandas 读取整个CSV)
+//
+// 每步把 StateLogRecord 交给 TrackingAnalytics::add, 不保存样本, 内存与仿真时长无关:
+//   * ErrorDist / ErrorAlt / ErrorHdg / ErrorVel 的均值、RMS、最大值 (RunningStats)
+//     以及 |误差| 的分位数 (对数分桶直方图, 相对误差约3%);
+//   * 按机动阶段 (平飞、爬升、下降、左/右转、加减速) 分类的误差统计, 以及逐段列表;
+//   * 高度/航向/速度指令每次变化结束后的超调量和调节时间。
+// 阶段和指令变化都由目标值 (TargetAlt/TargetHdg/TargetVelKts) 的变化率判断, 不需要轨迹定义。
+// 一个 TrackingAnalytics 对应一架飞机的时间序列; 多架飞机各用一个, 再 merge 得到机队汇总。
+
+// 机动阶段 (按优先级: 转弯 > 爬升/下降 > 加减速 > 平飞)
+enum ManeuverPhase {
+    MANEUVER_CRUISE = 0,
+    MANEUVER_CLIMB,
+    MANEUVER_DESCENT,
+    MANEUVER_TURN_LEFT,
+    MANEUVER_TURN_RIGHT,
+    MANEUVER_SPEED_CHANGE,
+    MANEUVER_PHASE_COUNT
+};
+
+const char* maneuverPhaseName(ManeuverPhase phase);
+
+// 指令响应的通道
+enum ResponseChannel {
+    RESPONSE_ALT = 0,
+    RESPONSE_HDG,
+    RESPONSE_VEL,
+    RESPONSE_CHANNEL_COUNT
+};
+
+const char* responseChannelName(ResponseChannel channel);
+
+// |误差| 直方图: 按 double 的二进制指数分组, 每组 16 个桶 (桶宽为下界的 1/16)
+// 范围 2^-10 ~ 2^20 (约 0.001 ~ 100万), 之外的值计入两端的桶。可以合并, 合并结果与逐个加入相同。
+class ErrorHistogram {
+public:
+    static const int MIN_EXPONENT = -10;
+    static const int MAX_EXPONENT = 20;
+    static const int SUB_BUCKET_BITS = 4;
+    static const int BUCKET_COUNT = ((MAX_EXPONENT - MIN_EXPONENT) << SUB_BUCKET_BITS) + 2;
+
+    void add(double absValue);
+    void merge(const ErrorHistogram& o);
+
+    uint64_t count() const { return m_count; }
+    // 第 q (0~1) 分位数; 桶内线性插值, 结果不超过 maxValue (实际最大值)
+    double quantile(double q, double maxValue) const;
+
+private:
+    uint64_t m_buckets[BUCKET_COUNT] = {};
+    uint64_t m_count = 0;
+};
+
+// 一个误差通道: 带符号误差的统计 + |误差| 的分布
+struct ErrorChannel {
+    RunningStats stats;
+    ErrorHistogram absHistogram;
+
+    void add(double x) {
+        stats.add(x);
+        absHistogram.add(std::fabs(x));
+    }
+
+    void merge(const ErrorChannel& o) {
+        stats.merge(o.stats);
+        absHistogram.merge(o.absHistogram);
+    }
+
+    double percentile(double q) const { return absHistogram.quantile(q, stats.maxAbs()); }
+};
+
+// 分析参数
+struct AnalyticsConfig {
+    // 目标值变化率超过门限时认为该通道在机动
+    double climbRateMps = 0.5;
+    double turnRateDps = 0.2;
+    double accelKtsPerSec = 0.1;
+
+    // 调节误差带: max(绝对容差, bandFraction * 指令变化量); 变化量小于绝对容差的指令不统计响应
+    double altitudeBandM = 5.0;
+    double headingBandDeg = 0.5;
+    double velocityBandKts = 1.0;
+    double bandFraction = 0.02;
+
+    // 逐段列表和逐次响应列表的上限 (超过后只更新汇总统计)
+    size_t maxSegments = 256;
+    size_t maxResponses = 256;
+};
+
+// 一个连续的机动阶段
+struct PhaseSegment {
+    ManeuverPhase phase = MANEUVER_CRUISE;
+    double startTime = 0.0;
+    double endTime = 0.0;
+    TrackingStats stats;
+};
+
+// 同一类阶段的汇总
+struct PhaseSummary {
+    double duration = 0.0;
+    uint32_t segments = 0;
+    TrackingStats stats;
+};
+
+// 一次指令变化的响应
+struct StepResponse {
+    ResponseChannel channel = RESPONSE_ALT;
+    double startTime = 0.0;     // 指令开始变化
+    double endTime = 0.0;       // 指令停止变化
+    double from = 0.0;
+    double to = 0.0;
+    double step = 0.0;          // 变化量 (航向按实际转过的角度, 可超过180度)
+    double overshoot = 0.0;     // 沿变化方向超过目标的最大值 (米/度/节)
+    double overshootPct = 0.0;  // 超调量 / |step| * 100
+    double settlingTime = -1.0; // endTime 之后进入误差带并保持到下一次变化 (或结束) 所需时间; -1 表示未稳定
+    bool interrupted = false;   // 指令在变化中途反转 (S型转弯), 没有观察超调和调节, 不计入超调/调节统计
+};
+
+// 同一通道的响应汇总
+struct ResponseSummary {
+    uint32_t count = 0;         // 完整的响应 (不含 interrupted)
+    uint32_t settled = 0;
+    uint32_t interrupted = 0;   // 中途反转的响应
+    RunningStats overshoot;
+    RunningStats overshootPct;
+    RunningStats settlingTime;  // 只统计已稳定的响应
+};
+
+class TrackingAnalytics {
+public:
+    explicit TrackingAnalytics(const AnalyticsConfig& config = AnalyticsConfig());
+
+    // 按上限 (maxSegments/maxResponses) 预先分配逐段和逐次列表, 之后 add/finish 不再分配堆内存
+    void reserve();
+
+    // 按时间顺序加入一步
+    void add(const StateLogRecord& record);
+    // 结束当前阶段和未完成的响应; 全部 add 之后、输出或 merge 之前调用一次
+    void finish();
+    // 合并另一架飞机的汇总 (误差统计、阶段汇总、响应汇总); 逐段和逐次列表不合并
+    void merge(const TrackingAnalytics& o);
+
+    uint64_t samples() const { return m_samples; }
+    double duration() const { return m_duration; }
+    uint32_t aircraftCount() const { return m_aircraftCount; }
+
+    const ErrorChannel& dist() const { return m_dist; }
+    const ErrorChannel& alt() const { return m_alt; }
+    const ErrorChannel& hdg() const { return m_hdg; }
+    const ErrorChannel& vel() const { return m_vel; }
+
+    const PhaseSummary& phase(ManeuverPhase p) const { return m_phases[p]; }
+    const std::vector<PhaseSegment>& segments() const { return m_segments; }
+    const ResponseSummary& response(ResponseChannel c) const { return m_responses[c]; }
+    const std::vector<StepResponse>& responses() const { return m_responseList; }
+
+    // 汇总输出
+    void writeJson(std::ostream& out) const;
+    // 每行一个 (范围, 通道): 范围为 all 或阶段名; all 行附带该通道的响应汇总
+    void writeCsv(std::ostream& out) const;
+
+private:
+    // 单通道指令变化的跟踪状态
+    struct ResponseTracker {
+        bool changing = false;
+        bool pending = false;   // 指令已停止变化, 正在观察超调和调节
+        StepResponse current;
+        double band = 0.0;
+        double settleStart = -1.0;
+    };
+
+    ManeuverPhase classify(double altRate, double hdgRate, double velRate) const;
+    void addToPhase(ManeuverPhase phase, const StateLogRecord& r, double dt);
+    void trackResponse(ResponseChannel c, double time, double prevTime, double command, double prevCommand,
+                       double commandDelta, double rate, double threshold, double actual);
+    void finishResponse(ResponseChannel c);
+    void closeSegment();
+
+private:
+    AnalyticsConfig m_config;
+
+    uint64_t m_samples = 0;
+    double m_duration = 0.0;
+    uint32_t m_aircraftCount = 0;
+
+    ErrorChannel m_dist, m_alt, m_hdg, m_vel;
+
+    // 上一步; 第一步的误差等到第二步确定阶段后再计入
+    bool m_hasPrevious = false;
+    bool m_firstPending = false;
+    StateLogRecord m_firstRecord;
+    double m_prevTime = 0.0;
+    double m_prevAlt = 0.0, m_prevHdg = 0.0, m_prevVel = 0.0;
+
+    // 阶段
+    PhaseSummary m_phases[MANEUVER_PHASE_COUNT];
+    bool m_segmentOpen = false;
+    PhaseSegment m_segment;
+    std::vector<PhaseSegment> m_segments;
+
+    // 指令响应
+    ResponseTracker m_trackers[RESPONSE_CHANNEL_COUNT];
+    ResponseSummary m_responses[RESPONSE_CHANNEL_COUNT];
+    std::vector<StepResponse> m_responseList;
+};
+
+#endif // TRACKING_ANALYTICS_HPP
@@ -0,0 +1,53 @@
+// TrackingDriver.cpp
+#include "TrackingDriver.hpp"
+#include <cmath>
+
+AircraftState trackingStartState(const TrajectoryPoint& startPoint) {
+    AircraftState initialState;
+    initialState.position = startPoint.position;
+    initialState.yaw = startPoint.headingDeg * oe_base::angle::D2RCC;
+    double startVelMps = startPoint.velocityKts * oe_base::units::KTS2MPS;
+    initialState.bodyVelocity.set(startVelMps, 0, 0);
+    initialState.velocity.set(startVelMps * std::cos(initialState.yaw), startVelMps * std::sin(initialState.yaw), 0);
+    return initialState;
+}
+
+FlightCommand trackingCommand(const TrajectorySample& target) {
+    FlightCommand command;
+    command.altitudeM = -target.position.z();
+    command.velocityKts = target.velocityKts;
+    command.headingDeg = target.headingDeg;
+    return command;
+}
+
+StateLogRecord trackingRecord(double simTime, const TrajectorySample& target,
+                              const FlightCommand& command, const AircraftState& state) {
+    const oe_base::Vec3d posErrorVec(
+        state.position.x() - target.position.x(),
+        state.position.y() - target.position.y(),
+        state.position.z() - target.position.z()
+    );
+    double currentAlt = -state.position.z();
+    double currentHdg = oe_base::aepcdDeg(state.yaw * oe_base::angle::R2DCC);
+    double currentKts = state.bodyVelocity.length() * oe_base::units::MPS2KTS;
+
+    StateLogRecord record;
+    record.time = simTime;
+    record.posX = state.position.x();
+    record.posY = state.position.y();
+    record.alt = currentAlt;
+    record.rollDeg = state.roll * oe_base::angle::R2DCC;
+    record.pitchDeg = state.pitch * oe_base::angle::R2DCC;
+    record.yawDeg = currentHdg;
+    record.velKts = currentKts;
+    record.targetPosX = target.position.x();
+    record.targetPosY = target.position.y();
+    record.targetAlt = command.altitudeM;
+    record.targetHdg = command.headingDeg;
+    record.targetVelKts = command.velocityKts;
+    record.errorDist = posErrorVec.length();
+    record.errorAlt = currentAlt - command.altitudeM;
+    record.errorHdg = oe_base::aepcdDeg(currentHdg - command.headingDeg);
+    record.errorVel = currentKts - command.velocityKts;
+    return record;
+}
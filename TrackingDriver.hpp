@@ -0,0 +1,97 @@
+// TrackingDriver.hpp
+#ifndef TRACKING_DRIVER_HPP
+#define TRACKING_DRIVER_HPP
+
+#include <cstddef>
+#include <utility>
+#include "AllocationGuard.hpp"
+#include "FlightModel.hpp"
+#include "Profiler.hpp"
+#include "StateLogger.hpp"
+#include "Trajectory.hpp"
+#include "TrajectoryTrack.hpp"
+
+// 轨迹跟踪驱动程序 (main.cpp 与 main_rac.cpp 共用)
+// 对任意满足 FlightModel 接口的模型: 每步按当前仿真时间在期望轨迹上插值, 下达三通道指令,
+// 推进一步, 计算跟踪误差并交给 sink(const StateLogRecord&) (写日志、统计等)。
+
+// 与轨迹点一致的初始状态 (位置、航向、速度)
+AircraftState trackingStartState(const TrajectoryPoint& startPoint);
+
+// 期望轨迹点对应的指令
+FlightCommand trackingCommand(const TrajectorySample& target);
+
+// 一步的状态、目标和误差 (即日志中的一行)
+StateLogRecord trackingRecord(double simTime, const TrajectorySample& target,
+                              const FlightCommand& command, const AircraftState& state);
+
+// float 模型: 先把状态转换为 double
+template<class T>
+StateLogRecord trackingRecord(double simTime, const TrajectorySample& target,
+                              const FlightCommand& command, const AircraftStateT<T>& state) {
+    return trackingRecord(simTime, target, command, stateCast<double>(state));
+}
+
+// 跟踪循环的一步 (插值期望轨迹 -> 下达指令 -> 推进 -> 误差), 供 runTrackingScenario 和实时运行 (RealTimeRunner) 共用
+// guidanceDivider: 每N步下达一次指令 (1 为每步, 即 main.cpp 的用法), 其间模型保持上次指令算出的
+// 角速度/加速度 (RacModel 保持指令)。日志中的位置误差仍按当前时刻的期望轨迹计算, 目标高度/航向/速度为生效中的指令。
+template<class Model>
+class TrackingLoop {
+    static_assert(IsFlightModel<Model>::value, "Model must provide the FlightModel interface");
+
+public:
+    TrackingLoop(Model& model, const TrajectoryTrack& track, unsigned guidanceDivider = 1)
+        : m_model(model), m_track(track), m_guidanceDivider(guidanceDivider) {
+        LAERO_PROFILE_REGISTER_THREAD();    // 在 step 的禁止分配区间之前登记
+    }
+
+    StateLogRecord step(double simTime, double dt) {
+        LAERO_PROFILE_SCOPE(PHASE_FRAME);
+        LAERO_NO_ALLOC_SCOPE();
+
+        // 1. 按当前仿真时间在期望轨迹上插值 (均匀采样时O(1)直接定位)
+        const TrajectorySample target = m_track.sample(simTime, m_cursor);
+
+        // 2. 制导时刻下达指令
+        if (m_phase == 0) {
+            m_command = trackingCommand(target);
+            m_model.command(m_command);
+        }
+        if (++m_phase >= m_guidanceDivider) m_phase = 0;
+
+        // 3. 推进动力学
+        m_model.update(dt);
+
+        // 4. 误差
+        return trackingRecord(simTime, target, m_command, m_model.getState());
+    }
+
+private:
+    Model& m_model;
+    const TrajectoryTrack& m_track;
+    TrajectoryTrack::Cursor m_cursor;
+    FlightCommand m_command;
+    unsigned m_guidanceDivider;
+    unsigned m_phase = 0;
+};
+
+// 从 t=0 跟踪到轨迹结束, 返回步数
+template<class Model, class Sink>
+size_t runTrackingScenario(Model& model, const TrajectoryTrack& track, const double dt,
+                           const unsigned guidanceDivider, Sink&& sink) {
+    TrackingLoop<Model> loop(model, track, guidanceDivider);
+    size_t steps = 0;
+    for (double simTime = 0.0; simTime <= track.endTime(); simTime += dt) {
+        LAERO_NO_ALLOC_SCOPE();     // sink (写日志、发布、统计) 也不应分配
+        sink(loop.step(simTime, dt));
+        ++steps;
+    }
+    return steps;
+}
+
+template<class Model, class Sink>
+size_t runTrackingScenario(Model& model, const TrajectoryTrack& track, const double dt, Sink&& sink) {
+    return runTrackingScenario(model, track, dt, 1, std::forward<Sink>(sink));
+}
+
+#endif // TRACKING_DRIVER_HPP
@@ -0,0 +1,77 @@
+// TrackingStats.hpp
+#ifndef TRACKING_STATS_HPP
+#define TRACKING_STATS_HPP
+
+#include <cmath>
+#include <cstdint>
+
+// 流式统计量 (Welford算法), 逐个样本更新, 不保存样本
+class RunningStats {
+public:
+    void add(double x) {
+        ++m_count;
+        const double delta = x - m_mean;
+        m_mean += delta / static_cast<double>(m_count);
+        m_m2 += delta * (x - m_mean);
+        m_sumSq += x * x;
+        if (m_count == 1 || x < m_min) m_min = x;
+        if (m_count == 1 || x > m_max) m_max = x;
+    }
+
+    // 合并另一组统计 (并行归约)
+    void merge(const RunningStats& o) {
+        if (o.m_count == 0) return;
+        if (m_count == 0) { *this = o; return; }
+        const double n = static_cast<double>(m_count + o.m_count);
+        const double delta = o.m_mean - m_mean;
+        m_m2 += o.m_m2 + delta * delta * static_cast<double>(m_count) * static_cast<double>(o.m_count) / n;
+        m_mean += delta * static_cast<double>(o.m_count) / n;
+        m_sumSq += o.m_sumSq;
+        if (o.m_min < m_min) m_min = o.m_min;
+        if (o.m_max > m_max) m_max = o.m_max;
+        m_count += o.m_count;
+    }
+
+    void clear() { *this = RunningStats(); }
+
+    uint64_t count() const { return m_count; }
+    double mean() const { return m_mean; }
+    double variance() const { return (m_count > 1) ? m_m2 / static_cast<double>(m_count - 1) : 0.0; }
+    double stddev() const { return std::sqrt(variance()); }
+    double rms() const { return (m_count > 0) ? std::sqrt(m_sumSq / static_cast<double>(m_count)) : 0.0; }
+    double min() const { return m_min; }
+    double max() const { return m_max; }
+    double maxAbs() const { return std::fabs(m_min) > std::fabs(m_max) ? std::fabs(m_min) : std::fabs(m_max); }
+
+private:
+    uint64_t m_count = 0;
+    double m_mean = 0.0;
+    double m_m2 = 0.0;
+    double m_sumSq = 0.0;
+    double m_min = 0.0;
+    double m_max = 0.0;
+};
+
+// 轨迹跟踪误差统计, 对应日志中的 ErrorDist / ErrorAlt / ErrorHdg / ErrorVel 四列
+struct TrackingStats {
+    RunningStats dist;  // 位置误差 (米)
+    RunningStats alt;   // 高度误差 (米)
+    RunningStats hdg;   // 航向误差 (度)
+    RunningStats vel;   // 速度误差 (节)
+
+    void add(double errorDist, double errorAlt, double errorHdg, double errorVel) {
+        dist.add(errorDist);
+        alt.add(errorAlt);
+        hdg.add(errorHdg);
+        vel.add(errorVel);
+    }
+
+    void merge(const TrackingStats& o) {
+        dist.merge(o.dist);
+        alt.merge(o.alt);
+        hdg.merge(o.hdg);
+        vel.merge(o.vel);
+    }
+};
+
+#endif // TRACKING_STATS_HPP
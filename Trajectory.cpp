@@ -0,0 +1,94 @@
+// Trajectory.cpp
+#include "Trajectory.hpp"
+#include <cmath>
+
+double detectSampleTime(TrajectorySpan points) {
+    if (points.size() < 2) return 0.0;
+    const double Ts = (points.back().timestamp - points.front().timestamp) / (points.size() - 1);
+    if (!(Ts > 0.0)) return 0.0;
+    for (size_t i = 1; i < points.size(); ++i) {
+        const double step = points[i].timestamp - points[i - 1].timestamp;
+        if (std::abs(step - Ts) > 1.0e-6 * Ts) return 0.0;
+    }
+    return Ts;
+}
+
+size_t maneuverTrajectorySize(double duration, double Ts) {
+    return static_cast<size_t>(duration / Ts) + 2;
+}
+
+namespace {
+
+// 生成S型转弯爬升机动轨迹, 追加到 trajectory (std::vector 或 std::pmr::vector)
+template<class Container>
+void fillManeuverTrajectory(Container& trajectory, double duration, double Ts) {
+    trajectory.reserve(maneuverTrajectorySize(duration, Ts));
+
+    for (double t = 0.0; t <= duration; t += Ts) {
+        TrajectoryPoint p;
+        p.timestamp = t;
+
+        // --- 定义速度和高度剖面 ---
+        // 0-20秒: 加速并爬升
+        // 20-100秒: 保持速度和高度
+        // 100-120秒: 减速并下降
+        if (t < 20.0) {
+            p.velocityKts = 200.0 + (t / 20.0) * 150.0; // 200 -> 350 kts
+            p.position.set(0, 0, -2000.0 - (t / 20.0) * 2000.0); // 2000m -> 4000m
+        } else if (t <= 100.0) {
+            p.velocityKts = 350.0;
+            p.position.set(0, 0, -4000.0);
+        } else {
+            p.velocityKts = 350.0 - ((t - 100.0) / 20.0) * 100.0; // 350 -> 250 kts
+            p.position.set(0, 0, -4000.0 + ((t - 100.0) / 20.0) * 1000.0); // 4000m -> 3000m
+        }
+
+        // --- 定义航向剖面 (S型转弯) ---
+        // 30-60秒: 右转90度
+        // 60-90秒: 左转90度回到原航向
+        if (t > 30.0 && t <= 60.0) {
+            double turn_progress = (t - 30.0) / 30.0;
+            p.headingDeg = turn_progress * 90.0;
+        } else if (t > 60.0 && t <= 90.0) {
+            double turn_progress = (t - 60.0) / 30.0;
+            p.headingDeg = 90.0 - turn_progress * 90.0;
+        } else if (t > 90.0) {
+            p.headingDeg = 0.0;
+        } else {
+            p.headingDeg = 0.0;
+        }
+
+        // --- 通过积分计算位置 ---
+        // (为了简化，这里只积分前一个点的位置，实际样条曲线会更复杂)
+        if (!trajectory.empty()) {
+            const TrajectoryPoint& last_p = trajectory.back();
+            double avg_vel_mps = (last_p.velocityKts + p.velocityKts) / 2.0 * oe_base::units::KTS2MPS;
+            double avg_hdg_rad = (last_p.headingDeg + p.headingDeg) / 2.0 * oe_base::angle::D2RCC;
+            
+            p.position.set(
+                last_p.position.x() + avg_vel_mps * std::cos(avg_hdg_rad) * Ts,
+                last_p.position.y() + avg_vel_mps * std::sin(avg_hdg_rad) * Ts,
+                p.position.z() // 高度已在上面定义
+            );
+        }
+
+        trajectory.push_back(p);
+    }
+}
+
+} // namespace
+
+// 函数：生成一条平滑的S型转弯爬升机动轨迹
+// 采样周期为0.1秒
+std::vector<TrajectoryPoint> createManeuverTrajectory(double duration, double Ts) {
+    std::vector<TrajectoryPoint> trajectory;
+    fillManeuverTrajectory(trajectory, duration, Ts);
+    return trajectory;
+}
+
+std::pmr::vector<TrajectoryPoint> createManeuverTrajectory(std::pmr::memory_resource* resource,
+                                                           double duration, double Ts) {
+    std::pmr::vector<TrajectoryPoint> trajectory(resource);
+    fillManeuverTrajectory(trajectory, duration, Ts);
+    return trajectory;
+}
@@ -0,0 +1,55 @@
+// Trajectory.hpp
+#ifndef TRAJECTORY_HPP
+#define TRAJECTORY_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+#include "OeBase.hpp"
+
+// 定义轨迹点结构体，包含时间戳
+// 注意: 该结构体同时是二进制轨迹文件 (TrajectoryFile.hpp) 的记录布局, 不要增删或重排字段
+struct TrajectoryPoint {
+    double timestamp;         // 时间戳 (秒)
+    oe_base::Vec3d position;  // 期望位置 (x, y, z), z为负表示高度
+    double velocityKts;       // 期望速度大小 (节)
+    double headingDeg;        // 期望航向 (度)
+};
+
+// 只读轨迹视图: 指向 std::vector (或 std::pmr::vector) 或内存映射文件中连续存放的轨迹点, 不拥有数据
+class TrajectorySpan {
+public:
+    TrajectorySpan() {}
+    TrajectorySpan(const TrajectoryPoint* data, size_t size) : m_data(data), m_size(size) {}
+    TrajectorySpan(const std::vector<TrajectoryPoint>& points) : m_data(points.data()), m_size(points.size()) {}
+    TrajectorySpan(const std::pmr::vector<TrajectoryPoint>& points) : m_data(points.data()), m_size(points.size()) {}
+
+    const TrajectoryPoint* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    const TrajectoryPoint& operator[](size_t i) const { return m_data[i]; }
+    const TrajectoryPoint& front() const { return m_data[0]; }
+    const TrajectoryPoint& back() const { return m_data[m_size - 1]; }
+
+    const TrajectoryPoint* begin() const { return m_data; }
+    const TrajectoryPoint* end() const { return m_data + m_size; }
+
+private:
+    const TrajectoryPoint* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+// 均匀采样时返回采样周期 Ts, 否则返回0 (相邻时间差与平均值相差不超过 Ts*1e-6 视为均匀)
+double detectSampleTime(TrajectorySpan points);
+
+// 函数：生成一条平滑的S型转弯爬升机动轨迹
+// 采样周期为0.1秒
+std::vector<TrajectoryPoint> createManeuverTrajectory(double duration = 120.0, double Ts = 0.1);
+// 同上, 轨迹点存放在 resource 中 (如 ScenarioArena), 只分配一次
+std::pmr::vector<TrajectoryPoint> createManeuverTrajectory(std::pmr::memory_resource* resource,
+                                                           double duration = 120.0, double Ts = 0.1);
+// 上面两个函数生成的轨迹点数上限 (预留容量)
+size_t maneuverTrajectorySize(double duration = 120.0, double Ts = 0.1);
+
+#endif // TRAJECTORY_HPP
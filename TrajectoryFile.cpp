@@ -0,0 +1,223 @@
+// TrajectoryFile.cpp
+#include "TrajectoryFile.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const uint64_t RECORDS_ALIGNMENT = 64;
+
+uint64_t alignUp(uint64_t x, uint64_t a) {
+    return (x + a - 1) / a * a;
+}
+
+// 解析一行CSV中的数值, 返回字段数 (遇到非数值返回0)
+size_t parseCsvLine(const std::string& line, double* values, size_t maxValues) {
+    const char* p = line.c_str();
+    size_t n = 0;
+    while (*p != '\0' && n < maxValues) {
+        char* end = nullptr;
+        values[n] = std::strtod(p, &end);
+        if (end == p) return 0;
+        ++n;
+        p = end;
+        while (*p == ' ' || *p == '\t' || *p == '\r') ++p;
+        if (*p == ',') ++p;
+        else if (*p != '\0') return 0;
+    }
+    return n;
+}
+
+} // namespace
+
+// ==============================================================
+// 写入
+// ==============================================================
+bool writeTrajectoryFile(const std::string& path, const std::vector<std::vector<TrajectoryPoint>>& trajectories) {
+    TrajectoryFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TRAJECTORY_FILE_MAGIC, sizeof(header.magic));
+    header.version = TRAJECTORY_FILE_VERSION;
+    header.byteOrder = TRAJECTORY_FILE_BYTE_ORDER;
+    header.headerSize = sizeof(TrajectoryFileHeader);
+    header.recordSize = sizeof(TrajectoryPoint);
+    header.trajectoryCount = trajectories.size();
+
+    std::vector<TrajectoryIndexEntry> index(trajectories.size());
+    uint64_t recordCount = 0;
+    for (size_t k = 0; k < trajectories.size(); ++k) {
+        std::memset(&index[k], 0, sizeof(TrajectoryIndexEntry));
+        index[k].firstRecord = recordCount;
+        index[k].recordCount = trajectories[k].size();
+        index[k].sampleTime = detectSampleTime(trajectories[k]);
+        recordCount += trajectories[k].size();
+    }
+    header.recordCount = recordCount;
+    header.indexOffset = sizeof(TrajectoryFileHeader);
+    header.recordsOffset = alignUp(header.indexOffset + index.size() * sizeof(TrajectoryIndexEntry), RECORDS_ALIGNMENT);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(TrajectoryIndexEntry));
+
+    const uint64_t written = header.indexOffset + index.size() * sizeof(TrajectoryIndexEntry);
+    const char zeros[RECORDS_ALIGNMENT] = {};
+    out.write(zeros, header.recordsOffset - written);
+
+    for (const std::vector<TrajectoryPoint>& t : trajectories) {
+        out.write(reinterpret_cast<const char*>(t.data()), t.size() * sizeof(TrajectoryPoint));
+    }
+    return out.good();
+}
+
+bool writeTrajectoryFile(const std::string& path, const std::vector<TrajectoryPoint>& trajectory) {
+    return writeTrajectoryFile(path, std::vector<std::vector<TrajectoryPoint>>(1, trajectory));
+}
+
+// ==============================================================
+// CSV读取
+// ==============================================================
+bool readTrajectoryCsv(const std::string& path, std::vector<std::vector<TrajectoryPoint>>& trajectories) {
+    std::ifstream in(path);
+    if (!in.is_open()) return false;
+
+    trajectories.clear();
+    std::string line;
+    double values[8];
+    double lastId = 0.0;
+    size_t lineNo = 0;
+
+    while (std::getline(in, line)) {
+        ++lineNo;
+        if (line.empty() || line == "\r") continue;
+
+        const size_t n = parseCsvLine(line, values, 8);
+        if (n == 0 && lineNo == 1) continue; // 表头
+        if (n != 6 && n != 7) return false;
+
+        const double* v = values;
+        bool newTrajectory = trajectories.empty();
+        if (n == 7) {
+            newTrajectory = newTrajectory || (values[0] != lastId);
+            lastId = values[0];
+            ++v;
+        }
+        if (newTrajectory) trajectories.emplace_back();
+
+        TrajectoryPoint p;
+        p.timestamp = v[0];
+        p.position.set(v[1], v[2], v[3]);
+        p.velocityKts = v[4];
+        p.headingDeg = v[5];
+        trajectories.back().push_back(p);
+    }
+    return true;
+}
+
+// ==============================================================
+// 内存映射读取
+// ==============================================================
+MappedTrajectoryFile::MappedTrajectoryFile() {
+}
+
+MappedTrajectoryFile::~MappedTrajectoryFile() {
+    close();
+}
+
+bool MappedTrajectoryFile::fail(const std::string& msg) {
+    close();
+    m_error = msg;
+    return false;
+}
+
+bool MappedTrajectoryFile::open(const std::string& path) {
+    close();
+    m_error.clear();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return fail("cannot open " + path);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return fail("cannot stat " + path);
+    }
+    m_length = static_cast<size_t>(st.st_size);
+    if (m_length < sizeof(TrajectoryFileHeader)) {
+        ::close(fd);
+        return fail("file too small for header");
+    }
+
+    void* base = ::mmap(nullptr, m_length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // 映射建立后可关闭文件描述符
+    if (base == MAP_FAILED) return fail("mmap failed for " + path);
+    m_base = base;
+
+    // --- 校验文件头 ---
+    const char* bytes = static_cast<const char*>(m_base);
+    m_header = reinterpret_cast<const TrajectoryFileHeader*>(bytes);
+    if (std::memcmp(m_header->magic, TRAJECTORY_FILE_MAGIC, sizeof(m_header->magic)) != 0) return fail("bad magic");
+    if (m_header->version != TRAJECTORY_FILE_VERSION) return fail("unsupported version");
+    if (m_header->byteOrder != TRAJECTORY_FILE_BYTE_ORDER) return fail("byte order mismatch");
+    if (m_header->headerSize != sizeof(TrajectoryFileHeader)) return fail("header size mismatch");
+    if (m_header->recordSize != sizeof(TrajectoryPoint)) return fail("record size mismatch");
+
+    // 按除法比较条数, 不计算 偏移 + 条数 × 大小 (精心构造的文件头会使乘法和加法溢出)
+    if (m_header->indexOffset % alignof(TrajectoryIndexEntry) != 0 || m_header->indexOffset > m_length ||
+        m_header->trajectoryCount > (m_length - m_header->indexOffset) / sizeof(TrajectoryIndexEntry)) {
+        return fail("index out of range");
+    }
+    if (m_header->recordsOffset % alignof(TrajectoryPoint) != 0 || m_header->recordsOffset > m_length ||
+        m_header->recordCount > (m_length - m_header->recordsOffset) / sizeof(TrajectoryPoint)) {
+        return fail("records out of range");
+    }
+
+    m_index = reinterpret_cast<const TrajectoryIndexEntry*>(bytes + m_header->indexOffset);
+    m_records = reinterpret_cast<const TrajectoryPoint*>(bytes + m_header->recordsOffset);
+
+    // 每条轨迹的记录区间 [firstRecord, firstRecord + recordCount) 在记录区内 (同样不做可能溢出的加法)
+    for (uint64_t k = 0; k < m_header->trajectoryCount; ++k) {
+        if (m_index[k].firstRecord > m_header->recordCount ||
+            m_index[k].recordCount > m_header->recordCount - m_index[k].firstRecord) {
+            return fail("index entry out of range");
+        }
+    }
+    return true;
+}
+
+void MappedTrajectoryFile::close() {
+    if (m_base != nullptr) {
+        ::munmap(m_base, m_length);
+    }
+    m_base = nullptr;
+    m_length = 0;
+    m_header = nullptr;
+    m_index = nullptr;
+    m_records = nullptr;
+}
+
+size_t MappedTrajectoryFile::trajectoryCount() const {
+    return m_header ? static_cast<size_t>(m_header->trajectoryCount) : 0;
+}
+
+TrajectorySpan MappedTrajectoryFile::trajectory(size_t k) const {
+    if (k >= trajectoryCount()) return TrajectorySpan();
+    return TrajectorySpan(m_records + m_index[k].firstRecord, static_cast<size_t>(m_index[k].recordCount));
+}
+
+double MappedTrajectoryFile::sampleTime(size_t k) const {
+    if (k >= trajectoryCount()) return 0.0;
+    return m_index[k].sampleTime;
+}
+
+TrajectorySpan MappedTrajectoryFile::records() const {
+    if (!m_header) return TrajectorySpan();
+    return TrajectorySpan(m_records, static_cast<size_t>(m_header->recordCount));
+}
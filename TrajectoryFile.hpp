@@ -0,0 +1,94 @@
+// TrajectoryFile.hpp
+#ifndef TRAJECTORY_FILE_HPP
+#define TRAJECTORY_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Trajectory.hpp"
+
+// 二进制轨迹文件 (.ltrj), 版本1
+//
+// 固定布局, 小端, 所有偏移以字节计:
+//   [0]              TrajectoryFileHeader (64字节)
+//   [indexOffset]    TrajectoryIndexEntry[trajectoryCount] (每项32字节)
+//   [recordsOffset]  TrajectoryPoint[recordCount] (每条48字节, 64字节对齐起始)
+//
+// 一个文件可包含多条轨迹 (轨迹集), 每条轨迹的记录在文件中连续存放。
+// 读取时整个文件以只读 mmap 映射, 记录直接作为 TrajectoryPoint 访问, 不做任何拷贝或解析,
+// 多个进程打开同一文件时共享操作系统页缓存。
+
+const char TRAJECTORY_FILE_MAGIC[8] = { 'L', 'A', 'E', 'R', 'O', 'T', 'R', 'J' };
+const uint32_t TRAJECTORY_FILE_VERSION = 1;
+const uint32_t TRAJECTORY_FILE_BYTE_ORDER = 0x01020304;
+
+struct TrajectoryFileHeader {
+    char     magic[8];          // TRAJECTORY_FILE_MAGIC
+    uint32_t version;           // TRAJECTORY_FILE_VERSION
+    uint32_t byteOrder;         // 按本机字节序写入 TRAJECTORY_FILE_BYTE_ORDER
+    uint32_t headerSize;        // sizeof(TrajectoryFileHeader)
+    uint32_t recordSize;        // sizeof(TrajectoryPoint)
+    uint64_t trajectoryCount;   // 轨迹条数
+    uint64_t recordCount;       // 记录总数
+    uint64_t indexOffset;       // 索引表起始偏移
+    uint64_t recordsOffset;     // 记录区起始偏移
+    uint64_t reserved;
+};
+
+struct TrajectoryIndexEntry {
+    uint64_t firstRecord;       // 第一条记录在记录区中的序号
+    uint64_t recordCount;       // 记录条数
+    double   sampleTime;        // 均匀采样周期 Ts (秒); 非均匀采样时为0
+    double   reserved;
+};
+
+static_assert(sizeof(TrajectoryFileHeader) == 64, "TrajectoryFileHeader layout changed");
+static_assert(sizeof(TrajectoryIndexEntry) == 32, "TrajectoryIndexEntry layout changed");
+static_assert(sizeof(TrajectoryPoint) == 48, "TrajectoryPoint layout changed");
+
+// --- 写入 ---
+bool writeTrajectoryFile(const std::string& path, const std::vector<std::vector<TrajectoryPoint>>& trajectories);
+bool writeTrajectoryFile(const std::string& path, const std::vector<TrajectoryPoint>& trajectory);
+
+// 读取CSV并转换为轨迹集
+// 每行: [id,]timestamp,x,y,z,velocityKts,headingDeg; 首行可以是表头
+// 有id列时按id的变化切分为多条轨迹, 否则整个文件为一条轨迹
+bool readTrajectoryCsv(const std::string& path, std::vector<std::vector<TrajectoryPoint>>& trajectories);
+
+// --- 内存映射读取 ---
+class MappedTrajectoryFile {
+public:
+    MappedTrajectoryFile();
+    ~MappedTrajectoryFile();
+
+    MappedTrajectoryFile(const MappedTrajectoryFile&) = delete;
+    MappedTrajectoryFile& operator=(const MappedTrajectoryFile&) = delete;
+
+    // 映射并校验文件; 失败时返回false, 原因见 lastError()
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_base != nullptr; }
+
+    size_t trajectoryCount() const;
+    TrajectorySpan trajectory(size_t k) const;
+    double sampleTime(size_t k) const;
+
+    // 全部记录 (所有轨迹首尾相接)
+    TrajectorySpan records() const;
+
+    const std::string& lastError() const { return m_error; }
+
+private:
+    bool fail(const std::string& msg);
+
+private:
+    void* m_base = nullptr;
+    size_t m_length = 0;
+    const TrajectoryFileHeader* m_header = nullptr;
+    const TrajectoryIndexEntry* m_index = nullptr;
+    const TrajectoryPoint* m_records = nullptr;
+    std::string m_error;
+};
+
+#endif // TRAJECTORY_FILE_HPP
@@ -0,0 +1,350 @@
+// TrajectorySynth.cpp
+#include "TrajectorySynth.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "FleetScheduler.hpp"
+#include "TrajectoryTrack.hpp"
+
+namespace {
+
+// 前缀和的分块大小 (固定, 保证结果与线程数无关)
+const size_t BLOCK_POINTS = 4096;
+
+// 各段起点的时刻和通道值; 第 n 项为剖面终点
+struct SegmentStart {
+    double time;
+    double altitudeM;
+    double headingDeg;
+    double velocityKts;
+};
+
+std::vector<SegmentStart> segmentStarts(const TrajectoryProfile& profile) {
+    std::vector<SegmentStart> starts(profile.segments.size() + 1);
+    SegmentStart s = { 0.0, profile.startAltitudeM, profile.startHeadingDeg, profile.startVelocityKts };
+    for (size_t j = 0; j < profile.segments.size(); ++j) {
+        starts[j] = s;
+        const ProfileSegment& seg = profile.segments[j];
+        s.time += std::max(0.0, seg.duration);
+        s.altitudeM += seg.altitudeChangeM;
+        s.headingDeg += seg.headingChangeDeg;
+        s.velocityKts += seg.velocityChangeKts;
+    }
+    starts.back() = s;
+    return starts;
+}
+
+// 剖面求值: 第 [i0, i1) 点的时刻、高度 (position.z)、航向 (未回绕) 和速度
+// 时刻 t 在 [段起点, 下一段起点) 内时属于该段; 剖面结束后保持终点值
+void evaluateProfile(const TrajectoryProfile& profile, const std::vector<SegmentStart>& starts, double h,
+                     size_t i0, size_t i1, TrajectoryPoint* points) {
+    const size_t n = profile.segments.size();
+    const double t0 = i0 * h;
+    size_t j = static_cast<size_t>(std::upper_bound(starts.begin(), starts.begin() + n, t0,
+                                                    [](double t, const SegmentStart& s) { return t < s.time; })
+                                   - starts.begin());
+    j = (j > 0) ? j - 1 : 0;
+
+    size_t i = i0;
+    while (i < i1) {
+        // 跳过已经结束的段 (包括时长为0的段)
+        while (j < n && !(starts[j + 1].time > i * h)) ++j;
+        if (j >= n) {
+            // 剖面结束
+            const SegmentStart& e = starts[n];
+            for (; i < i1; ++i) {
+                TrajectoryPoint& p = points[i - i0];
+                p.timestamp = i * h;
+                p.position.set(0.0, 0.0, -e.altitudeM);
+                p.headingDeg = e.headingDeg;
+                p.velocityKts = e.velocityKts;
+            }
+            break;
+        }
+
+        // 本段内的点: i*h < 下一段起点
+        const double end = starts[j + 1].time;
+        size_t iEnd = static_cast<size_t>(std::ceil(end / h));
+        while (iEnd > i && (iEnd - 1) * h >= end) --iEnd;
+        while (iEnd * h < end) ++iEnd;
+        iEnd = std::min(iEnd, i1);
+
+        const SegmentStart& s = starts[j];
+        const ProfileSegment& seg = profile.segments[j];
+        TrajectoryPoint* out = points - i0;
+        for (size_t k = i; k < iEnd; ++k) {
+            const double t = k * h;
+            const double alpha = (t - s.time) / seg.duration;
+            out[k].timestamp = t;
+            out[k].position.set(0.0, 0.0, -(s.altitudeM + alpha * seg.altitudeChangeM));
+            out[k].headingDeg = s.headingDeg + alpha * seg.headingChangeDeg;
+            out[k].velocityKts = s.velocityKts + alpha * seg.velocityChangeKts;
+        }
+        i = iEnd;
+        ++j;
+    }
+}
+
+// 相邻两点间的水平位移 (梯形: 平均速度 × 平均航向)
+inline void displacement(const TrajectoryPoint& a, const TrajectoryPoint& b, double h, double& dn, double& de) {
+    const double avgVelMps = (a.velocityKts + b.velocityKts) / 2.0 * oe_base::units::KTS2MPS;
+    const double avgHdgRad = (a.headingDeg + b.headingDeg) / 2.0 * oe_base::angle::D2RCC;
+    double s, c;
+    oe_base::fastSinCos(avgHdgRad, s, c);
+    dn = avgVelMps * c * h;
+    de = avgVelMps * s * h;
+}
+
+// 第1步: 一块的剖面求值, 位置为块内增量的前缀和; 返回块内总位移
+void synthesizeBlock(const TrajectoryProfile& profile, const std::vector<SegmentStart>& starts, double h,
+                     size_t i0, size_t i1, TrajectoryPoint* points, double& totalN, double& totalE) {
+    evaluateProfile(profile, starts, h, i0, i1, points + i0);
+
+    TrajectoryPoint prev;
+    if (i0 > 0) evaluateProfile(profile, starts, h, i0 - 1, i0, &prev);
+
+    double n = 0.0, e = 0.0;
+    for (size_t i = i0; i < i1; ++i) {
+        if (i > 0) {
+            double dn, de;
+            displacement(i > i0 ? points[i - 1] : prev, points[i], h, dn, de);
+            n += dn;
+            e += de;
+        }
+        points[i].position.set(n, e, points[i].position.z());
+    }
+    totalN = n;
+    totalE = e;
+}
+
+// 第3步: 加上块的起点位置, 航向回绕到 -180 ~ +180
+void offsetBlock(size_t i0, size_t i1, double offsetN, double offsetE, TrajectoryPoint* points) {
+    for (size_t i = i0; i < i1; ++i) {
+        TrajectoryPoint& p = points[i];
+        p.position.set(offsetN + p.position.x(), offsetE + p.position.y(), p.position.z());
+        p.headingDeg = oe_base::aepcdDeg(p.headingDeg);
+    }
+}
+
+// 以 h 为步长合成 count 个点
+void integrate(const TrajectoryProfile& profile, double h, size_t count,
+               std::vector<TrajectoryPoint>& out, FleetScheduler* scheduler) {
+    out.resize(count);
+    if (count == 0) return;
+
+    const std::vector<SegmentStart> starts = segmentStarts(profile);
+    const size_t blocks = (count + BLOCK_POINTS - 1) / BLOCK_POINTS;
+    std::vector<double> totals(2 * blocks);
+    std::vector<double> offsets(2 * blocks);
+    TrajectoryPoint* points = out.data();
+
+    auto scan = [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            synthesizeBlock(profile, starts, h, b * BLOCK_POINTS, std::min(count, (b + 1) * BLOCK_POINTS),
+                            points, totals[2 * b], totals[2 * b + 1]);
+        }
+    };
+    auto offset = [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            offsetBlock(b * BLOCK_POINTS, std::min(count, (b + 1) * BLOCK_POINTS),
+                        offsets[2 * b], offsets[2 * b + 1], points);
+        }
+    };
+
+    // 块间偏移 (串行, 每块一项)
+    auto blockOffsets = [&]() {
+        double n = profile.startNorthM, e = profile.startEastM;
+        for (size_t b = 0; b < blocks; ++b) {
+            offsets[2 * b] = n;
+            offsets[2 * b + 1] = e;
+            n += totals[2 * b];
+            e += totals[2 * b + 1];
+        }
+    };
+
+    if (scheduler == nullptr || blocks == 1) {
+        scan(0, blocks);
+        blockOffsets();
+        offset(0, blocks);
+        return;
+    }
+
+    // 每块一个任务
+    scheduler->parallelFor(blocks, 1, scan);
+    blockOffsets();
+    scheduler->parallelFor(blocks, 1, offset);
+}
+
+inline TrajectoryPoint samplePoint(const TrajectoryTrack& track, double t, TrajectoryTrack::Cursor& cursor) {
+    const TrajectorySample s = track.sample(t, cursor);
+    TrajectoryPoint p;
+    p.timestamp = t;
+    p.position = s.position;
+    p.velocityKts = s.velocityKts;
+    p.headingDeg = s.headingDeg;
+    return p;
+}
+
+double uniform(std::mt19937_64& rng, double lo, double hi) {
+    if (hi <= lo) return lo;
+    return std::uniform_real_distribution<double>(lo, hi)(rng);
+}
+
+// 每条剖面独立的随机数流
+std::mt19937_64 profileRng(uint64_t seed, uint64_t index) {
+    std::seed_seq seq{ static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+                       static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32) };
+    return std::mt19937_64(seq);
+}
+
+} // namespace
+
+// ==============================================================
+// 剖面
+// ==============================================================
+ProfileSegment cruiseSegment(double duration) {
+    ProfileSegment s;
+    s.duration = duration;
+    return s;
+}
+
+ProfileSegment climbSegment(double duration, double altitudeChangeM) {
+    ProfileSegment s = cruiseSegment(duration);
+    s.altitudeChangeM = altitudeChangeM;
+    return s;
+}
+
+ProfileSegment turnSegment(double duration, double headingChangeDeg) {
+    ProfileSegment s = cruiseSegment(duration);
+    s.headingChangeDeg = headingChangeDeg;
+    return s;
+}
+
+ProfileSegment accelerateSegment(double duration, double velocityChangeKts) {
+    ProfileSegment s = cruiseSegment(duration);
+    s.velocityChangeKts = velocityChangeKts;
+    return s;
+}
+
+double TrajectoryProfile::duration() const {
+    double d = 0.0;
+    for (const ProfileSegment& s : segments) d += std::max(0.0, s.duration);
+    return d;
+}
+
+TrajectoryProfile maneuverProfile() {
+    TrajectoryProfile p;
+    p.startAltitudeM = 2000.0;
+    p.startHeadingDeg = 0.0;
+    p.startVelocityKts = 200.0;
+
+    ProfileSegment climb = climbSegment(20.0, 2000.0);      // 0-20秒: 加速并爬升
+    climb.velocityChangeKts = 150.0;
+    ProfileSegment descent = climbSegment(20.0, -1000.0);   // 100-120秒: 减速并下降
+    descent.velocityChangeKts = -100.0;
+
+    p.segments.push_back(climb);
+    p.segments.push_back(cruiseSegment(10.0));
+    p.segments.push_back(turnSegment(30.0, 90.0));          // 30-60秒: 右转90度
+    p.segments.push_back(turnSegment(30.0, -90.0));         // 60-90秒: 左转90度回到原航向
+    p.segments.push_back(cruiseSegment(10.0));
+    p.segments.push_back(descent);
+    return p;
+}
+
+TrajectoryProfile randomProfile(const RandomProfileSpec& spec, uint64_t index) {
+    std::mt19937_64 rng = profileRng(spec.seed, index);
+
+    TrajectoryProfile p;
+    p.startAltitudeM = uniform(rng, spec.minAltitudeM, spec.maxAltitudeM);
+    p.startHeadingDeg = uniform(rng, -180.0, 180.0);
+    p.startVelocityKts = uniform(rng, spec.minVelocityKts, spec.maxVelocityKts);
+
+    const unsigned maxSegments = std::max(spec.minSegments, spec.maxSegments);
+    const unsigned count = std::uniform_int_distribution<unsigned>(spec.minSegments, maxSegments)(rng);
+    double alt = p.startAltitudeM;
+    double vel = p.startVelocityKts;
+    p.segments.reserve(count);
+    for (unsigned k = 0; k < count; ++k) {
+        ProfileSegment s = cruiseSegment(uniform(rng, spec.minSegmentSeconds, spec.maxSegmentSeconds));
+        // 每个通道固定消耗同样多的随机数, 一个通道的取值不影响其他通道
+        const double altDraw = uniform(rng, 0.0, 1.0);
+        const double hdgDraw = uniform(rng, 0.0, 1.0);
+        const double velDraw = uniform(rng, 0.0, 1.0);
+        const double altValue = uniform(rng, 0.0, 1.0);
+        const double hdgValue = uniform(rng, -1.0, 1.0);
+        const double velValue = uniform(rng, 0.0, 1.0);
+
+        if (altDraw < spec.changeProbability) {
+            const double lo = std::max(spec.minAltitudeM, alt - spec.maxClimbRateMps * s.duration);
+            const double hi = std::min(spec.maxAltitudeM, alt + spec.maxClimbRateMps * s.duration);
+            s.altitudeChangeM = lo + altValue * (hi - lo) - alt;
+        }
+        if (hdgDraw < spec.changeProbability) {
+            s.headingChangeDeg = hdgValue * spec.maxTurnRateDps * s.duration;
+        }
+        if (velDraw < spec.changeProbability) {
+            const double lo = std::max(spec.minVelocityKts, vel - spec.maxAccelKtsPerSec * s.duration);
+            const double hi = std::min(spec.maxVelocityKts, vel + spec.maxAccelKtsPerSec * s.duration);
+            s.velocityChangeKts = lo + velValue * (hi - lo) - vel;
+        }
+        alt += s.altitudeChangeM;
+        vel += s.velocityChangeKts;
+        p.segments.push_back(s);
+    }
+    return p;
+}
+
+// ==============================================================
+// 合成
+// ==============================================================
+void synthesizeTrajectory(const TrajectoryProfile& profile, const SynthConfig& config,
+                          std::vector<TrajectoryPoint>& out, FleetScheduler* scheduler) {
+    out.clear();
+    const double h = config.integrationStep;
+    const double Ts = config.sampleTime;
+    if (!(h > 0.0) || !(Ts > 0.0)) return;
+
+    const double duration = profile.duration();
+    const size_t outputCount = static_cast<size_t>(std::floor(duration / Ts + 1e-9)) + 1;
+    if (std::fabs(Ts - h) <= 1e-12 * h) {
+        integrate(profile, h, outputCount, out, scheduler);
+        return;
+    }
+
+    // 以 h 积分 (覆盖到剖面结束), 再按 Ts 重采样
+    std::vector<TrajectoryPoint> dense;
+    integrate(profile, h, static_cast<size_t>(std::ceil(duration / h - 1e-9)) + 1, dense, scheduler);
+    const TrajectoryTrack track(dense, h);
+    out.resize(outputCount);
+    TrajectoryTrack::Cursor cursor;
+    for (size_t k = 0; k < outputCount; ++k) {
+        out[k] = samplePoint(track, k * Ts, cursor);
+    }
+}
+
+void synthesizeTrajectories(const std::vector<TrajectoryProfile>& profiles, const SynthConfig& config,
+                            std::vector<std::vector<TrajectoryPoint>>& out, FleetScheduler& scheduler) {
+    out.resize(profiles.size());
+
+    // 每条轨迹一个任务
+    scheduler.parallelFor(profiles.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            synthesizeTrajectory(profiles[k], config, out[k]);
+        }
+    });
+}
+
+void resampleTrajectory(TrajectorySpan points, double Ts, std::vector<TrajectoryPoint>& out) {
+    out.clear();
+    if (points.empty() || !(Ts > 0.0)) return;
+
+    const double t0 = points.front().timestamp;
+    const size_t count = static_cast<size_t>(std::floor((points.back().timestamp - t0) / Ts + 1e-9)) + 1;
+    const TrajectoryTrack track(points);
+    out.resize(count);
+    TrajectoryTrack::Cursor cursor;
+    for (size_t k = 0; k < count; ++k) {
+        out[k] = samplePoint(track, t0 + k * Ts, cursor);
+    }
+}
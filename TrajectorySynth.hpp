@@ -0,0 +1,91 @@
+// TrajectorySynth.hpp
+#ifndef TRAJECTORY_SYNTH_HPP
+#define TRAJECTORY_SYNTH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Trajectory.hpp"
+
+class FleetScheduler;
+
+// 轨迹合成流水线 (代替逐点累加的 createManeuverTrajectory, 用于批量生成训练/测试轨迹)
+//
+// 期望轨迹由剖面段描述: 每段内高度、航向、速度各自线性变化, 爬升/下降、转弯、加减速可以同时进行。
+// 合成分三步, 每一步内各点互不依赖:
+//   1. 剖面求值: 第i点的时刻为 i*h, 在所在段内线性插值高度/航向/速度 (段内无分支, 可自动向量化)
+//   2. 位置增量: 相邻两点的平均速度 × 平均航向的方向余弦 × h (梯形积分, 与 createManeuverTrajectory 相同)
+//   3. 前缀和: 水平位置 = 起点 + 增量的前缀和 (固定大小分块扫描: 块内扫描并行, 块间偏移串行)
+// 分块大小固定, 结果与线程数无关。积分步长 h 与输出采样周期 Ts 相互独立: 两者不同时按 Ts 重采样。
+// 时刻按 i*h 计算 (不累加), 所以与 createManeuverTrajectory 的轨迹不逐位相同 (位置相差约 1e-10 米)。
+
+// 剖面段: 持续 duration 秒, 各通道从段起点的值线性变化到 起点 + 变化量
+struct ProfileSegment {
+    double duration = 0.0;
+    double altitudeChangeM = 0.0;       // 正值爬升, 负值下降
+    double headingChangeDeg = 0.0;      // 正值右转, 负值左转 (可超过360度)
+    double velocityChangeKts = 0.0;     // 正值加速, 负值减速
+};
+
+ProfileSegment cruiseSegment(double duration);
+ProfileSegment climbSegment(double duration, double altitudeChangeM);
+ProfileSegment turnSegment(double duration, double headingChangeDeg);
+ProfileSegment accelerateSegment(double duration, double velocityChangeKts);
+
+// 剖面: 起点状态 + 依次执行的段
+struct TrajectoryProfile {
+    double startNorthM = 0.0;
+    double startEastM = 0.0;
+    double startAltitudeM = 2000.0;
+    double startHeadingDeg = 0.0;
+    double startVelocityKts = 200.0;
+    std::vector<ProfileSegment> segments;
+
+    double duration() const;
+};
+
+// createManeuverTrajectory 的S型转弯爬升剖面 (120秒)
+TrajectoryProfile maneuverProfile();
+
+// 随机剖面的参数
+// 每段时长在 [minSegmentSeconds, maxSegmentSeconds] 内均匀分布; 高度、航向、速度各自以 changeProbability
+// 的概率在该段内变化, 变化率不超过 max*Rate, 高度和速度保持在 [min, max] 内。
+struct RandomProfileSpec {
+    uint64_t seed = 1;
+    unsigned minSegments = 3;
+    unsigned maxSegments = 8;
+    double minSegmentSeconds = 10.0;
+    double maxSegmentSeconds = 40.0;
+    double changeProbability = 0.5;
+
+    double minAltitudeM = 500.0;
+    double maxAltitudeM = 9000.0;
+    double minVelocityKts = 180.0;
+    double maxVelocityKts = 450.0;
+
+    double maxClimbRateMps = 60.0;
+    double maxTurnRateDps = 3.0;
+    double maxAccelKtsPerSec = 5.0;
+};
+
+// 第 index 条随机剖面: 只由 (seed, index) 决定, 与生成顺序和线程无关
+TrajectoryProfile randomProfile(const RandomProfileSpec& spec, uint64_t index);
+
+struct SynthConfig {
+    double integrationStep = 0.1;   // 剖面求值和位置积分的步长 h (秒)
+    double sampleTime = 0.1;        // 输出采样周期 Ts (秒); 与 h 相同时不重采样
+};
+
+// 合成一条轨迹到 out (先清空); scheduler 不为空时在轨迹内部按块并行 (适合很长的轨迹)
+// 从 t=0 到剖面结束, 共 floor(duration / Ts) + 1 个点; 航向范围 -180 ~ +180
+void synthesizeTrajectory(const TrajectoryProfile& profile, const SynthConfig& config,
+                          std::vector<TrajectoryPoint>& out, FleetScheduler* scheduler = nullptr);
+
+// 批量合成: 每条轨迹由一个线程串行合成, 多条轨迹并行; 结果与线程数无关
+void synthesizeTrajectories(const std::vector<TrajectoryProfile>& profiles, const SynthConfig& config,
+                            std::vector<std::vector<TrajectoryPoint>>& out, FleetScheduler& scheduler);
+
+// 按采样周期 Ts 重采样 (TrajectoryTrack 线性插值, 航向按最短方向), 从第一点的时刻开始, 不超过最后一点
+void resampleTrajectory(TrajectorySpan points, double Ts, std::vector<TrajectoryPoint>& out);
+
+#endif // TRAJECTORY_SYNTH_HPP
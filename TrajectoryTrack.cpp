@@ -0,0 +1,109 @@
+// TrajectoryTrack.cpp
+#include "TrajectoryTrack.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+
+TrajectoryTrack::TrajectoryTrack(TrajectorySpan points, double sampleTime)
+    : m_points(points), m_sampleTime(sampleTime) {
+    if (m_sampleTime <= 0.0) {
+        m_sampleTime = detectSampleTime(m_points);
+    }
+}
+
+size_t TrajectoryTrack::locate(double t) const {
+    if (m_points.size() < 2) return 0;
+    if (isUniform()) return locateUniform(t);
+    return locateSearch(t, 0);
+}
+
+size_t TrajectoryTrack::locate(double t, Cursor& cursor) const {
+    if (m_points.size() < 2) return 0;
+    cursor.index = isUniform() ? locateUniform(t) : locateSearch(t, cursor.index);
+    return cursor.index;
+}
+
+size_t TrajectoryTrack::locateUniform(double t) const {
+    const size_t last = m_points.size() - 2;
+    if (std::isnan(t)) return 0;
+    // 先在浮点数中限幅再转换 (超出 size_t 范围的转换是未定义行为)
+    const double k = std::floor((t - m_points.front().timestamp) / m_sampleTime);
+    size_t i;
+    if (!(k > 0.0)) i = 0;
+    else if (k >= static_cast<double>(last)) i = last;
+    else i = static_cast<size_t>(k);
+
+    // 时间戳由累加生成时会有舍入误差, 在相邻区间内修正
+    while (i < last && m_points[i + 1].timestamp <= t) ++i;
+    while (i > 0 && m_points[i].timestamp > t) --i;
+    return i;
+}
+
+size_t TrajectoryTrack::locateSearch(double t, size_t hint) const {
+    if (std::isnan(t)) return 0;
+    const size_t last = m_points.size() - 2;
+    if (hint > last) hint = last;
+
+    // 顺序推进时通常落在上次的区间或下一个区间
+    if (m_points[hint].timestamp <= t) {
+        if (hint == last || t < m_points[hint + 1].timestamp) return hint;
+        if (hint + 1 == last || t < m_points[hint + 2].timestamp) return hint + 1;
+    }
+
+    // 二分查找第一个时间戳大于t的点
+    const TrajectoryPoint* first = m_points.begin();
+    const TrajectoryPoint* it = std::upper_bound(first, m_points.end(), t,
+        [](double value, const TrajectoryPoint& p) { return value < p.timestamp; });
+    const size_t upper = static_cast<size_t>(it - first);
+    if (upper == 0) return 0;
+    return std::min(upper - 1, last);
+}
+
+TrajectorySample TrajectoryTrack::sample(double t) const {
+    LAERO_PROFILE_SCOPE(PHASE_TRAJECTORY_LOOKUP);
+    return interpolate(t, locate(t));
+}
+
+TrajectorySample TrajectoryTrack::sample(double t, Cursor& cursor) const {
+    LAERO_PROFILE_SCOPE(PHASE_TRAJECTORY_LOOKUP);
+    return interpolate(t, locate(t, cursor));
+}
+
+TrajectorySample TrajectoryTrack::interpolate(double t, size_t i) const {
+    TrajectorySample s;
+    s.index = i;
+    if (m_points.empty()) return s;
+
+    const TrajectoryPoint& a = m_points[i];
+    if (m_points.size() < 2) {
+        s.position = a.position;
+        s.velocityKts = a.velocityKts;
+        s.headingDeg = oe_base::aepcdDeg(a.headingDeg);
+        return s;
+    }
+    const TrajectoryPoint& b = m_points[i + 1];
+
+    const double span = b.timestamp - a.timestamp;
+    double alpha = (span > 0.0) ? (t - a.timestamp) / span : 0.0;
+    alpha = std::max(0.0, std::min(1.0, alpha));
+
+    s.position.set(
+        a.position.x() + alpha * (b.position.x() - a.position.x()),
+        a.position.y() + alpha * (b.position.y() - a.position.y()),
+        a.position.z() + alpha * (b.position.z() - a.position.z())
+    );
+    s.velocityKts = a.velocityKts + alpha * (b.velocityKts - a.velocityKts);
+
+    // 航向按最短方向插值, 跨越 ±180 度时不会绕远
+    const double hdgDelta = oe_base::aepcdDeg(b.headingDeg - a.headingDeg);
+    s.headingDeg = oe_base::aepcdDeg(a.headingDeg + alpha * hdgDelta);
+
+    if (span > 0.0) {
+        s.velocity.set(
+            (b.position.x() - a.position.x()) / span,
+            (b.position.y() - a.position.y()) / span,
+            (b.position.z() - a.position.z()) / span
+        );
+    }
+    return s;
+}
@@ -0,0 +1,56 @@
+// TrajectoryTrack.hpp
+#ifndef TRAJECTORY_TRACK_HPP
+#define TRAJECTORY_TRACK_HPP
+
+#include <cstddef>
+#include "Trajectory.hpp"
+
+// 轨迹在某一时刻的插值结果
+struct TrajectorySample {
+    oe_base::Vec3d position;    // 插值位置 (x, y, z)
+    oe_base::Vec3d velocity;    // 相邻两点间的平均地速 (北-东-地), m/s
+    double velocityKts = 0.0;   // 插值速度大小 (节)
+    double headingDeg = 0.0;    // 插值航向 (度), 按最短方向插值, 范围 -180 ~ +180
+    size_t index = 0;           // 所在区间 [index, index+1] 的起点
+};
+
+// 轨迹查询
+// 均匀采样 (Ts) 的轨迹直接由时间算出区间序号, 非均匀采样时退回到带缓存的二分查找。
+// 查询不分配内存; 轨迹本身只读, 可被多架飞机以不同时间偏移同时查询,
+// 每个查询者持有自己的 Cursor 作为缓存。
+class TrajectoryTrack {
+public:
+    // 查询缓存: 上次命中的区间
+    struct Cursor {
+        size_t index = 0;
+    };
+
+    TrajectoryTrack() {}
+    // sampleTime <= 0 时自动检测是否为均匀采样
+    explicit TrajectoryTrack(TrajectorySpan points, double sampleTime = 0.0);
+
+    TrajectorySpan points() const { return m_points; }
+    bool isUniform() const { return m_sampleTime > 0.0; }
+    double sampleTime() const { return m_sampleTime; }
+    double startTime() const { return m_points.empty() ? 0.0 : m_points.front().timestamp; }
+    double endTime() const { return m_points.empty() ? 0.0 : m_points.back().timestamp; }
+
+    // 返回满足 points[i].timestamp <= t < points[i+1].timestamp 的 i (超出范围时取首/末区间, t 为 NaN 时取首区间)
+    size_t locate(double t) const;
+    size_t locate(double t, Cursor& cursor) const;
+
+    // 时刻t的插值状态 (t超出轨迹范围时保持首/末点)
+    TrajectorySample sample(double t) const;
+    TrajectorySample sample(double t, Cursor& cursor) const;
+
+private:
+    size_t locateUniform(double t) const;
+    size_t locateSearch(double t, size_t hint) const;
+    TrajectorySample interpolate(double t, size_t i) const;
+
+private:
+    TrajectorySpan m_points;
+    double m_sampleTime = 0.0;
+};
+
+#endif // TRAJECTORY_TRACK_HPP
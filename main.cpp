@@ -1,166 +1,192 @@
 // main.cpp
-// 编译指令: g++ main.cpp StandaloneLaeroModel.cpp -o ManeuverSim -std=c++17 -I.
-
+// 编译指令: g++ main.cpp StandaloneLaeroModel.cpp Trajectory.cpp TrajectoryFile.cpp TrajectoryTrack.cpp TrackingDriver.cpp TrackingAnalytics.cpp RealTimeRunner.cpp ScenarioArena.cpp StateLogger.cpp SharedState.cpp AirframeProfile.cpp -o ManeuverSim -std=c++17 -I. -pthread
+// 运行: ./ManeuverSim [trajectory.ltrj] [--shm /name] [--guidance-divider N] [--summary file] [--realtime policy]   (不给出轨迹文件时使用内置的S型机动轨迹)
+// 实时运行: --realtime catchup|drop|stretch 以绝对截止时刻锁定60Hz墙钟, 结束时输出帧预算遥测;
+//           --time-scale 倍速, --fail-on-overrun 错过截止时刻即失败 (退出码2), --rt-priority 尝试 SCHED_FIFO
+// 误差分析: --summary summary.json (或 .csv) 在仿真过程中流式统计跟踪误差, 结束时写出汇总, 不需要 Log2Csv + Python
+// 制导分频: --guidance-divider 6 时每6步 (0.1 s, 与轨迹采样周期相同) 下达一次指令, 默认每步
+// 机型参数: --airframe fighter 从 airframes.txt (或 --airframes 指定的文件, TuneSim 的输出) 载入同名机型, 默认为内置参数
+// 实时发布: 加 --shm 时每帧把状态写入共享内存, 其他进程用 ShmView 或 SharedStateReader 读取
+// 日志为二进制格式, 用 Log2Csv 转换为CSV: ./Log2Csv maneuver_log.bin maneuver_log.csv
+// 分阶段计时: 编译时加 -DLAERO_ENABLE_PROFILING Profiler.cpp, 结束时输出各阶段耗时统计
+// 分配陷阱: 编译时加 -DLAERO_TRAP_ALLOCATIONS AllocationGuard.cpp, 仿真循环中发生堆分配时立即 abort
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
-#include <iomanip>
 #include <vector>
 #include <string>
-#include <fstream>
-#include <cmath>
+#include "AirframeProfile.hpp"
 #include "StandaloneLaeroModel.hpp"
-
-// 定义轨迹点结构体，包含时间戳
-struct TrajectoryPoint {
-    double timestamp;         // 时间戳 (秒)
-    oe_base::Vec3d position;  // 期望位置 (x, y, z), z为负表示高度
-    double velocityKts;       // 期望速度大小 (节)
-    double headingDeg;        // 期望航向 (度)
-};
-
-// 函数：生成一条平滑的S型转弯爬升机动轨迹
-// 采样周期为0.1秒
-std::vector<TrajectoryPoint> createManeuverTrajectory(double duration = 120.0, double Ts = 0.1) {
-    std::vector<TrajectoryPoint> trajectory;
-    const double R2D = oe_base::angle::R2DCC;
-
-    for (double t = 0.0; t <= duration; t += Ts) {
-        TrajectoryPoint p;
-        p.timestamp = t;
-
-        // --- 定义速度和高度剖面 ---
-        // 0-20秒: 加速并爬升
-        // 20-100秒: 保持速度和高度
-        // 100-120秒: 减速并下降
-        if (t < 20.0) {
-            p.velocityKts = 200.0 + (t / 20.0) * 150.0; // 200 -> 350 kts
-            p.position.set(0, 0, -2000.0 - (t / 20.0) * 2000.0); // 2000m -> 4000m
-        } else if (t <= 100.0) {
-            p.velocityKts = 350.0;
-            p.position.set(0, 0, -4000.0);
-        } else {
-            p.velocityKts = 350.0 - ((t - 100.0) / 20.0) * 100.0; // 350 -> 250 kts
-            p.position.set(0, 0, -4000.0 + ((t - 100.0) / 20.0) * 1000.0); // 4000m -> 3000m
+#include "Trajectory.hpp"
+#include "TrajectoryFile.hpp"
+#include "TrajectoryTrack.hpp"
+#include "TrackingDriver.hpp"
+#include "TrackingAnalytics.hpp"
+#include "RealTimeRunner.hpp"
+#include "StateLogger.hpp"
+#include "SharedState.hpp"
+#include "ScenarioArena.hpp"
+#include "AllocationGuard.hpp"
+#include "Profiler.hpp"
+
+int main(int argc, char* argv[]) {
+    // --- 命令行 ---
+    std::string trajectoryPath;
+    std::string airframeName;
+    std::string airframesPath = "airframes.txt";
+    std::string shmName;
+    std::string summaryPath;
+    unsigned guidanceDivider = 1;
+    bool realTime = false;
+    RealTimeConfig realTimeConfig;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--shm" && i + 1 < argc) shmName = argv[++i];
+        else if (arg == "--summary" && i + 1 < argc) summaryPath = argv[++i];
+        else if (arg == "--airframe" && i + 1 < argc) airframeName = argv[++i];
+        else if (arg == "--airframes" && i + 1 < argc) airframesPath = argv[++i];
+        else if (arg == "--realtime" && i + 1 < argc) {
+            realTime = true;
+            if (!parseOverrunPolicy(argv[++i], realTimeConfig.policy)) {
+                std::cerr << "Error: overrun policy must be catchup, drop or stretch." << std::endl;
+                return 1;
+            }
         }
+        else if (arg == "--time-scale" && i + 1 < argc) realTimeConfig.timeScale = std::atof(argv[++i]);
+        else if (arg == "--fail-on-overrun") realTimeConfig.failOnOverrun = true;
+        else if (arg == "--rt-priority") realTimeConfig.realtimePriority = true;
+        else if (arg == "--guidance-divider" && i + 1 < argc) guidanceDivider = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        else trajectoryPath = arg;
+    }
 
-        // --- 定义航向剖面 (S型转弯) ---
-        // 30-60秒: 右转90度
-        // 60-90秒: 左转90度回到原航向
-        if (t > 30.0 && t <= 60.0) {
-            double turn_progress = (t - 30.0) / 30.0;
-            p.headingDeg = turn_progress * 90.0;
-        } else if (t > 60.0 && t <= 90.0) {
-            double turn_progress = (t - 60.0) / 30.0;
-            p.headingDeg = 90.0 - turn_progress * 90.0;
-        } else if (t > 90.0) {
-            p.headingDeg = 0.0;
-        } else {
-            p.headingDeg = 0.0;
+    // --- 机型参数: 构造时载入 ---
+    AirframeProfile airframe;
+    if (!airframeName.empty()) {
+        std::vector<AirframeProfile> airframes;
+        std::string error;
+        if (!loadAirframeProfiles(airframesPath, airframes, error)) {
+            std::cerr << "Error: " << error << std::endl;
+            return 1;
         }
-
-        // --- 通过积分计算位置 ---
-        // (为了简化，这里只积分前一个点的位置，实际样条曲线会更复杂)
-        if (!trajectory.empty()) {
-            const TrajectoryPoint& last_p = trajectory.back();
-            double avg_vel_mps = (last_p.velocityKts + p.velocityKts) / 2.0 * (1852.0 / 3600.0);
-            double avg_hdg_rad = (last_p.headingDeg + p.headingDeg) / 2.0 * oe_base::angle::D2RCC;
-            
-            p.position.set(
-                last_p.position.x() + avg_vel_mps * std::cos(avg_hdg_rad) * Ts,
-                last_p.position.y() + avg_vel_mps * std::sin(avg_hdg_rad) * Ts,
-                p.position.z() // 高度已在上面定义
-            );
+        const AirframeProfile* found = findAirframe(airframes, airframeName);
+        if (found == nullptr) {
+            std::cerr << "Error: airframe " << airframeName << " not found in " << airframesPath << std::endl;
+            return 1;
         }
-
-        trajectory.push_back(p);
+        airframe = *found;
+    }
+    StandaloneLaeroModel aircraft(airframe);
+
+    // --- 场景内存: 生成的轨迹和日志缓冲区在仿真开始前一次分配, 仿真循环中不再分配堆内存 ---
+    const size_t ringCapacity = 65536;
+    const size_t blockCapacity = 4096;
+    ScenarioArena arena((trajectoryPath.empty() ? ScenarioArena::bytesFor<TrajectoryPoint>(maneuverTrajectorySize()) : 0)
+                        + StateLogger::bufferBytes(ringCapacity, blockCapacity));
+
+    // --- 轨迹: 给出 .ltrj 文件时以内存映射方式加载 (零拷贝), 否则现场生成 ---
+    std::pmr::vector<TrajectoryPoint> generatedTrajectory(&arena);
+    MappedTrajectoryFile trajectoryFile;
+    TrajectorySpan trajectory;
+    double sampleTime = 0.0; // 0 表示由 TrajectoryTrack 自动检测
+    if (!trajectoryPath.empty()) {
+        if (!trajectoryFile.open(trajectoryPath)) {
+            std::cerr << "Error: " << trajectoryFile.lastError() << std::endl;
+            return 1;
+        }
+        trajectory = trajectoryFile.trajectory(0);
+        sampleTime = trajectoryFile.sampleTime(0);
+    } else {
+        generatedTrajectory = createManeuverTrajectory(&arena);
+        trajectory = generatedTrajectory;
     }
-    return trajectory;
-}
-
-int main() {
-    StandaloneLaeroModel aircraft;
-    std::vector<TrajectoryPoint> trajectory = createManeuverTrajectory();
 
     // --- 初始化飞机状态，使其与轨迹起点完全一致 ---
     if (trajectory.empty()) {
         std::cerr << "Error: Trajectory is empty." << std::endl;
         return 1;
     }
-    const TrajectoryPoint& startPoint = trajectory.front();
-    AircraftState initialState;
-    initialState.position = startPoint.position;
-    initialState.yaw = startPoint.headingDeg * oe_base::angle::D2RCC;
-    double startVelMps = startPoint.velocityKts * (1852.0 / 3600.0);
-    initialState.bodyVelocity.set(startVelMps, 0, 0);
-    initialState.velocity.set(startVelMps * std::cos(initialState.yaw), startVelMps * std::sin(initialState.yaw), 0);
-    aircraft.setInitialState(initialState);
+    aircraft.setInitialState(trackingStartState(trajectory.front()));
     
-    // --- 打开输出文件并写入文件头 ---
-    std::ofstream outputFile("maneuver_log.csv");
-    if (!outputFile.is_open()) {
+    // --- 打开二进制日志 (后台线程写盘, 仿真线程不等待I/O) ---
+    StateLogger logger(ringCapacity, blockCapacity, &arena);
+    if (!logger.open("maneuver_log.bin", LOG_LAYOUT_MANEUVER)) {
         std::cerr << "Error: Could not open output file." << std::endl;
         return 1;
     }
-    outputFile << "Time,PosX,PosY,Alt,Roll,Pitch,Yaw,VelKts,"
-               << "TargetPosX,TargetPosY,TargetAlt,TargetHdg,TargetVelKts,"
-               << "ErrorDist,ErrorAlt,ErrorHdg,ErrorVel\n";
     
+    // --- 共享内存发布 (可选) ---
+    SharedStatePublisher publisher;
+    if (!shmName.empty()) {
+        if (!publisher.create(shmName, 1)) {
+            std::cerr << "Error: " << publisher.lastError() << std::endl;
+            return 1;
+        }
+        std::cout << "Publishing state to shared memory " << shmName << std::endl;
+    }
+
     std::cout << "Simulation Started. Following maneuver trajectory..." << std::endl;
-    std::cout << "Data will be saved to maneuver_log.csv" << std::endl;
+    std::cout << "Data will be saved to maneuver_log.bin" << std::endl;
     
-    // --- 仿真循环 ---
+    // --- 仿真循环: 插值期望轨迹 -> 下达指令 -> 更新动力学 -> 记录误差 ---
     const double dt = 1.0 / 60.0; // 仿真步长
-    size_t trajectoryIndex = 0;
-    
-    for (double simTime = 0.0; simTime <= trajectory.back().timestamp; simTime += dt) {
-        // --- 时间同步的轨迹跟随逻辑 ---
-        // 1. 查找与当前仿真时间对应的期望轨迹点
-        while (trajectoryIndex < trajectory.size() - 1 && trajectory[trajectoryIndex].timestamp < simTime) {
-            trajectoryIndex++;
-        }
-        const TrajectoryPoint& targetPoint = trajectory[trajectoryIndex];
-
-        // 2. 从期望轨迹点获取控制指令
-        double commandedAltitude = -targetPoint.position.z();
-        double commandedVelocity = targetPoint.velocityKts;
-        double commandedHeading = targetPoint.headingDeg;
-
-        // 3. 发送控制指令给飞机模型
-        aircraft.setCommandedAltitude(commandedAltitude);
-        aircraft.setCommandedVelocityKts(commandedVelocity);
-        aircraft.setCommandedHeadingD(commandedHeading);
-        
-        // --- 更新动力学 ---
-        aircraft.update(dt);
-
-        // --- 计算误差 ---
-        const AircraftState& currentState = aircraft.getState();
-        const oe_base::Vec3d posErrorVec(
-            currentState.position.x() - targetPoint.position.x(),
-            currentState.position.y() - targetPoint.position.y(),
-            currentState.position.z() - targetPoint.position.z()
-        );
-        double errorDist = posErrorVec.length();
-        double currentAlt = -currentState.position.z();
-        double errorAlt = currentAlt - commandedAltitude;
-        double currentHdg = oe_base::aepcdDeg(currentState.yaw * oe_base::angle::R2DCC);
-        double errorHdg = oe_base::aepcdDeg(currentHdg - commandedHeading);
-        double currentKts = currentState.bodyVelocity.length() * (3600.0 / 1852.0);
-        double errorVel = currentKts - commandedVelocity;
-
-        // --- 写入数据到文件 ---
-        outputFile << std::fixed << std::setprecision(4)
-                   << simTime << ","
-                   << currentState.position.x() << "," << currentState.position.y() << "," << currentAlt << ","
-                   << currentState.roll * oe_base::angle::R2DCC << "," << currentState.pitch * oe_base::angle::R2DCC << "," << currentHdg << ","
-                   << currentKts << ","
-                   << targetPoint.position.x() << "," << targetPoint.position.y() << "," << commandedAltitude << ","
-                   << commandedHeading << "," << commandedVelocity << ","
-                   << errorDist << "," << errorAlt << "," << errorHdg << "," << errorVel
-                   << "\n";
+    const TrajectoryTrack track(trajectory, sampleTime);
+    TrackingAnalytics analytics;
+    const bool analyze = !summaryPath.empty();
+    if (analyze) analytics.reserve();
+    auto sink = [&logger, &publisher, &aircraft, &analytics, analyze](const StateLogRecord& record) {
+        logger.log(record);
+        publisher.publish(record.time, &aircraft.getState(), 1);
+        if (analyze) analytics.add(record);
+    };
+    bool realTimeOk = true;
+    if (realTime) {
+        // 锁定墙钟: 每帧在绝对截止时刻推进一步, 结果与非实时运行相同 (drop 策略丢帧时除外)
+        realTimeConfig.dt = dt;
+        RealTimeRunner runner(realTimeConfig);
+        TrackingLoop<StandaloneLaeroModel> loop(aircraft, track, guidanceDivider);
+        realTimeOk = runner.run(track.endTime(), [&loop, &sink](double simTime, double stepDt) {
+            sink(loop.step(simTime, stepDt));
+            return true;
+        });
+        runner.writeTelemetry(std::cout);
+    } else {
+        runTrackingScenario(aircraft, track, dt, guidanceDivider, sink);
     }
 
-    outputFile.close();
-    std::cout << "Simulation Finished. Log file 'maneuver_log.csv' has been saved." << std::endl;
+    logger.close();
+    if (logger.droppedCount() > 0) {
+        std::cerr << "Warning: " << logger.droppedCount() << " log records were dropped." << std::endl;
+    }
+    if (arena.overflowCount() > 0) {
+        std::cerr << "Warning: scenario arena overflowed (" << arena.overflowBytes() << " bytes from the heap)." << std::endl;
+    }
+    std::cout << "Simulation Finished. Log file 'maneuver_log.bin' has been saved." << std::endl;
+#ifdef LAERO_TRAP_ALLOCATIONS
+    std::cout << "Allocation guard: " << laero_alloc::trappedCount() << " heap allocations inside the simulation loop" << std::endl;
+#endif
+
+    if (analyze) {
+        analytics.finish();
+        std::ofstream summary(summaryPath);
+        const bool csv = summaryPath.size() >= 4 && summaryPath.compare(summaryPath.size() - 4, 4, ".csv") == 0;
+        if (csv) analytics.writeCsv(summary);
+        else analytics.writeJson(summary);
+        if (!summary) {
+            std::cerr << "Error: Could not write " << summaryPath << std::endl;
+            return 1;
+        }
+        std::cout << "Tracking summary written to " << summaryPath << " (ErrorDist RMS " << analytics.dist().stats.rms()
+                  << " m, p95 " << analytics.dist().percentile(0.95) << " m)" << std::endl;
+    }
+#ifdef LAERO_ENABLE_PROFILING
+    laero_profile::dumpSummary(std::cout);
+#endif
 
+    if (!realTimeOk) {
+        std::cerr << "Error: real-time deadline missed." << std::endl;
+        return 2;
+    }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,1130 @@
+// main_bench.cpp
+// 编译指令: g++ -O2 main_bench.cpp StandaloneLaeroModel.cpp StandaloneRacModel/StandaloneRacModel.cpp LaeroFleet.cpp LaeroSimd.cpp LodFleet.cpp Snapshot.cpp
+//           SpatialIndex.cpp FleetScheduler.cpp Trajectory.cpp TrajectoryTrack.cpp TrajectorySynth.cpp StateLogger.cpp TrackingAnalytics.cpp ScenarioScript.cpp
+//           AllocationGuard.cpp -o Bench -std=c++17 -I. -IStandaloneRacModel -pthread
+//
+// 用法: ./Bench [--filter 子串] [--min-time 秒] [--json 输出文件] [--check]
+//
+// 性能基准: 每个用例自动标定迭代次数, 报告 ns/step、steps/s 和每次迭代的堆分配次数 (AllocationGuard 计数),
+// 并可输出JSON, 便于在版本之间比较性能回退。会丢弃部分步的用例 (日志缓冲区满) 只按接受的步计算吞吐, 另报告丢弃数。--check 只检查 OeBase 数学函数的误差上界, 失败时返回非零。
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StandaloneLaeroModel.hpp"
+#include "StandaloneRacModel.hpp"
+#include "LaeroFleet.hpp"
+#include "LaeroSimd.hpp"
+#include "FleetScheduler.hpp"
+#include "ModelFleet.hpp"
+#include "LodFleet.hpp"
+#include "ScenarioScript.hpp"
+#include "Snapshot.hpp"
+#include "SpatialIndex.hpp"
+#include "Trajectory.hpp"
+#include "TrajectoryTrack.hpp"
+#include "TrajectorySynth.hpp"
+#include "StateLogger.hpp"
+#include "TrackingAnalytics.hpp"
+#include "AllocationGuard.hpp"
+
+namespace {
+
+// ==============================================================
+// 基准框架
+// ==============================================================
+
+// 执行 iterations 次迭代
+typedef std::function<void(size_t iterations)> BenchRunner;
+
+struct BenchCase {
+    std::string name;
+    double stepsPerIteration = 1.0;             // 每次迭代包含的"步" (单机步长, 或机队中的飞机步长)
+    std::function<BenchRunner()> setup;         // 准备数据 (不计时), 返回被测函数
+    // 被测函数可能丢弃部分步 (如日志缓冲区满) 时, 由被测函数写入累计丢弃的步数; 吞吐只按接受的步计算
+    std::shared_ptr<uint64_t> droppedSteps;
+};
+
+struct BenchResult {
+    std::string name;
+    size_t iterations = 0;
+    double seconds = 0.0;
+    double nsPerStep = 0.0;
+    double stepsPerSecond = 0.0;
+    double allocsPerIteration = 0.0;
+    double allocsPerStep = 0.0;
+    uint64_t droppedSteps = 0;      // 最后一次计时中丢弃的步数
+};
+
+double elapsedSeconds(const BenchCase& bc, const BenchRunner& run, size_t iterations,
+                      unsigned long long& allocs, uint64_t& dropped) {
+    const unsigned long long allocsBefore = laero_alloc::allocationCount();
+    const uint64_t droppedBefore = bc.droppedSteps ? *bc.droppedSteps : 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    run(iterations);
+    const auto t1 = std::chrono::steady_clock::now();
+    allocs = laero_alloc::allocationCount() - allocsBefore;
+    dropped = bc.droppedSteps ? *bc.droppedSteps - droppedBefore : 0;
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+BenchResult runCase(const BenchCase& bc, double minTime) {
+    BenchRunner run = bc.setup();
+
+    // --- 标定迭代次数 ---
+    size_t iterations = 1;
+    unsigned long long allocs = 0;
+    uint64_t dropped = 0;
+    double seconds = elapsedSeconds(bc, run, iterations, allocs, dropped);
+    while (seconds < minTime / 10.0 && iterations < (size_t(1) << 40)) {
+        iterations *= 2;
+        seconds = elapsedSeconds(bc, run, iterations, allocs, dropped);
+    }
+    if (seconds < minTime) {
+        const double scale = (seconds > 0.0) ? minTime / seconds : 10.0;
+        iterations = static_cast<size_t>(iterations * scale) + 1;
+        seconds = elapsedSeconds(bc, run, iterations, allocs, dropped);
+    }
+
+    BenchResult r;
+    r.name = bc.name;
+    r.iterations = iterations;
+    r.seconds = seconds;
+    r.droppedSteps = dropped;
+    const double steps = bc.stepsPerIteration * iterations;
+    const double accepted = std::max(steps - static_cast<double>(dropped), 1.0);
+    r.nsPerStep = seconds * 1.0e9 / accepted;
+    r.stepsPerSecond = accepted / seconds;
+    r.allocsPerIteration = static_cast<double>(allocs) / iterations;
+    r.allocsPerStep = static_cast<double>(allocs) / steps;
+    return r;
+}
+
+// ==============================================================
+// 公共场景
+// ==============================================================
+const double DT = 1.0 / 60.0;
+
+AircraftState startState(const TrajectoryPoint& p) {
+    AircraftState s;
+    s.position = p.position;
+    s.yaw = p.headingDeg * oe_base::angle::D2RCC;
+    const double velMps = p.velocityKts * oe_base::units::KTS2MPS;
+    s.bodyVelocity.set(velMps, 0, 0);
+    s.velocity.set(velMps * std::cos(s.yaw), velMps * std::sin(s.yaw), 0);
+    return s;
+}
+
+// 机队中第i架飞机的初始状态与指令 (分散开, 避免所有飞机走同一分支)
+AircraftState fleetState(size_t i) {
+    AircraftState s;
+    s.position.set(100.0 * (i % 1000), 100.0 * (i / 1000), -2000.0 - (i % 37) * 10.0);
+    s.yaw = oe_base::aepcdRad(0.01 * i);
+    s.bodyVelocity.set(120.0 + (i % 50), 0, 0);
+    return s;
+}
+
+// 3000 km x 3000 km 空域内随机分布的机队 (高度 1000~12000 米, 速度 250 m/s, 航向随机)
+std::vector<AircraftState> airspaceStates(size_t count) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> pos(0.0, 3.0e6);
+    std::uniform_real_distribution<double> alt(1000.0, 12000.0);
+    std::uniform_real_distribution<double> hdg(-oe_base::PI, oe_base::PI);
+    std::uniform_real_distribution<double> climb(-10.0, 10.0);
+    std::vector<AircraftState> states(count);
+    for (AircraftState& s : states) {
+        s.position.set(pos(rng), pos(rng), -alt(rng));
+        s.yaw = hdg(rng);
+        s.velocity.set(250.0 * std::cos(s.yaw), 250.0 * std::sin(s.yaw), climb(rng));
+    }
+    return states;
+}
+
+// 按速度推进一帧 (空间索引用例)
+void moveStates(std::vector<AircraftState>& states, double dt) {
+    for (AircraftState& s : states) {
+        s.position = s.position + oe_base::Vec3d(s.velocity.x() * dt, s.velocity.y() * dt, s.velocity.z() * dt);
+    }
+}
+
+double fleetAltCmd(size_t i) { return 3000.0 + (i % 100) * 10.0; }
+double fleetVelCmd(size_t i) { return 250.0 + (i % 60); }
+double fleetHdgCmd(size_t i) { return oe_base::aepcdDeg(45.0 + i * 7.0); }
+
+// --- 完整的轨迹跟踪运行 (与 main.cpp 相同, 不写日志) ---
+size_t runManeuver(double& checksum) {
+    std::vector<TrajectoryPoint> trajectory = createManeuverTrajectory();
+    const TrajectoryTrack track(trajectory);
+    TrajectoryTrack::Cursor cursor;
+
+    StandaloneLaeroModel aircraft;
+    aircraft.setInitialState(startState(trajectory.front()));
+
+    size_t steps = 0;
+    for (double simTime = 0.0; simTime <= trajectory.back().timestamp; simTime += DT) {
+        const TrajectorySample target = track.sample(simTime, cursor);
+        aircraft.setCommandedAltitude(-target.position.z());
+        aircraft.setCommandedVelocityKts(target.velocityKts);
+        aircraft.setCommandedHeadingD(target.headingDeg);
+        aircraft.update(DT);
+        ++steps;
+    }
+    checksum += aircraft.getState().position.x();
+    return steps;
+}
+
+volatile double g_sink = 0.0;
+
+// ==============================================================
+// 数学函数: 原来的循环回绕 (对照) 与误差上界检查
+// ==============================================================
+double loopAepcdRad(double angle) {
+    while (angle > oe_base::PI) angle -= 2.0 * oe_base::PI;
+    while (angle < -oe_base::PI) angle += 2.0 * oe_base::PI;
+    return angle;
+}
+
+// 大多在区间内, 每16个中有一个超出数十圈 (模拟异常指令或大步长)
+template<class T>
+std::vector<T> angleInputs(size_t n) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> inRange(-4.0, 4.0);
+    std::uniform_real_distribution<double> far(-200.0, 200.0);
+    std::vector<T> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = T((i % 16 == 15) ? far(rng) : inRange(rng));
+    return x;
+}
+
+struct CheckResult {
+    double maxErr = 0.0;
+    size_t failures = 0;
+};
+
+void printCheck(const char* name, const CheckResult& r, double bound, bool& ok) {
+    const bool pass = (r.failures == 0);
+    std::printf("%-36s %14.3e %14.3e  %s\n", name, r.maxErr, bound, pass ? "PASS" : "FAIL");
+    if (!pass) ok = false;
+}
+
+// 回绕结果与 std::remainder 参考值的角度差 (按周期取模), 并检查结果落在 [-period/2, period/2]
+template<class T, class Wrap>
+CheckResult checkWrap(Wrap wrap, double period, double span, double relBound, size_t n) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> dist(-span, span);
+    CheckResult r;
+    for (size_t i = 0; i < n; ++i) {
+        const T x = T(dist(rng));
+        const T y = wrap(x);
+        const double p = double(T(period));
+        const double err = std::fabs(std::remainder(double(y) - std::remainder(double(x), p), p));
+        const double bound = relBound * (std::fabs(double(x)) + p);
+        r.maxErr = std::max(r.maxErr, err);
+        if (err > bound || double(y) > 0.5 * p || double(y) < -0.5 * p) ++r.failures;
+    }
+    return r;
+}
+
+template<class T>
+CheckResult checkSinCos(size_t n) {
+    typedef oe_base::SinCosConstants<T> K;
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> wide(-double(K::MAX_ARG), double(K::MAX_ARG));
+    std::uniform_real_distribution<double> near(-2.0 * oe_base::PI, 2.0 * oe_base::PI);
+    CheckResult r;
+    for (size_t i = 0; i < n; ++i) {
+        const T x = T((i & 1) ? wide(rng) : near(rng));
+        T s, c;
+        oe_base::fastSinCos(x, s, c);
+        const double err = std::max(std::fabs(double(s) - std::sin(double(x))), std::fabs(double(c) - std::cos(double(x))));
+        r.maxErr = std::max(r.maxErr, err);
+        if (err > double(K::TOLERANCE)) ++r.failures;
+    }
+    return r;
+}
+
+// 当前级别的向量 sincos 与 std::sin/std::cos 的绝对误差; relBound > 0 时上界按 |x| 放宽 (超出精度区间的大输入)
+CheckResult checkSimdSinCos(double span, double absBound, double relBound, size_t n) {
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> dist(-span, span);
+    std::vector<double> x(n), s(n), c(n);
+    for (size_t i = 0; i < n; ++i) x[i] = dist(rng);
+    laero_simd::sincos(x.data(), s.data(), c.data(), n);
+    CheckResult r;
+    for (size_t i = 0; i < n; ++i) {
+        const double err = std::max(std::fabs(s[i] - std::sin(x[i])), std::fabs(c[i] - std::cos(x[i])));
+        r.maxErr = std::max(r.maxErr, err);
+        if (!(err <= absBound + relBound * std::fabs(x[i]))) ++r.failures;
+    }
+    return r;
+}
+
+// 当前级别的向量运动方程内核与标量路径 (oe_base::aepcdRad) 对大角度 phi/psi 的回绕之差 (按周期取模), 并检查落在 [-PI, PI]
+CheckResult checkSimdWrap(double span, double relBound, size_t n) {
+    std::mt19937 rng(19);
+    std::uniform_real_distribution<double> dist(-span, span);
+    std::vector<double> input(n);
+    for (size_t i = 0; i < n; ++i) input[i] = dist(rng);
+
+    // 角速度和机体速度全为零: 一步后 phi/psi 只是输入的回绕
+    std::vector<double> zero(n, 0.0), out(n);
+    std::vector<double> cols[2][6];
+    laero_simd::EomColumns c[2];
+    for (int k = 0; k < 2; ++k) {
+        for (int j = 0; j < 6; ++j) cols[k][j].assign(n, 0.0);
+        cols[k][0] = input;
+        cols[k][2] = input;
+        c[k].count = n;
+        c[k].phi = cols[k][0].data(); c[k].tht = cols[k][1].data(); c[k].psi = cols[k][2].data();
+        c[k].u = cols[k][3].data(); c[k].v = cols[k][4].data(); c[k].w = cols[k][5].data();
+        c[k].phiDot = c[k].thtDot = c[k].psiDot = c[k].uDot = c[k].vDot = c[k].wDot = zero.data();
+        c[k].phiDot1 = c[k].thtDot1 = c[k].psiDot1 = c[k].uDot1 = c[k].vDot1 = c[k].wDot1 = out.data();
+        c[k].bodyU = c[k].bodyV = c[k].bodyW = c[k].p = c[k].q = c[k].r = out.data();
+        c[k].velN = c[k].velE = c[k].velD = c[k].posX = c[k].posY = c[k].posZ = out.data();
+    }
+    laero_simd::eomStep(c[0], DT);
+    laero_simd::eomStepScalar(c[1], DT, 0, n);
+
+    CheckResult r;
+    const double twoPi = 2.0 * oe_base::PI;
+    for (size_t i = 0; i < n; ++i) {
+        const double bound = relBound * (std::fabs(input[i]) + twoPi);
+        const double simd[2] = {c[0].phi[i], c[0].psi[i]};
+        const double scalar[2] = {c[1].phi[i], c[1].psi[i]};
+        for (int j = 0; j < 2; ++j) {
+            const double err = std::fabs(std::remainder(simd[j] - scalar[j], twoPi));
+            r.maxErr = std::max(r.maxErr, err);
+            if (!(err <= bound) || simd[j] > oe_base::PI || simd[j] < -oe_base::PI) ++r.failures;
+        }
+    }
+    return r;
+}
+
+// --check: 各数学函数的误差上界, 全部通过返回 true
+bool runMathChecks() {
+    const size_t N = 1000000;
+    const double EPS = std::numeric_limits<double>::epsilon();
+    const double EPSF = std::numeric_limits<float>::epsilon();
+    bool ok = true;
+
+    std::printf("%-36s %14s %14s\n", "Check", "max error", "bound");
+
+    // 区间内原样返回, 单圈回绕与循环版本逐位相同
+    {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> inRange(-oe_base::PI, oe_base::PI);
+        std::uniform_real_distribution<double> oneTurn(-3.0 * oe_base::PI, 3.0 * oe_base::PI);
+        CheckResult identity, exact;
+        const double edges[] = {0.0, -0.0, oe_base::PI, -oe_base::PI};
+        for (double x : edges) {
+            if (oe_base::aepcdRad(x) != x || std::signbit(oe_base::aepcdRad(x)) != std::signbit(x)) ++identity.failures;
+        }
+        for (size_t i = 0; i < N; ++i) {
+            const double x = inRange(rng);
+            if (oe_base::aepcdRad(x) != x) ++identity.failures;
+            const double y = oneTurn(rng);
+            const double err = std::fabs(oe_base::aepcdRad(y) - loopAepcdRad(y));
+            exact.maxErr = std::max(exact.maxErr, err);
+            if (err != 0.0) ++exact.failures;
+        }
+        printCheck("aepcdRad/in_range_identity", identity, 0.0, ok);
+        printCheck("aepcdRad/one_turn_vs_loop", exact, 0.0, ok);
+    }
+
+    printCheck("aepcdRad/range_1e6", checkWrap<double>([](double x) { return oe_base::aepcdRad(x); },
+               2.0 * oe_base::PI, 1.0e6, 2.0 * EPS, N), 2.0 * EPS * (1.0e6 + 2.0 * oe_base::PI), ok);
+    printCheck("aepcdRad/range_1e12", checkWrap<double>([](double x) { return oe_base::aepcdRad(x); },
+               2.0 * oe_base::PI, 1.0e12, 2.0 * EPS, N), 2.0 * EPS * (1.0e12 + 2.0 * oe_base::PI), ok);
+    printCheck("aepcdDeg/range_1e8", checkWrap<double>([](double x) { return oe_base::aepcdDeg(x); },
+               360.0, 1.0e8, 2.0 * EPS, N), 2.0 * EPS * (1.0e8 + 360.0), ok);
+    printCheck("aepcdRad_f32/range_1e4", checkWrap<float>([](float x) { return oe_base::aepcdRad(x); },
+               2.0 * oe_base::PI, 1.0e4, 2.0 * EPSF, N), 2.0 * EPSF * (1.0e4 + 2.0 * oe_base::PI), ok);
+    printCheck("aepcdDeg_f32/range_1e6", checkWrap<float>([](float x) { return oe_base::aepcdDeg(x); },
+               360.0, 1.0e6, 2.0 * EPSF, N), 2.0 * EPSF * (1.0e6 + 360.0), ok);
+
+    printCheck("fastSinCos/abs_error", checkSinCos<double>(N), oe_base::SinCosConstants<double>::TOLERANCE, ok);
+    printCheck("fastSinCos_f32/abs_error", checkSinCos<float>(N), oe_base::SinCosConstants<float>::TOLERANCE, ok);
+
+    // 向量路径与标量路径: 各指令集级别分别检查 (SINCOS_TOLERANCE 的适用区间内, 以及远超出该区间的输入)
+    {
+        const laero_simd::SimdLevel saved = laero_simd::activeLevel();
+        for (int level = laero_simd::SSE2; level <= laero_simd::detectLevel(); ++level) {
+            laero_simd::setLevel(static_cast<laero_simd::SimdLevel>(level));
+            const std::string prefix = std::string("simd_") + laero_simd::levelName(laero_simd::activeLevel());
+            printCheck((prefix + "/sincos_1e4").c_str(), checkSimdSinCos(1.0e4, laero_simd::SINCOS_TOLERANCE, 0.0, N),
+                       laero_simd::SINCOS_TOLERANCE, ok);
+            printCheck((prefix + "/sincos_1e12").c_str(), checkSimdSinCos(1.0e12, laero_simd::SINCOS_TOLERANCE, 2.0 * EPS, N),
+                       laero_simd::SINCOS_TOLERANCE + 2.0 * EPS * 1.0e12, ok);
+            printCheck((prefix + "/wrap_1e12").c_str(), checkSimdWrap(1.0e12, 4.0 * EPS, N),
+                       4.0 * EPS * (1.0e12 + 2.0 * oe_base::PI), ok);
+        }
+        laero_simd::setLevel(saved);
+    }
+
+    {
+        CheckResult units;
+        units.maxErr = std::fabs(oe_base::units::KTS2MPS * oe_base::units::MPS2KTS - 1.0);
+        units.failures = (units.maxErr > EPS) ? 1 : 0;
+        printCheck("units/kts_mps_roundtrip", units, EPS, ok);
+    }
+
+    std::printf("%s\n", ok ? "All checks passed" : "Some checks FAILED");
+    return ok;
+}
+
+// ==============================================================
+// 用例
+// ==============================================================
+std::vector<BenchCase> registerCases() {
+    std::vector<BenchCase> cases;
+
+    // --- 单机步长 ---
+    {
+        BenchCase bc;
+        bc.name = "laero/single_step";
+        bc.setup = [] {
+            std::shared_ptr<StandaloneLaeroModel> m = std::make_shared<StandaloneLaeroModel>();
+            m->setInitialState(fleetState(1));
+            return BenchRunner([m](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    m->setCommandedAltitude(3000.0);
+                    m->setCommandedVelocityKts(300.0);
+                    m->setCommandedHeadingD((k & 4096) ? 90.0 : -90.0);
+                    m->update(DT);
+                }
+                g_sink = m->getState().position.x();
+            });
+        };
+        cases.push_back(bc);
+    }
+    {
+        BenchCase bc;
+        bc.name = "rac/single_step";
+        bc.setup = [] {
+            std::shared_ptr<StandaloneRacModel> m = std::make_shared<StandaloneRacModel>();
+            m->setInitialState(fleetState(1));
+            return BenchRunner([m](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    m->setCommandedAltitude(3000.0);
+                    m->setCommandedVelocityKts(300.0);
+                    m->setCommandedHeadingD((k & 4096) ? 90.0 : -90.0);
+                    m->update(DT);
+                }
+                g_sink = m->getState().position.x();
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    // --- 快进: 1小时, 每10分钟改变一次航向和高度指令 ---
+    {
+        BenchCase bc;
+        bc.name = "laero/fast_forward_1h";
+        bc.stepsPerIteration = 3600.0 / DT;
+        bc.setup = [] {
+            return BenchRunner([](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    StandaloneLaeroModel m;
+                    m.setInitialState(fleetState(1));
+                    for (int leg = 0; leg < 6; ++leg) {
+                        m.setCommandedHeadingD(fleetHdgCmd(leg));
+                        m.setCommandedAltitude(fleetAltCmd(leg * 17));
+                        m.setCommandedVelocityKts(fleetVelCmd(leg));
+                        m.fastForward(600.0, DT);
+                    }
+                    g_sink = m.getState().position.x();
+                }
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    // --- 机队步长 ---
+    const size_t fleetSizes[] = { 1000, 10000, 100000 };
+    for (size_t count : fleetSizes) {
+        BenchCase bc;
+        bc.name = "laero/fleet_soa/" + std::to_string(count);
+        bc.stepsPerIteration = static_cast<double>(count);
+        bc.setup = [count] {
+            std::shared_ptr<LaeroFleet> fleet = std::make_shared<LaeroFleet>();
+            fleet->reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                fleet->addAircraft(fleetState(i));
+                fleet->setCommandedAltitude(i, fleetAltCmd(i));
+                fleet->setCommandedVelocityKts(i, fleetVelCmd(i));
+                fleet->setCommandedHeadingD(i, fleetHdgCmd(i));
+            }
+            return BenchRunner([fleet](size_t n) {
+                for (size_t k = 0; k < n; ++k) fleet->update(DT);
+                g_sink = fleet->column(LaeroFleet::POS_X)[0];
+            });
+        };
+        cases.push_back(bc);
+    }
+    // 每步重新下达指令: 逐架三次 setCommanded* / 批量数组 / 制导分频 (每6步, 即0.1 s 一次)
+    {
+        const size_t count = 100000;
+        struct CommandCase { const char* name; int mode; };
+        const CommandCase commandCases[] = {
+            { "laero/fleet_soa_cmd_percall/100000", 0 },
+            { "laero/fleet_soa_cmd_batch/100000", 1 },
+            { "laero/fleet_soa_cmd_guidance6/100000", 2 },
+        };
+        for (const CommandCase& cc : commandCases) {
+            BenchCase bc;
+            bc.name = cc.name;
+            bc.stepsPerIteration = static_cast<double>(count);
+            const int mode = cc.mode;
+            bc.setup = [count, mode] {
+                struct Commands { std::vector<double> alt, vel, hdg; };
+                std::shared_ptr<LaeroFleet> fleet = std::make_shared<LaeroFleet>();
+                std::shared_ptr<Commands> cmds = std::make_shared<Commands>();
+                fleet->reserve(count);
+                for (size_t i = 0; i < count; ++i) {
+                    fleet->addAircraft(fleetState(i));
+                    cmds->alt.push_back(fleetAltCmd(i));
+                    cmds->vel.push_back(fleetVelCmd(i));
+                    cmds->hdg.push_back(fleetHdgCmd(i));
+                }
+                if (mode == 2) fleet->setGuidanceDivider(6);
+                return BenchRunner([fleet, cmds, mode, count](size_t n) {
+                    for (size_t k = 0; k < n; ++k) {
+                        if (mode == 0) {
+                            for (size_t i = 0; i < count; ++i) {
+                                fleet->setCommandedAltitude(i, cmds->alt[i]);
+                                fleet->setCommandedVelocityKts(i, cmds->vel[i]);
+                                fleet->setCommandedHeadingD(i, cmds->hdg[i]);
+                            }
+                        } else if (fleet->guidanceDue()) {
+                            fleet->setCommands(cmds->alt.data(), cmds->vel.data(), cmds->hdg.data());
+                        }
+                        fleet->update(DT);
+                    }
+                    g_sink = fleet->column(LaeroFleet::POS_X)[0];
+                });
+            };
+            cases.push_back(bc);
+        }
+    }
+
+    for (size_t count : fleetSizes) {
+        BenchCase bc;
+        bc.name = "laero/fleet_scheduler/" + std::to_string(count);
+        bc.stepsPerIteration = static_cast<double>(count);
+        bc.setup = [count] {
+            std::shared_ptr<FleetScheduler> scheduler = std::make_shared<FleetScheduler>();
+            std::shared_ptr<std::vector<StandaloneLaeroModel>> models = std::make_shared<std::vector<StandaloneLaeroModel>>(count);
+            for (size_t i = 0; i < count; ++i) (*models)[i].setInitialState(fleetState(i));
+            return BenchRunner([scheduler, models](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    scheduler->stepFrame(*models, DT, [](size_t i, StandaloneLaeroModel& m) {
+                        m.setCommandedAltitude(fleetAltCmd(i));
+                        m.setCommandedVelocityKts(fleetVelCmd(i));
+                        m.setCommandedHeadingD(fleetHdgCmd(i));
+                    });
+                }
+                g_sink = (*models)[0].getState().position.x();
+            });
+        };
+        cases.push_back(bc);
+    }
+    for (size_t count : fleetSizes) {
+        BenchCase bc;
+        bc.name = "laero_f32/fleet_scheduler/" + std::to_string(count);
+        bc.stepsPerIteration = static_cast<double>(count);
+        bc.setup = [count] {
+            std::shared_ptr<FleetScheduler> scheduler = std::make_shared<FleetScheduler>();
+            std::shared_ptr<std::vector<StandaloneLaeroModelF>> models = std::make_shared<std::vector<StandaloneLaeroModelF>>(count);
+            for (size_t i = 0; i < count; ++i) (*models)[i].setInitialState(stateCast<float>(fleetState(i)));
+            return BenchRunner([scheduler, models](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    scheduler->stepFrame(*models, DT, [](size_t i, StandaloneLaeroModelF& m) {
+                        m.setCommandedAltitude(fleetAltCmd(i));
+                        m.setCommandedVelocityKts(fleetVelCmd(i));
+                        m.setCommandedHeadingD(fleetHdgCmd(i));
+                    });
+                }
+                g_sink = (*models)[0].getState().position.x();
+            });
+        };
+        cases.push_back(bc);
+    }
+    for (size_t count : fleetSizes) {
+        BenchCase bc;
+        bc.name = "rac/fleet_scheduler/" + std::to_string(count);
+        bc.stepsPerIteration = static_cast<double>(count);
+        bc.setup = [count] {
+            std::shared_ptr<FleetScheduler> scheduler = std::make_shared<FleetScheduler>();
+            std::shared_ptr<std::vector<StandaloneRacModel>> models = std::make_shared<std::vector<StandaloneRacModel>>(count);
+            for (size_t i = 0; i < count; ++i) {
+                (*models)[i].setInitialState(fleetState(i));
+                (*models)[i].setCommandedAltitude(fleetAltCmd(i));
+                (*models)[i].setCommandedVelocityKts(fleetVelCmd(i));
+                (*models)[i].setCommandedHeadingD(fleetHdgCmd(i));
+            }
+            return BenchRunner([scheduler, models](size_t n) {
+                for (size_t k = 0; k < n; ++k) scheduler->stepFrame(*models, DT);
+                g_sink = (*models)[0].getState().position.x();
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    // --- 混合机队: 10% LaeroModel + 90% RacModel, 每帧下达指令 ---
+    for (size_t count : fleetSizes) {
+        BenchCase bc;
+        bc.name = "mixed/fleet/" + std::to_string(count);
+        bc.stepsPerIteration = static_cast<double>(count);
+        bc.setup = [count] {
+            typedef MixedFleet<StandaloneLaeroModel, StandaloneRacModel> Fleet;
+            std::shared_ptr<Fleet> fleet = std::make_shared<Fleet>();
+            fleet->bucket<StandaloneLaeroModel>().reserve(count / 10);
+            fleet->bucket<StandaloneRacModel>().reserve(count - count / 10);
+            for (size_t i = 0; i < count; ++i) {
+                if (i % 10 == 0) fleet->add<StandaloneLaeroModel>(fleetState(i));
+                else fleet->add<StandaloneRacModel>(fleetState(i));
+            }
+            return BenchRunner([fleet](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    fleet->forEach([](Fleet::Handle h, auto& m) {
+                        FlightCommand cmd;
+                        cmd.altitudeM = fleetAltCmd(h.index);
+                        cmd.velocityKts = fleetVelCmd(h.index);
+                        cmd.headingDeg = fleetHdgCmd(h.index);
+                        m.command(cmd);
+                    });
+                    fleet->update(DT);
+                }
+                g_sink = fleet->bucket<StandaloneRacModel>()[0].getState().position.x();
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    for (size_t count : fleetSizes) {
+        BenchCase bc;
+        bc.name = "lod/fleet_policy/" + std::to_string(count);
+        bc.stepsPerIteration = static_cast<double>(count);
+        bc.setup = [count] {
+            std::shared_ptr<LodFleet> fleet = std::make_shared<LodFleet>();
+            for (size_t i = 0; i < count; ++i) fleet->addAircraft(fleetState(i), LOD_LOW);
+            // 一个关注区域 + 10%高精度预算, 每秒评估一次策略
+            std::shared_ptr<LodPolicy> policy = std::make_shared<LodPolicy>();
+            LodArea area;
+            area.radius = 20000.0;
+            policy->areas.push_back(area);
+            policy->maxHighCount = count / 10;
+            std::shared_ptr<size_t> frame = std::make_shared<size_t>(0);
+            return BenchRunner([fleet, policy, frame](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    for (size_t i = 0; i < fleet->size(); ++i) {
+                        FlightCommand cmd;
+                        cmd.altitudeM = fleetAltCmd(i);
+                        cmd.velocityKts = fleetVelCmd(i);
+                        cmd.headingDeg = fleetHdgCmd(i);
+                        fleet->command(i, cmd);
+                    }
+                    if ((*frame)++ % 50 == 0) fleet->applyPolicy(*policy);
+                    fleet->update(DT);
+                }
+                g_sink = fleet->getState(0).position.x();
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    // --- 快照与检查点 (每次迭代 = 整个机队存一个检查点) ---
+    {
+        const size_t count = 10000;
+        BenchCase bc;
+        bc.name = "snapshot/checkpoint_mixed/" + std::to_string(count);
+        bc.stepsPerIteration = static_cast<double>(count);
+        bc.setup = [count] {
+            typedef MixedFleet<StandaloneLaeroModel, StandaloneRacModel> Fleet;
+            std::shared_ptr<Fleet> fleet = std::make_shared<Fleet>();
+            for (size_t i = 0; i < count; ++i) {
+                if (i % 10 == 0) fleet->add<StandaloneLaeroModel>(fleetState(i));
+                else fleet->add<StandaloneRacModel>(fleetState(i));
+            }
+            std::shared_ptr<CheckpointHistory> history = std::make_shared<CheckpointHistory>(16, 64);
+            std::shared_ptr<SnapshotBuffer> buffer = std::make_shared<SnapshotBuffer>();
+            return BenchRunner([fleet, history, buffer](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    fleet->update(DT);
+                    saveSnapshot(*fleet, *buffer);
+                    history->push(static_cast<double>(history->size()), *buffer);
+                }
+                g_sink = static_cast<double>(history->memoryBytes());
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    // --- 空间索引: 10万架飞机, 每帧重建; 查询每次迭代 = 1次查询 ---
+    {
+        const size_t count = 100000;
+        BenchCase bc;
+        bc.name = "spatial/build/" + std::to_string(count);
+        bc.stepsPerIteration = static_cast<double>(count);
+        bc.setup = [count] {
+            std::shared_ptr<std::vector<AircraftState>> states = std::make_shared<std::vector<AircraftState>>(airspaceStates(count));
+            std::shared_ptr<SpatialIndex> index = std::make_shared<SpatialIndex>();
+            index->build(*states);
+            return BenchRunner([states, index](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    moveStates(*states, DT);
+                    index->build(*states);
+                }
+                g_sink = static_cast<double>(index->size());
+            });
+        };
+        cases.push_back(bc);
+    }
+    const double lookaheads[] = { 0.0, 60.0 };
+    for (double lookahead : lookaheads) {
+        const size_t count = 100000;
+        BenchCase bc;
+        bc.name = "spatial/conflicts_" + std::to_string(static_cast<int>(lookahead)) + "s/" + std::to_string(count);
+        bc.stepsPerIteration = static_cast<double>(count);
+        bc.setup = [count, lookahead] {
+            std::shared_ptr<SpatialIndex> index = std::make_shared<SpatialIndex>();
+            index->build(airspaceStates(count));
+            std::shared_ptr<std::vector<SpatialIndex::Conflict>> conflicts = std::make_shared<std::vector<SpatialIndex::Conflict>>();
+            SpatialIndex::ConflictParams params;
+            params.lookahead = lookahead;
+            return BenchRunner([index, conflicts, params](size_t n) {
+                for (size_t k = 0; k < n; ++k) index->findConflicts(params, *conflicts);
+                g_sink = static_cast<double>(conflicts->size());
+            });
+        };
+        cases.push_back(bc);
+    }
+    {
+        BenchCase bc;
+        bc.name = "spatial/nearest_8";
+        bc.setup = [] {
+            std::shared_ptr<std::vector<AircraftState>> states = std::make_shared<std::vector<AircraftState>>(airspaceStates(100000));
+            std::shared_ptr<SpatialIndex> index = std::make_shared<SpatialIndex>();
+            index->build(*states);
+            std::shared_ptr<std::vector<SpatialIndex::Neighbor>> out = std::make_shared<std::vector<SpatialIndex::Neighbor>>();
+            return BenchRunner([states, index, out](size_t n) {
+                double sum = 0.0;
+                for (size_t k = 0; k < n; ++k) {
+                    const uint32_t i = static_cast<uint32_t>(k % states->size());
+                    index->queryNearest((*states)[i].position, 8, *out, i);
+                    sum += out->back().distance;
+                }
+                g_sink = sum;
+            });
+        };
+        cases.push_back(bc);
+    }
+    {
+        BenchCase bc;
+        bc.name = "spatial/radius_20km";
+        bc.setup = [] {
+            std::shared_ptr<std::vector<AircraftState>> states = std::make_shared<std::vector<AircraftState>>(airspaceStates(100000));
+            std::shared_ptr<SpatialIndex> index = std::make_shared<SpatialIndex>();
+            index->build(*states);
+            std::shared_ptr<std::vector<uint32_t>> out = std::make_shared<std::vector<uint32_t>>();
+            return BenchRunner([states, index, out](size_t n) {
+                size_t found = 0;
+                for (size_t k = 0; k < n; ++k) {
+                    out->clear();
+                    found += index->queryRadius((*states)[k % states->size()].position, 20000.0, *out);
+                }
+                g_sink = static_cast<double>(found);
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    // --- 数学函数 (每次迭代处理4096个输入) ---
+    {
+        const size_t MATH_N = 4096;
+        BenchCase loop;
+        loop.name = "math/aepcd_rad/loop";
+        loop.stepsPerIteration = static_cast<double>(MATH_N);
+        loop.setup = [MATH_N] {
+            std::shared_ptr<std::vector<double>> x = std::make_shared<std::vector<double>>(angleInputs<double>(MATH_N));
+            std::shared_ptr<std::vector<double>> y = std::make_shared<std::vector<double>>(MATH_N);
+            return BenchRunner([x, y](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    for (size_t i = 0; i < x->size(); ++i) (*y)[i] = loopAepcdRad((*x)[i]);
+                }
+                g_sink = (*y)[0];
+            });
+        };
+        cases.push_back(loop);
+
+        BenchCase wrap;
+        wrap.name = "math/aepcd_rad/branch_free";
+        wrap.stepsPerIteration = static_cast<double>(MATH_N);
+        wrap.setup = [MATH_N] {
+            std::shared_ptr<std::vector<double>> x = std::make_shared<std::vector<double>>(angleInputs<double>(MATH_N));
+            std::shared_ptr<std::vector<double>> y = std::make_shared<std::vector<double>>(MATH_N);
+            return BenchRunner([x, y](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    for (size_t i = 0; i < x->size(); ++i) (*y)[i] = oe_base::aepcdRad((*x)[i]);
+                }
+                g_sink = (*y)[0];
+            });
+        };
+        cases.push_back(wrap);
+
+        BenchCase stdSinCos;
+        stdSinCos.name = "math/sincos/std";
+        stdSinCos.stepsPerIteration = static_cast<double>(MATH_N);
+        stdSinCos.setup = [MATH_N] {
+            std::shared_ptr<std::vector<double>> x = std::make_shared<std::vector<double>>(angleInputs<double>(MATH_N));
+            std::shared_ptr<std::vector<double>> y = std::make_shared<std::vector<double>>(MATH_N);
+            return BenchRunner([x, y](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    for (size_t i = 0; i < x->size(); ++i) (*y)[i] = std::sin((*x)[i]) + std::cos((*x)[i]);
+                }
+                g_sink = (*y)[0];
+            });
+        };
+        cases.push_back(stdSinCos);
+
+        BenchCase fastSinCos;
+        fastSinCos.name = "math/sincos/fast";
+        fastSinCos.stepsPerIteration = static_cast<double>(MATH_N);
+        fastSinCos.setup = [MATH_N] {
+            std::shared_ptr<std::vector<double>> x = std::make_shared<std::vector<double>>(angleInputs<double>(MATH_N));
+            std::shared_ptr<std::vector<double>> y = std::make_shared<std::vector<double>>(MATH_N);
+            return BenchRunner([x, y](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    for (size_t i = 0; i < x->size(); ++i) {
+                        double s, c;
+                        oe_base::fastSinCos((*x)[i], s, c);
+                        (*y)[i] = s + c;
+                    }
+                }
+                g_sink = (*y)[0];
+            });
+        };
+        cases.push_back(fastSinCos);
+
+        BenchCase fastSinCosF;
+        fastSinCosF.name = "math/sincos_f32/fast";
+        fastSinCosF.stepsPerIteration = static_cast<double>(MATH_N);
+        fastSinCosF.setup = [MATH_N] {
+            std::shared_ptr<std::vector<float>> x = std::make_shared<std::vector<float>>(angleInputs<float>(MATH_N));
+            std::shared_ptr<std::vector<float>> y = std::make_shared<std::vector<float>>(MATH_N);
+            return BenchRunner([x, y](size_t n) {
+                for (size_t k = 0; k < n; ++k) {
+                    for (size_t i = 0; i < x->size(); ++i) {
+                        float s, c;
+                        oe_base::fastSinCos((*x)[i], s, c);
+                        (*y)[i] = s + c;
+                    }
+                }
+                g_sink = (*y)[0];
+            });
+        };
+        cases.push_back(fastSinCosF);
+    }
+
+    // --- 轨迹查询 ---
+    {
+        BenchCase bc;
+        bc.name = "trajectory/lookup_sequential";
+        bc.setup = [] {
+            std::shared_ptr<std::vector<TrajectoryPoint>> points = std::make_shared<std::vector<TrajectoryPoint>>(createManeuverTrajectory());
+            std::shared_ptr<TrajectoryTrack> track = std::make_shared<TrajectoryTrack>(*points);
+            return BenchRunner([points, track](size_t n) {
+                TrajectoryTrack::Cursor cursor;
+                double t = 0.0, sum = 0.0;
+                for (size_t k = 0; k < n; ++k) {
+                    sum += track->sample(t, cursor).headingDeg;
+                    t += DT;
+                    if (t > track->endTime()) t = 0.0;
+                }
+                g_sink = sum;
+            });
+        };
+        cases.push_back(bc);
+    }
+    {
+        BenchCase bc;
+        bc.name = "trajectory/lookup_random";
+        bc.setup = [] {
+            std::shared_ptr<std::vector<TrajectoryPoint>> points = std::make_shared<std::vector<TrajectoryPoint>>(createManeuverTrajectory());
+            std::shared_ptr<TrajectoryTrack> track = std::make_shared<TrajectoryTrack>(*points);
+            std::shared_ptr<std::vector<double>> times = std::make_shared<std::vector<double>>(4096);
+            std::mt19937 rng(42);
+            std::uniform_real_distribution<double> dist(track->startTime(), track->endTime());
+            for (double& t : *times) t = dist(rng);
+            return BenchRunner([points, track, times](size_t n) {
+                double sum = 0.0;
+                for (size_t k = 0; k < n; ++k) {
+                    sum += track->sample((*times)[k & 4095]).headingDeg;
+                }
+                g_sink = sum;
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    // --- 轨迹合成 (步 = 一个轨迹点) ---
+    {
+        BenchCase bc;
+        bc.name = "trajectory/synth_maneuver";
+        std::vector<TrajectoryPoint> probe;
+        synthesizeTrajectory(maneuverProfile(), SynthConfig(), probe);
+        bc.stepsPerIteration = static_cast<double>(probe.size());
+        bc.setup = [] {
+            std::shared_ptr<TrajectoryProfile> profile = std::make_shared<TrajectoryProfile>(maneuverProfile());
+            std::shared_ptr<std::vector<TrajectoryPoint>> out = std::make_shared<std::vector<TrajectoryPoint>>();
+            return BenchRunner([profile, out](size_t n) {
+                for (size_t k = 0; k < n; ++k) synthesizeTrajectory(*profile, SynthConfig(), *out);
+                g_sink = out->back().position.y();
+            });
+        };
+        cases.push_back(bc);
+    }
+    {
+        const size_t BATCH = 1000;
+        std::shared_ptr<std::vector<TrajectoryProfile>> profiles = std::make_shared<std::vector<TrajectoryProfile>>(BATCH);
+        size_t points = 0;
+        for (size_t k = 0; k < BATCH; ++k) {
+            (*profiles)[k] = randomProfile(RandomProfileSpec(), k);
+            points += static_cast<size_t>(std::floor((*profiles)[k].duration() / SynthConfig().sampleTime + 1e-9)) + 1;
+        }
+
+        BenchCase bc;
+        bc.name = "trajectory/synth_random_batch/" + std::to_string(BATCH);
+        bc.stepsPerIteration = static_cast<double>(points);
+        bc.setup = [profiles] {
+            std::shared_ptr<FleetScheduler> scheduler = std::make_shared<FleetScheduler>();
+            std::shared_ptr<std::vector<std::vector<TrajectoryPoint>>> out =
+                std::make_shared<std::vector<std::vector<TrajectoryPoint>>>();
+            return BenchRunner([profiles, scheduler, out](size_t n) {
+                for (size_t k = 0; k < n; ++k) synthesizeTrajectories(*profiles, SynthConfig(), *out, *scheduler);
+                g_sink = out->back().back().position.x();
+            });
+        };
+        cases.push_back(bc);
+    }
+    {
+        BenchCase bc;
+        bc.name = "trajectory/resample_0.05";
+        const std::vector<TrajectoryPoint> source = createManeuverTrajectory();
+        std::vector<TrajectoryPoint> probe;
+        resampleTrajectory(source, 0.05, probe);
+        bc.stepsPerIteration = static_cast<double>(probe.size());
+        bc.setup = [] {
+            std::shared_ptr<std::vector<TrajectoryPoint>> points = std::make_shared<std::vector<TrajectoryPoint>>(createManeuverTrajectory());
+            std::shared_ptr<std::vector<TrajectoryPoint>> out = std::make_shared<std::vector<TrajectoryPoint>>();
+            return BenchRunner([points, out](size_t n) {
+                for (size_t k = 0; k < n; ++k) resampleTrajectory(*points, 0.05, *out);
+                g_sink = out->back().position.x();
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    // --- 日志吞吐 ---
+    {
+        BenchCase bc;
+        bc.name = "logging/binary_record";
+        // 生产者比写线程快时缓冲区满, 记录被丢弃 (log 立即返回): 吞吐只计写入缓冲区的记录, 丢弃数单独报告
+        std::shared_ptr<uint64_t> dropped = std::make_shared<uint64_t>(0);
+        bc.droppedSteps = dropped;
+        bc.setup = [dropped] {
+            std::shared_ptr<StateLogger> logger = std::make_shared<StateLogger>(1 << 20);
+            logger->open("bench_log.bin");
+            return BenchRunner([logger, dropped](size_t n) {
+                StateLogRecord r;
+                for (size_t k = 0; k < n; ++k) {
+                    r.time = k * DT;
+                    r.posX = static_cast<double>(k);
+                    logger->log(r);
+                }
+                *dropped = logger->droppedCount();
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    // --- 流式误差分析: 每条记录的开销 (目标值周期性变化, 产生阶段切换和指令响应) ---
+    {
+        BenchCase bc;
+        bc.name = "analytics/record";
+        bc.setup = [] {
+            std::shared_ptr<TrackingAnalytics> analytics = std::make_shared<TrackingAnalytics>();
+            std::shared_ptr<size_t> step = std::make_shared<size_t>(0);
+            return BenchRunner([analytics, step](size_t n) {
+                StateLogRecord r;
+                for (size_t k = 0; k < n; ++k) {
+                    const size_t i = (*step)++;
+                    const double t = i * DT;
+                    const double ramp = static_cast<double>(i % 3600) / 3600.0;
+                    r.time = t;
+                    r.targetAlt = 3000.0 + ((i / 3600) % 2 ? 0.0 : 1000.0 * ramp);
+                    r.targetHdg = oe_base::aepcdDeg(90.0 * ramp);
+                    r.targetVelKts = 300.0;
+                    const double wobble = static_cast<double>(i % 240) / 120.0 - 1.0;
+                    r.alt = r.targetAlt - 20.0 * wobble;
+                    r.yawDeg = r.targetHdg - 2.0 * wobble;
+                    r.velKts = 300.0 + wobble;
+                    r.errorDist = 100.0 + 50.0 * wobble;
+                    r.errorAlt = r.alt - r.targetAlt;
+                    r.errorHdg = r.yawDeg - r.targetHdg;
+                    r.errorVel = r.velKts - r.targetVelKts;
+                    analytics->add(r);
+                }
+                g_sink = analytics->dist().stats.rms();
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    // --- 完整场景: 生成轨迹 + 120秒跟踪 ---
+    {
+        BenchCase bc;
+        bc.name = "scenario/maneuver_120s";
+        double checksum = 0.0;
+        bc.stepsPerIteration = static_cast<double>(runManeuver(checksum));
+        bc.setup = [] {
+            return BenchRunner([](size_t n) {
+                double checksum = 0.0;
+                for (size_t k = 0; k < n; ++k) runManeuver(checksum);
+                g_sink = checksum;
+            });
+        };
+        cases.push_back(bc);
+    }
+
+    // --- 脚本化机队: 每帧 director.step + fleet.update / 只有 director.step (全部任务等待中) ---
+    // 巡逻脚本: 爬升到指定高度 → 等待 → 右转90度 → 等待 → 转回 → 循环; 8种脚本, 开始时刻错开
+    {
+        struct Scripted {
+            LaeroFleet fleet;
+            ScenarioDirector director;
+            std::vector<MissionScript> scripts;
+            double time = 0.0;
+            Scripted() : director(fleet) {}
+        };
+        const size_t count = 100000;
+        for (int mode = 0; mode < 2; ++mode) {
+            BenchCase bc;
+            bc.name = mode == 0 ? "scenario/scripted_fleet/100000" : "scenario/director_waiting/100000";
+            bc.stepsPerIteration = static_cast<double>(count);
+            bc.setup = [count, mode] {
+                std::shared_ptr<Scripted> s = std::make_shared<Scripted>();
+                for (int v = 0; v < 8; ++v) {
+                    const double alt = 2500.0 + 250.0 * v;
+                    const double hdg = -180.0 + 45.0 * v;
+                    MissionScript script;
+                    script.commandAltitude(alt).waitAltitude(alt)
+                          .wait(20.0 + 5.0 * v).commandHeading(hdg + 90.0).waitHeading(hdg + 90.0, 2.0)
+                          .wait(40.0).commandHeading(hdg).waitHeading(hdg, 2.0).jump(2);
+                    s->scripts.push_back(script);
+                }
+                s->fleet.reserve(count);
+                s->director.reserve(count);
+                for (size_t i = 0; i < count; ++i) {
+                    s->fleet.addAircraft(fleetState(i));
+                    s->director.assign(i, s->scripts[i % 8], 0.01 * (i % 1000));
+                }
+                // 等待用例: 只推进调度器 (机队不动), 所有任务开始后都停在 waitAltitude
+                if (mode == 1) {
+                    for (int k = 0; k < 11 * 60; ++k) s->director.step(s->time += DT);
+                }
+                return BenchRunner([s, mode](size_t n) {
+                    for (size_t k = 0; k < n; ++k) {
+                        s->director.step(s->time);
+                        if (mode == 0) {
+                            s->fleet.update(DT);
+                            s->time += DT;
+                        }
+                    }
+                    g_sink = static_cast<double>(s->director.resumeCount());
+                });
+            };
+            cases.push_back(bc);
+        }
+    }
+
+    return cases;
+}
+
+void writeJson(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"simd_level\": \"" << laero_simd::levelName(laero_simd::activeLevel()) << "\",\n";
+    out << "    \"threads\": " << std::thread::hardware_concurrency() << "\n";
+    out << "  },\n";
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\""
+            << ", \"iterations\": " << r.iterations
+            << ", \"seconds\": " << r.seconds
+            << ", \"ns_per_step\": " << r.nsPerStep
+            << ", \"steps_per_second\": " << r.stepsPerSecond
+            << ", \"allocs_per_iteration\": " << r.allocsPerIteration
+            << ", \"allocs_per_step\": " << r.allocsPerStep
+            << ", \"dropped_steps\": " << r.droppedSteps
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string jsonPath;
+    double minTime = 0.5;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) filter = argv[++i];
+        else if (arg == "--json" && i + 1 < argc) jsonPath = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc) minTime = std::atof(argv[++i]);
+        else if (arg == "--check") return runMathChecks() ? 0 : 1;
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--filter substring] [--min-time seconds] [--json file] [--check]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::printf("SIMD level: %s, hardware threads: %u\n",
+                laero_simd::levelName(laero_simd::activeLevel()), std::thread::hardware_concurrency());
+    std::printf("%-34s %12s %14s %16s %14s\n", "Benchmark", "Iterations", "ns/step", "steps/s", "allocs/step");
+
+    std::vector<BenchResult> results;
+    for (const BenchCase& bc : registerCases()) {
+        if (!filter.empty() && bc.name.find(filter) == std::string::npos) continue;
+        const BenchResult r = runCase(bc, minTime);
+        std::printf("%-34s %12zu %14.2f %16.0f %14.4f",
+                    r.name.c_str(), r.iterations, r.nsPerStep, r.stepsPerSecond, r.allocsPerStep);
+        if (r.droppedSteps > 0) {
+            std::printf("   dropped %llu (%.1f%%)", static_cast<unsigned long long>(r.droppedSteps),
+                        100.0 * r.droppedSteps / (bc.stepsPerIteration * r.iterations));
+        }
+        std::printf("\n");
+        results.push_back(r);
+    }
+
+    if (!jsonPath.empty()) {
+        writeJson(jsonPath, results);
+        std::printf("Results written to %s\n", jsonPath.c_str());
+    }
+    return 0;
+}
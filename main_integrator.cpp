@@ -0,0 +1,132 @@
+// main_integrator.cpp
+// 编译指令: g++ -O2 main_integrator.cpp StandaloneLaeroModel.cpp StandaloneRacModel/StandaloneRacModel.cpp Trajectory.cpp TrajectoryTrack.cpp TrackingDriver.cpp
+//           -o IntegratorReport -std=c++17 -I. -IStandaloneRacModel
+//
+// 用法: ./IntegratorReport [--duration 秒=120] [--guidance 制导周期=1]
+// 在标准S型机动上比较各积分方法在不同步长下的精度和计算量。指令每个制导周期按期望轨迹刷新一次,
+// 周期内每步重复下达 (所有步长和方法的输入完全相同); 以 RK4、dt ≈ 1/1000 s (整除制导周期) 的结果为基准,
+// 报告各制导周期边界处的最大位置误差、终值误差、步数、导数计算次数和耗时。
+// --guidance 0.0166667 即每步刷新指令 (与 TrackingDriver 相同)。
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "StandaloneLaeroModel.hpp"
+#include "StandaloneRacModel.hpp"
+#include "Trajectory.hpp"
+#include "TrajectoryTrack.hpp"
+#include "TrackingDriver.hpp"
+
+namespace {
+
+struct RunResult {
+    std::vector<AircraftState> samples;   // 各制导周期边界的状态
+    size_t steps = 0;
+    uint64_t evals = 0;
+    double ms = 0.0;
+};
+
+template<class Model>
+RunResult runScenario(const TrajectoryTrack& track, const TrajectoryPoint& start,
+                      const IntegratorConfig& config, double dt, double guidance) {
+    Model model;
+    model.setInitialState(trackingStartState(start));
+    model.setIntegrator(config);
+
+    const long stepsPerPeriod = std::lround(guidance / dt);
+    const long periods = static_cast<long>(track.endTime() / guidance);
+    RunResult result;
+    result.samples.reserve(periods);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (long k = 0; k < periods; ++k) {
+        const FlightCommand command = trackingCommand(track.sample(k * guidance));
+        for (long i = 0; i < stepsPerPeriod; ++i) {
+            model.command(command);
+            model.update(dt);
+        }
+        result.steps += stepsPerPeriod;
+        result.samples.push_back(model.getState());
+    }
+    result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    result.evals = model.derivativeEvaluations();
+    return result;
+}
+
+double distance(const AircraftState& a, const AircraftState& b) {
+    return (a.position - b.position).length();
+}
+
+template<class Model>
+void reportModel(const char* name, const TrajectoryTrack& track, const TrajectoryPoint& start, double guidance) {
+    IntegratorConfig refConfig;
+    refConfig.type = INTEGRATOR_RK4;
+    const double refDt = guidance / std::ceil(guidance * 1000.0 - 1.0e-6);
+    const RunResult ref = runScenario<Model>(track, start, refConfig, refDt, guidance);
+
+    const IntegratorType types[] = { INTEGRATOR_DEFAULT, INTEGRATOR_RK4, INTEGRATOR_ABM3, INTEGRATOR_ADAPTIVE };
+    const double steps[] = { 1.0 / 60.0, 1.0 / 30.0, 0.1, 0.25, 0.5, 1.0 };
+
+    for (IntegratorType type : types) {
+        IntegratorConfig config;
+        config.type = type;
+        for (double dt : steps) {
+            if (dt > guidance) continue;
+            const RunResult r = runScenario<Model>(track, start, config, dt, guidance);
+
+            double maxErr = 0.0;
+            bool finite = true;
+            for (size_t k = 0; k < r.samples.size() && k < ref.samples.size(); ++k) {
+                const double e = distance(r.samples[k], ref.samples[k]);
+                if (!std::isfinite(e)) finite = false;
+                else if (e > maxErr) maxErr = e;
+            }
+            const double finalErr = r.samples.empty() ? 0.0 : distance(r.samples.back(), ref.samples.back());
+
+            // 默认方法不统计导数计算次数, 每步相当于1次
+            const uint64_t evals = (type == INTEGRATOR_DEFAULT) ? r.steps : r.evals;
+            if (finite) {
+                std::printf("%-6s %-9s %8.4f  %12.3e %12.3e  %8zu %10llu  %9.3f\n", name, integratorName(type), dt,
+                            maxErr, finalErr, r.steps, static_cast<unsigned long long>(evals), r.ms);
+            } else {
+                std::printf("%-6s %-9s %8.4f  %12s %12s  %8zu %10llu  %9.3f\n", name, integratorName(type), dt,
+                            "diverged", "-", r.steps, static_cast<unsigned long long>(evals), r.ms);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    double duration = 120.0;
+    double guidance = 1.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--duration" && i + 1 < argc) duration = std::atof(argv[++i]);
+        else if (arg == "--guidance" && i + 1 < argc) guidance = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--duration seconds] [--guidance seconds]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (!(guidance > 0.0)) {
+        std::fprintf(stderr, "guidance period must be positive\n");
+        return 1;
+    }
+
+    const std::vector<TrajectoryPoint> trajectory = createManeuverTrajectory(duration);
+    const TrajectoryTrack track(trajectory, 0.0);
+
+    std::printf("integrators on the S maneuver: %.1f s, guidance every %.4f s, reference rk4 dt = %.6f s\n",
+                duration, guidance, guidance / std::ceil(guidance * 1000.0 - 1.0e-6));
+    std::printf("%-6s %-9s %8s  %12s %12s  %8s %10s  %9s\n", "model", "method", "dt(s)",
+                "maxPos(m)", "finalPos(m)", "steps", "evals", "time(ms)");
+
+    reportModel<StandaloneLaeroModel>("laero", track, trajectory.front(), guidance);
+    reportModel<StandaloneRacModel>("rac", track, trajectory.front(), guidance);
+    return 0;
+}
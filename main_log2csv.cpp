@@ -0,0 +1,74 @@
+// main_log2csv.cpp
+// 编译指令: g++ main_log2csv.cpp StateLogger.cpp -o Log2Csv -std=c++17 -I. -pthread
+//
+// 用法: ./Log2Csv maneuver_log.bin maneuver_log.csv [--aircraft id]
+// 把 StateLogger 写出的二进制日志转换为原来的CSV列格式, 供 analyze_trajectory.py 使用。
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "StateLogger.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc != 3 && argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " input.bin output.csv [--aircraft id]" << std::endl;
+        return 1;
+    }
+
+    bool filterAircraft = false;
+    uint32_t aircraftId = 0;
+    if (argc == 5) {
+        if (std::string(argv[3]) != "--aircraft") {
+            std::cerr << "Unknown option: " << argv[3] << std::endl;
+            return 1;
+        }
+        filterAircraft = true;
+        aircraftId = static_cast<uint32_t>(std::strtoul(argv[4], nullptr, 10));
+    }
+
+    StateLogReader reader;
+    if (!reader.open(argv[1])) {
+        std::cerr << "Error: " << argv[1] << " is not a state log." << std::endl;
+        return 1;
+    }
+
+    std::ofstream outputFile(argv[2]);
+    if (!outputFile.is_open()) {
+        std::cerr << "Error: Could not open output file." << std::endl;
+        return 1;
+    }
+
+    // --- 与原CSV相同的列布局 ---
+    std::vector<size_t> columns;
+    if (reader.layout() == LOG_LAYOUT_RAC) {
+        outputFile << "Time,PosX,PosY,Alt,Roll,Pitch,Yaw,VelKts,TargetAlt,TargetHdg,TargetVelKts,ErrorDist\n";
+        columns = { 0, 1, 2, 3, 4, 5, 6, 7, 10, 11, 12, 13 };
+    } else {
+        outputFile << "Time,PosX,PosY,Alt,Roll,Pitch,Yaw,VelKts,"
+                   << "TargetPosX,TargetPosY,TargetAlt,TargetHdg,TargetVelKts,"
+                   << "ErrorDist,ErrorAlt,ErrorHdg,ErrorVel\n";
+        for (size_t k = 0; k < STATE_LOG_COLUMN_COUNT; ++k) columns.push_back(k);
+    }
+
+    outputFile << std::fixed << std::setprecision(4);
+
+    size_t rows = 0;
+    std::vector<StateLogRecord> records;
+    while (reader.readBlock(records)) {
+        for (const StateLogRecord& r : records) {
+            if (filterAircraft && r.aircraftId != aircraftId) continue;
+            for (size_t k = 0; k < columns.size(); ++k) {
+                if (k > 0) outputFile << ",";
+                outputFile << stateLogColumn(r, columns[k]);
+            }
+            outputFile << "\n";
+            ++rows;
+        }
+    }
+
+    std::cout << "Wrote " << rows << " rows to " << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,88 @@
+// main_logstats.cpp
+// 编译指令: g++ -O2 main_logstats.cpp TrackingAnalytics.cpp StateLogger.cpp -o LogStats -std=c++17 -I. -pthread
+//
+// 用法: ./LogStats maneuver_log.bin [summary.json | summary.csv] [--aircraft id]
+// 逐块读取 StateLogger 的二进制日志, 用 TrackingAnalytics 流式统计跟踪误差 (内存与日志长度无关)。
+// 日志中有多架飞机时每架单独统计 (按 aircraftId), 输出机队汇总; 只有一架 (或用 --aircraft 选择) 时
+// 输出包括逐段和逐次响应列表。不给出输出文件时把 JSON 写到标准输出。
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "StateLogger.hpp"
+#include "TrackingAnalytics.hpp"
+
+int main(int argc, char* argv[]) {
+    std::string inputPath;
+    std::string outputPath;
+    bool filterAircraft = false;
+    uint32_t aircraftId = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--aircraft" && i + 1 < argc) {
+            filterAircraft = true;
+            aircraftId = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (inputPath.empty()) {
+            inputPath = arg;
+        } else if (outputPath.empty()) {
+            outputPath = arg;
+        } else {
+            inputPath.clear();
+            break;
+        }
+    }
+    if (inputPath.empty()) {
+        std::cerr << "Usage: " << argv[0] << " input.bin [summary.json|summary.csv] [--aircraft id]" << std::endl;
+        return 1;
+    }
+
+    StateLogReader reader;
+    if (!reader.open(inputPath)) {
+        std::cerr << "Error: " << inputPath << " is not a state log." << std::endl;
+        return 1;
+    }
+
+    // 每架飞机一个分析器 (日志中各架飞机的记录交错存放, 每架内部按时间顺序)
+    std::unordered_map<uint32_t, TrackingAnalytics> perAircraft;
+    std::vector<StateLogRecord> records;
+    uint64_t rows = 0;
+    while (reader.readBlock(records)) {
+        for (const StateLogRecord& r : records) {
+            if (filterAircraft && r.aircraftId != aircraftId) continue;
+            perAircraft[r.aircraftId].add(r);
+            ++rows;
+        }
+    }
+    if (perAircraft.empty()) {
+        std::cerr << "Error: no records." << std::endl;
+        return 1;
+    }
+
+    TrackingAnalytics fleet;
+    for (auto& entry : perAircraft) entry.second.finish();
+    const TrackingAnalytics* result = &perAircraft.begin()->second;
+    if (perAircraft.size() > 1) {
+        for (const auto& entry : perAircraft) fleet.merge(entry.second);
+        result = &fleet;
+    }
+
+    if (outputPath.empty()) {
+        result->writeJson(std::cout);
+        return 0;
+    }
+
+    std::ofstream out(outputPath);
+    const bool csv = outputPath.size() >= 4 && outputPath.compare(outputPath.size() - 4, 4, ".csv") == 0;
+    if (csv) result->writeCsv(out);
+    else result->writeJson(out);
+    if (!out) {
+        std::cerr << "Error: Could not write " << outputPath << std::endl;
+        return 1;
+    }
+    std::cout << "Analyzed " << rows << " records of " << perAircraft.size() << " aircraft, summary written to "
+              << outputPath << std::endl;
+    return 0;
+}
@@ -0,0 +1,90 @@
+// main_precision.cpp
+// 编译指令: g++ -O2 main_precision.cpp StandaloneLaeroModel.cpp StandaloneRacModel/StandaloneRacModel.cpp Trajectory.cpp TrajectoryTrack.cpp TrackingDriver.cpp
+//           -o PrecisionReport -std=c++17 -I. -IStandaloneRacModel
+//
+// 用法: ./PrecisionReport [--duration 秒=120] [--dt 步长=1/60]
+// 在标准S型机动轨迹上分别以 double 和 float 运行 LaeroModel 与 RacModel, 报告 float 相对 double 的漂移
+// (位置、高度、航向、速度的最大值与终值) 以及两种精度各自的轨迹跟踪误差。
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "StandaloneLaeroModel.hpp"
+#include "StandaloneRacModel.hpp"
+#include "Trajectory.hpp"
+#include "TrajectoryTrack.hpp"
+#include "TrackingDriver.hpp"
+#include "TrackingStats.hpp"
+
+namespace {
+
+template<class Model>
+std::vector<StateLogRecord> runScenario(const TrajectoryTrack& track, const TrajectoryPoint& start, double dt) {
+    Model model;
+    model.setInitialState(stateCast<typename Model::Scalar>(trackingStartState(start)));
+    std::vector<StateLogRecord> records;
+    runTrackingScenario(model, track, dt, [&records](const StateLogRecord& r) { records.push_back(r); });
+    return records;
+}
+
+void report(const char* name, const std::vector<StateLogRecord>& ref, const std::vector<StateLogRecord>& low) {
+    RunningStats pos, alt, hdg, vel;
+    const size_t n = std::min(ref.size(), low.size());
+    for (size_t k = 0; k < n; ++k) {
+        const double dx = low[k].posX - ref[k].posX;
+        const double dy = low[k].posY - ref[k].posY;
+        const double dz = low[k].alt - ref[k].alt;
+        pos.add(std::sqrt(dx * dx + dy * dy + dz * dz));
+        alt.add(dz);
+        hdg.add(oe_base::aepcdDeg(low[k].yawDeg - ref[k].yawDeg));
+        vel.add(low[k].velKts - ref[k].velKts);
+    }
+    if (n == 0) return;
+
+    const StateLogRecord& a = ref[n - 1];
+    const StateLogRecord& b = low[n - 1];
+    const double finalPos = std::sqrt((b.posX - a.posX) * (b.posX - a.posX) + (b.posY - a.posY) * (b.posY - a.posY) +
+                                      (b.alt - a.alt) * (b.alt - a.alt));
+
+    TrackingStats refStats, lowStats;
+    for (size_t k = 0; k < n; ++k) {
+        refStats.add(ref[k].errorDist, ref[k].errorAlt, ref[k].errorHdg, ref[k].errorVel);
+        lowStats.add(low[k].errorDist, low[k].errorAlt, low[k].errorHdg, low[k].errorVel);
+    }
+
+    std::printf("%-6s %8zu  %12.3e %12.3e  %12.3e  %12.3e  %12.3e   %10.4f %10.4f\n", name, n,
+                pos.max(), finalPos, alt.maxAbs(), hdg.maxAbs(), vel.maxAbs(),
+                refStats.dist.rms(), lowStats.dist.rms());
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    double duration = 120.0;
+    double dt = 1.0 / 60.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--duration" && i + 1 < argc) duration = std::atof(argv[++i]);
+        else if (arg == "--dt" && i + 1 < argc) dt = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--duration seconds] [--dt seconds]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const std::vector<TrajectoryPoint> trajectory = createManeuverTrajectory(duration);
+    const TrajectoryTrack track(trajectory, 0.0);
+
+    std::printf("float vs double on the S maneuver: %.1f s, dt = %.6f s\n", duration, dt);
+    std::printf("%-6s %8s  %12s %12s  %12s  %12s  %12s   %10s %10s\n", "model", "steps",
+                "maxPos(m)", "finalPos(m)", "maxAlt(m)", "maxHdg(deg)", "maxVel(kts)", "rmsErr(d)", "rmsErr(f)");
+
+    report("laero", runScenario<StandaloneLaeroModel>(track, trajectory.front(), dt),
+                    runScenario<StandaloneLaeroModelF>(track, trajectory.front(), dt));
+    report("rac", runScenario<StandaloneRacModel>(track, trajectory.front(), dt),
+                  runScenario<StandaloneRacModelF>(track, trajectory.front(), dt));
+    return 0;
+}
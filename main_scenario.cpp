@@ -0,0 +1,157 @@
+// main_scenario.cpp
+// 编译指令: g++ -O2 main_scenario.cpp ScenarioScript.cpp LaeroFleet.cpp LaeroSimd.cpp -o ScenarioSim -std=c++17 -I. -pthread
+//           (协程任务: 改用 -std=c++20)
+//
+// 用法: ./ScenarioSim [--aircraft N] [--duration 秒] [--poll 帧数] [--coroutines]
+//   默认: 20000 架飞机按巡逻脚本飞行 600 秒 (60Hz), 每架飞机的脚本由 ScenarioDirector 在等待条件满足时唤醒
+//   --coroutines : 用 C++20 协程写的同一任务代替 MissionScript (需要 -std=c++20 编译)
+//
+// 输出每帧 director.step 与 fleet.update 的平均耗时, 以及唤醒/条件检查次数。
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "LaeroFleet.hpp"
+#include "ScenarioScript.hpp"
+#include "ScenarioCoroutine.hpp"
+
+namespace {
+
+const double DT = 1.0 / 60.0;
+const int VARIANTS = 8;
+
+double patrolAltitude(int variant) { return 2500.0 + 250.0 * variant; }
+double patrolHeading(int variant) { return -180.0 + 45.0 * variant; }
+double patrolLegSeconds(int variant) { return 60.0 + 10.0 * variant; }
+
+// 巡逻任务: 爬升到巡逻高度 → 平飞一段 → 右转90度 → 平飞 → 转回原航向 → 循环
+MissionScript patrolScript(int variant) {
+    const double alt = patrolAltitude(variant);
+    const double hdg = patrolHeading(variant);
+    MissionScript script;
+    script.commandAltitude(alt).commandVelocity(250.0).waitAltitude(alt)
+          .wait(patrolLegSeconds(variant))
+          .commandHeading(hdg + 90.0).waitHeading(hdg + 90.0, 2.0)
+          .wait(patrolLegSeconds(variant))
+          .commandHeading(hdg).waitHeading(hdg, 2.0)
+          .jump(3);
+    return script;
+}
+
+#if defined(__cpp_impl_coroutine)
+// 与 patrolScript 相同的任务
+MissionTask patrolTask(MissionContext m, int variant) {
+    const double alt = patrolAltitude(variant);
+    const double hdg = patrolHeading(variant);
+    m.commandAltitude(alt);
+    m.commandVelocity(250.0);
+    co_await m.untilAltitude(alt);
+    for (;;) {
+        co_await m.delay(patrolLegSeconds(variant));
+        m.commandHeading(hdg + 90.0);
+        co_await m.untilHeading(hdg + 90.0, 2.0);
+        co_await m.delay(patrolLegSeconds(variant));
+        m.commandHeading(hdg);
+        co_await m.untilHeading(hdg, 2.0);
+    }
+}
+#endif
+
+AircraftState startState(size_t i, int variant) {
+    AircraftState s;
+    s.position.set(1000.0 * (i % 200), 1000.0 * (i / 200), -2000.0);
+    s.yaw = patrolHeading(variant) * oe_base::angle::D2RCC;
+    s.bodyVelocity.set(200.0 * oe_base::units::KTS2MPS, 0, 0);
+    return s;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t aircraft = 20000;
+    double duration = 600.0;
+    unsigned pollFrames = 6;
+    bool coroutines = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--aircraft" && i + 1 < argc) aircraft = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--duration" && i + 1 < argc) duration = std::atof(argv[++i]);
+        else if (arg == "--poll" && i + 1 < argc) pollFrames = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (arg == "--coroutines") coroutines = true;
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--aircraft N] [--duration seconds] [--poll frames] [--coroutines]" << std::endl;
+            return 1;
+        }
+    }
+#if !defined(__cpp_impl_coroutine)
+    if (coroutines) {
+        std::cerr << "Error: --coroutines requires a C++20 build (-std=c++20)." << std::endl;
+        return 1;
+    }
+#endif
+
+    // --- 机队与任务 ---
+    LaeroFleet fleet;
+    fleet.reserve(aircraft);
+    ScenarioDirector director(fleet);
+    director.setConditionPollFrames(pollFrames);
+    director.reserve(aircraft);
+
+    std::vector<MissionScript> scripts;
+    for (int v = 0; v < VARIANTS; ++v) scripts.push_back(patrolScript(v));
+#if defined(__cpp_impl_coroutine)
+    std::vector<MissionTask> tasks;
+    if (coroutines) tasks.reserve(aircraft);
+#endif
+
+    for (size_t i = 0; i < aircraft; ++i) {
+        const int variant = static_cast<int>(i % VARIANTS);
+        fleet.addAircraft(startState(i, variant));
+        const double startTime = 0.01 * (i % 1000);    // 错开开始时刻
+#if defined(__cpp_impl_coroutine)
+        if (coroutines) {
+            tasks.push_back(patrolTask(MissionContext(director, i), variant));
+            tasks.back().start(startTime);
+            continue;
+        }
+#endif
+        director.assign(i, scripts[variant], startTime);
+    }
+
+    // --- 仿真循环 ---
+    std::cout << "Running " << aircraft << " scripted aircraft for " << duration << " s ("
+              << (coroutines ? "coroutines" : "mission scripts") << ", condition poll every " << pollFrames << " frames)..."
+              << std::endl;
+
+    double directorSeconds = 0.0;
+    double fleetSeconds = 0.0;
+    size_t frames = 0;
+    for (double simTime = 0.0; simTime <= duration; simTime += DT) {
+        const auto t0 = std::chrono::steady_clock::now();
+        director.step(simTime);
+        const auto t1 = std::chrono::steady_clock::now();
+        fleet.update(DT);
+        const auto t2 = std::chrono::steady_clock::now();
+        directorSeconds += std::chrono::duration<double>(t1 - t0).count();
+        fleetSeconds += std::chrono::duration<double>(t2 - t1).count();
+        ++frames;
+    }
+
+    const double perAircraftFrame = 1.0e9 / (static_cast<double>(frames) * aircraft);
+    std::printf("Frames: %zu\n", frames);
+    std::printf("director.step : %10.3f ms/frame  %8.3f ns/aircraft\n",
+                directorSeconds * 1.0e3 / frames, directorSeconds * perAircraftFrame);
+    std::printf("fleet.update  : %10.3f ms/frame  %8.3f ns/aircraft\n",
+                fleetSeconds * 1.0e3 / frames, fleetSeconds * perAircraftFrame);
+    std::printf("Resumes: %llu (%.3f per aircraft per second), condition checks: %llu\n",
+                static_cast<unsigned long long>(director.resumeCount()),
+                director.resumeCount() / (static_cast<double>(aircraft) * duration),
+                static_cast<unsigned long long>(director.conditionChecks()));
+    std::printf("Active tasks: %zu (timer waits %zu, condition waits %zu)\n",
+                director.activeCount(), director.timerCount(), director.conditionCount());
+    return 0;
+}
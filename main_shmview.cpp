@@ -0,0 +1,52 @@
+// main_shmview.cpp
+// 编译指令: g++ -O2 main_shmview.cpp SharedState.cpp -o ShmView -std=c++17 -I.
+// 运行: ./ShmView /name [间隔毫秒=500] [显示架数=5]
+// 读取仿真进程 (ManeuverSim --shm /name) 发布到共享内存的实时状态并周期性打印, Ctrl+C 退出
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SharedState.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " /name [intervalMs] [showCount]" << std::endl;
+        return 1;
+    }
+    const std::string name = argv[1];
+    const int intervalMs = (argc > 2) ? std::atoi(argv[2]) : 500;
+    const size_t showCount = (argc > 3) ? static_cast<size_t>(std::atoi(argv[3])) : 5;
+
+    // 等待发布方创建共享内存
+    SharedStateReader reader;
+    while (!reader.open(name)) {
+        std::cerr << "Waiting: " << reader.lastError() << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+    std::cout << "Opened " << name << ", capacity " << reader.capacity() << std::endl;
+
+    std::vector<AircraftState> states;
+    uint64_t lastFrame = 0;
+    for (;;) {
+        double simTime = 0.0;
+        uint64_t frame = 0;
+        if (reader.read(states, &simTime, &frame) && frame != lastFrame) {
+            std::printf("frame %llu  t=%.3f s  aircraft %zu\n", static_cast<unsigned long long>(frame), simTime, states.size());
+            for (size_t i = 0; i < states.size() && i < showCount; ++i) {
+                const AircraftState& s = states[i];
+                std::printf("  #%zu  pos (%.1f, %.1f)  alt %.1f m  hdg %.2f deg  %.1f kts\n", i,
+                            s.position.x(), s.position.y(), -s.position.z(),
+                            oe_base::aepcdDeg(s.yaw * oe_base::angle::R2DCC),
+                            s.bodyVelocity.length() * oe_base::units::MPS2KTS);
+            }
+            std::fflush(stdout);
+            lastFrame = frame;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+    return 0;
+}
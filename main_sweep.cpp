@@ -0,0 +1,130 @@
+// main_sweep.cpp
+// 编译指令: g++ -O2 main_sweep.cpp SweepRunner.cpp StandaloneLaeroModel.cpp FleetScheduler.cpp Trajectory.cpp TrajectoryFile.cpp TrajectoryTrack.cpp
+//           TrackingDriver.cpp -o SweepSim -std=c++17 -I. -pthread
+//
+// 用法: ./SweepSim [--random N] [--seed S] [--perturb] [--threads T] [--trajectory file.ltrj] [--out sweep_results.csv]
+//   默认: 对 maxBankD / hDps / maxPitchD / vNps / altitudeTau 做网格扫描 (243个工况)
+//   --random N : 改为在同样的参数区间内随机采样N个工况
+//   --perturb  : 每个工况叠加随机初始状态扰动 (水平50米, 高度20米, 航向5度, 速度10节, 1σ)
+//
+// 所有工况在进程内并行运行, 每个工况输出一行误差统计, 不写逐步日志。
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "FleetScheduler.hpp"
+#include "SweepRunner.hpp"
+#include "Trajectory.hpp"
+#include "TrajectoryFile.hpp"
+
+int main(int argc, char* argv[]) {
+    size_t randomCount = 0;
+    uint64_t seed = 1;
+    bool perturb = false;
+    unsigned threads = 0;
+    std::string trajectoryPath;
+    std::string outPath = "sweep_results.csv";
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--random" && i + 1 < argc) randomCount = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--perturb") perturb = true;
+        else if (arg == "--threads" && i + 1 < argc) threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (arg == "--trajectory" && i + 1 < argc) trajectoryPath = argv[++i];
+        else if (arg == "--out" && i + 1 < argc) outPath = argv[++i];
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--random N] [--seed S] [--perturb] [--threads T] [--trajectory file.ltrj] [--out file.csv]" << std::endl;
+            return 1;
+        }
+    }
+
+    // --- 期望轨迹 ---
+    std::vector<TrajectoryPoint> generatedTrajectory;
+    MappedTrajectoryFile trajectoryFile;
+    TrajectorySpan trajectory;
+    if (!trajectoryPath.empty()) {
+        if (!trajectoryFile.open(trajectoryPath)) {
+            std::cerr << "Error: " << trajectoryFile.lastError() << std::endl;
+            return 1;
+        }
+        trajectory = trajectoryFile.trajectory(0);
+    } else {
+        generatedTrajectory = createManeuverTrajectory();
+        trajectory = generatedTrajectory;
+    }
+    if (trajectory.empty()) {
+        std::cerr << "Error: Trajectory is empty." << std::endl;
+        return 1;
+    }
+
+    // --- 工况 ---
+    std::vector<SweepCase> cases;
+    if (randomCount > 0) {
+        SweepRandomSpec spec;
+        spec.count = randomCount;
+        spec.seed = seed;
+        spec.maxBankD = SweepRange(20.0, 45.0);
+        spec.hDps = SweepRange(10.0, 30.0);
+        spec.maxPitchD = SweepRange(10.0, 20.0);
+        spec.vNps = SweepRange(3.0, 10.0);
+        spec.altitudeTau = SweepRange(2.0, 8.0);
+        cases = makeRandomCases(spec);
+    } else {
+        SweepGrid grid;
+        grid.maxBankD = { 20.0, 30.0, 45.0 };
+        grid.hDps = { 10.0, 20.0, 30.0 };
+        grid.maxPitchD = { 10.0, 15.0, 20.0 };
+        grid.vNps = { 3.0, 5.0, 10.0 };
+        grid.altitudeTau = { 2.0, 4.0, 8.0 };
+        cases = makeGridCases(grid);
+    }
+    if (perturb) {
+        SweepPerturbation perturbation;
+        perturbation.horizontalSigmaM = 50.0;
+        perturbation.altitudeSigmaM = 20.0;
+        perturbation.headingSigmaDeg = 5.0;
+        perturbation.velocitySigmaKts = 10.0;
+        applyPerturbation(cases, perturbation, seed);
+    }
+
+    // --- 运行 ---
+    FleetScheduler scheduler(threads);
+    std::cout << "Running " << cases.size() << " cases on " << scheduler.threadCount() << " threads..." << std::endl;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const std::vector<SweepResult> results = runSweep(trajectory, cases, scheduler);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::ofstream out(outPath);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open output file." << std::endl;
+        return 1;
+    }
+    writeSweepTable(out, results);
+
+    // --- 摘要: 位置误差RMS最小的几个工况 ---
+    std::vector<size_t> order(results.size());
+    for (size_t k = 0; k < order.size(); ++k) order[k] = k;
+    std::sort(order.begin(), order.end(), [&results](size_t a, size_t b) {
+        return results[a].stats.dist.rms() < results[b].stats.dist.rms();
+    });
+
+    std::printf("Finished in %.2f s. Best cases by ErrorDist RMS:\n", seconds);
+    std::printf("%6s %9s %6s %9s %6s %7s %12s %12s %12s\n",
+                "Case", "MaxBankD", "HDps", "MaxPitchD", "VNps", "AltTau", "DistRms(m)", "AltRms(m)", "HdgRms(deg)");
+    for (size_t k = 0; k < order.size() && k < 5; ++k) {
+        const SweepResult& r = results[order[k]];
+        std::printf("%6zu %9g %6g %9g %6g %7.3g %12.3f %12.3f %12.3f\n",
+                    r.caseIndex, r.params.maxBankD, r.params.hDps, r.params.maxPitchD, r.params.vNps,
+                    r.params.control.altitudeTau, r.stats.dist.rms(), r.stats.alt.rms(), r.stats.hdg.rms());
+    }
+    std::cout << "Results saved to " << outPath << std::endl;
+    return 0;
+}
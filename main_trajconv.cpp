@@ -0,0 +1,119 @@
+// main_trajconv.cpp
+// 编译指令: g++ -O2 main_trajconv.cpp Trajectory.cpp TrajectoryFile.cpp TrajectoryTrack.cpp TrajectorySynth.cpp FleetScheduler.cpp -o TrajConv -std=c++17 -I. -pthread
+//
+// 用法:
+//   ./TrajConv input.csv output.ltrj      CSV -> 二进制轨迹文件
+//   ./TrajConv --maneuver output.ltrj     导出内置的S型机动轨迹
+//   ./TrajConv --info input.ltrj          显示二进制轨迹文件内容概要
+//   ./TrajConv --random N output.ltrj [--seed S] [--ts Ts] [--step h]
+//                                         合成N条随机剖面轨迹 (TrajectorySynth, 多线程; 只由 seed 决定)
+//   ./TrajConv --resample Ts input.ltrj output.ltrj
+//                                         把每条轨迹重采样为周期 Ts
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "FleetScheduler.hpp"
+#include "Trajectory.hpp"
+#include "TrajectoryFile.hpp"
+#include "TrajectorySynth.hpp"
+
+namespace {
+
+int usage(const char* program) {
+    std::cerr << "Usage: " << program << " input.csv output.ltrj" << std::endl;
+    std::cerr << "       " << program << " --maneuver output.ltrj" << std::endl;
+    std::cerr << "       " << program << " --info input.ltrj" << std::endl;
+    std::cerr << "       " << program << " --random N output.ltrj [--seed S] [--ts Ts] [--step h]" << std::endl;
+    std::cerr << "       " << program << " --resample Ts input.ltrj output.ltrj" << std::endl;
+    return 1;
+}
+
+bool write(const std::string& path, const std::vector<std::vector<TrajectoryPoint>>& trajectories) {
+    if (!writeTrajectoryFile(path, trajectories)) {
+        std::cerr << "Error: could not write " << path << std::endl;
+        return false;
+    }
+    size_t records = 0;
+    for (const std::vector<TrajectoryPoint>& t : trajectories) records += t.size();
+    std::cout << "Wrote " << trajectories.size() << " trajectories (" << records << " records) to " << path << std::endl;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) return usage(argv[0]);
+    const std::string first = argv[1];
+    const std::string second = argv[2];
+
+    if (first == "--random") {
+        if (argc < 4) return usage(argv[0]);
+        const size_t count = static_cast<size_t>(std::strtoull(argv[2], nullptr, 10));
+        const std::string output = argv[3];
+        RandomProfileSpec spec;
+        SynthConfig config;
+        for (int i = 4; i + 1 < argc; i += 2) {
+            const std::string arg = argv[i];
+            if (arg == "--seed") spec.seed = std::strtoull(argv[i + 1], nullptr, 10);
+            else if (arg == "--ts") config.sampleTime = std::atof(argv[i + 1]);
+            else if (arg == "--step") config.integrationStep = std::atof(argv[i + 1]);
+            else return usage(argv[0]);
+        }
+        if (!(config.sampleTime > 0.0) || !(config.integrationStep > 0.0)) return usage(argv[0]);
+
+        std::vector<TrajectoryProfile> profiles(count);
+        for (size_t k = 0; k < count; ++k) profiles[k] = randomProfile(spec, k);
+        FleetScheduler scheduler;
+        std::vector<std::vector<TrajectoryPoint>> trajectories;
+        synthesizeTrajectories(profiles, config, trajectories, scheduler);
+        return write(output, trajectories) ? 0 : 1;
+    }
+
+    if (first == "--resample") {
+        if (argc != 5) return usage(argv[0]);
+        const double Ts = std::atof(argv[2]);
+        if (!(Ts > 0.0)) return usage(argv[0]);
+        MappedTrajectoryFile file;
+        if (!file.open(argv[3])) {
+            std::cerr << "Error: " << file.lastError() << std::endl;
+            return 1;
+        }
+        std::vector<std::vector<TrajectoryPoint>> trajectories(file.trajectoryCount());
+        for (size_t k = 0; k < file.trajectoryCount(); ++k) {
+            resampleTrajectory(file.trajectory(k), Ts, trajectories[k]);
+        }
+        return write(argv[4], trajectories) ? 0 : 1;
+    }
+
+    if (argc != 3) return usage(argv[0]);
+
+    if (first == "--info") {
+        MappedTrajectoryFile file;
+        if (!file.open(second)) {
+            std::cerr << "Error: " << file.lastError() << std::endl;
+            return 1;
+        }
+        std::cout << second << ": " << file.trajectoryCount() << " trajectories, "
+                  << file.records().size() << " records" << std::endl;
+        for (size_t k = 0; k < file.trajectoryCount(); ++k) {
+            const TrajectorySpan t = file.trajectory(k);
+            std::cout << "  [" << k << "] " << t.size() << " points";
+            if (!t.empty()) std::cout << ", t = " << t.front().timestamp << " .. " << t.back().timestamp;
+            if (file.sampleTime(k) > 0.0) std::cout << ", Ts = " << file.sampleTime(k);
+            std::cout << std::endl;
+        }
+        return 0;
+    }
+
+    std::vector<std::vector<TrajectoryPoint>> trajectories;
+    if (first == "--maneuver") {
+        trajectories.push_back(createManeuverTrajectory());
+    } else if (!readTrajectoryCsv(first, trajectories)) {
+        std::cerr << "Error: could not parse " << first << std::endl;
+        return 1;
+    }
+
+    return write(second, trajectories) ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+// main_tune.cpp
+// 编译指令: g++ -O2 main_tune.cpp AutoTuner.cpp AirframeProfile.cpp SweepRunner.cpp StandaloneLaeroModel.cpp FleetScheduler.cpp
+//           Trajectory.cpp TrajectoryFile.cpp TrajectoryTrack.cpp TrackingDriver.cpp TrajectorySynth.cpp -o TuneSim -std=c++17 -I. -pthread
+//
+// 用法: ./TuneSim [--airframe 名称] [--profiles airframes.txt] [--trajectory file.ltrj ...] [--random N]
+//                 [--generations G] [--population P] [--seed S] [--threads T] [--fix 参数名 ...]
+//   期望轨迹集: --trajectory 文件中的全部轨迹 (可重复) + --random N 条随机剖面轨迹 (TrajectorySynth);
+//              都不给出时为内置S型机动轨迹 + 4 条随机剖面轨迹
+//   起点: profiles 文件中的同名机型 (没有时为默认参数); 结果写回该文件的同名一节, 其他机型不变
+//   --fix    : 该参数 (文件中的键名, 如 maxBankD) 保持起点的值, 不参与整定
+//
+// 每一代的全部候选参数 × 全部轨迹一起并行仿真; 结果只由 seed 决定, 与线程数无关。
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AirframeProfile.hpp"
+#include "AutoTuner.hpp"
+#include "FleetScheduler.hpp"
+#include "Trajectory.hpp"
+#include "TrajectoryFile.hpp"
+#include "TrajectorySynth.hpp"
+
+int main(int argc, char* argv[]) {
+    std::string airframeName = "default";
+    std::string profilesPath = "airframes.txt";
+    std::vector<std::string> trajectoryPaths;
+    std::vector<std::string> fixed;
+    size_t randomCount = 0;
+    bool randomGiven = false;
+    unsigned threads = 0;
+    TuneSpec spec;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--airframe" && i + 1 < argc) airframeName = argv[++i];
+        else if (arg == "--profiles" && i + 1 < argc) profilesPath = argv[++i];
+        else if (arg == "--trajectory" && i + 1 < argc) trajectoryPaths.push_back(argv[++i]);
+        else if (arg == "--random" && i + 1 < argc) {
+            randomCount = std::strtoul(argv[++i], nullptr, 10);
+            randomGiven = true;
+        }
+        else if (arg == "--generations" && i + 1 < argc) spec.maxGenerations = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (arg == "--population" && i + 1 < argc) spec.populationSize = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (arg == "--seed" && i + 1 < argc) spec.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--threads" && i + 1 < argc) threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (arg == "--fix" && i + 1 < argc) fixed.push_back(argv[++i]);
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--airframe name] [--profiles file.txt] [--trajectory file.ltrj ...] [--random N]"
+                      << " [--generations G] [--population P] [--seed S] [--threads T] [--fix param ...]" << std::endl;
+            return 1;
+        }
+    }
+
+    // --- 机型参数文件: 不存在时新建 ---
+    std::vector<AirframeProfile> profiles;
+    std::string error;
+    if (std::ifstream(profilesPath).is_open() && !loadAirframeProfiles(profilesPath, profiles, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+    if (const AirframeProfile* existing = findAirframe(profiles, airframeName)) spec.start = *existing;
+    spec.start.name = airframeName;
+
+    for (const std::string& name : fixed) {
+        size_t f = 0;
+        while (f < laero_airframe::FIELD_COUNT && name != laero_airframe::fieldName(f)) ++f;
+        if (f == laero_airframe::FIELD_COUNT) {
+            std::cerr << "Error: unknown parameter " << name << std::endl;
+            return 1;
+        }
+        spec.range[f] = SweepRange();
+    }
+
+    // --- 期望轨迹集 ---
+    FleetScheduler scheduler(threads);
+    std::vector<MappedTrajectoryFile> files(trajectoryPaths.size());
+    std::vector<TrajectorySpan> trajectories;
+    for (size_t k = 0; k < trajectoryPaths.size(); ++k) {
+        if (!files[k].open(trajectoryPaths[k])) {
+            std::cerr << "Error: " << files[k].lastError() << std::endl;
+            return 1;
+        }
+        for (size_t t = 0; t < files[k].trajectoryCount(); ++t) trajectories.push_back(files[k].trajectory(t));
+    }
+
+    std::vector<std::vector<TrajectoryPoint>> synthesized;
+    if (trajectoryPaths.empty() && !randomGiven) {
+        synthesized.push_back(createManeuverTrajectory());
+        randomCount = 4;
+    }
+    if (randomCount > 0) {
+        RandomProfileSpec randomSpec;
+        randomSpec.seed = spec.seed;
+        std::vector<TrajectoryProfile> randomProfiles(randomCount);
+        for (size_t k = 0; k < randomCount; ++k) randomProfiles[k] = randomProfile(randomSpec, k);
+        std::vector<std::vector<TrajectoryPoint>> randomTrajectories;
+        synthesizeTrajectories(randomProfiles, SynthConfig(), randomTrajectories, scheduler);
+        for (std::vector<TrajectoryPoint>& t : randomTrajectories) synthesized.push_back(std::move(t));
+    }
+    for (const std::vector<TrajectoryPoint>& t : synthesized) trajectories.push_back(t);
+    if (trajectories.empty()) {
+        std::cerr << "Error: no trajectories to tune against." << std::endl;
+        return 1;
+    }
+
+    // --- 整定 ---
+    std::cout << "Tuning airframe " << airframeName << " against " << trajectories.size() << " trajectories on "
+              << scheduler.threadCount() << " threads..." << std::endl;
+    std::printf("%4s %12s %12s %12s %10s\n", "Gen", "BestCost", "MeanCost", "BestSoFar", "Step");
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const TuneResult result = tuneAirframe(trajectories, spec, scheduler, [](const TuneGeneration& g) {
+        std::printf("%4u %12.4f %12.4f %12.4f %10.4f\n", g.generation, g.bestCost, g.meanCost, g.bestSoFarCost, g.sigma);
+        std::fflush(stdout);
+    });
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::printf("Finished in %.2f s (%zu candidates). Cost %.4f -> %.4f\n",
+                seconds, result.evaluations, result.startCost, result.bestCost);
+    std::printf("%-12s %12s %12s\n", "Parameter", "Start", "Tuned");
+    for (size_t f = 0; f < laero_airframe::FIELD_COUNT; ++f) {
+        std::printf("%-12s %12.4f %12.4f%s\n", laero_airframe::fieldName(f), laero_airframe::field(spec.start, f),
+                    laero_airframe::field(result.best, f), spec.range[f].max > spec.range[f].min ? "" : "  (fixed)");
+    }
+
+    // --- 写回机型参数文件 ---
+    storeAirframe(profiles, result.best);
+    std::ofstream out(profilesPath);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open output file." << std::endl;
+        return 1;
+    }
+    out << "# LaeroModel airframe profiles (TuneSim)\n";
+    writeAirframeProfiles(out, profiles);
+    std::cout << "Airframe " << airframeName << " saved to " << profilesPath << std::endl;
+    return 0;
+}